@@ -32,13 +32,11 @@ namespace Tempus
 				e.AddComponent<TransformComponent>();
 				e.AddComponent<StaticMeshComponent>();
 
-				Entity e1 = scene->AddEntity("Fbx Test2");
-				e1.AddComponent<TransformComponent>(glm::vec3(-175.0f, 0.0f, 0.0f));
-				e1.AddComponent<StaticMeshComponent>();
-
-				Entity e2 = scene->AddEntity("Fbx Test2");
-				e2.AddComponent<TransformComponent>(glm::vec3(175.0f, 0.0f, 0.0f));
-				e2.AddComponent<StaticMeshComponent>();
+				// Both instances share the prefab's mesh data
+				Prefab<TransformComponent, StaticMeshComponent> prefab("Fbx Test2", TransformComponent(), StaticMeshComponent("grunt.fbx", "grunt_diffuse.fbx"));
+				std::vector<uint32_t> instances = scene->Instantiate(prefab, 2);
+				scene->GetMutableComponent<TransformComponent>(instances[0])->Position = glm::vec3(-175.0f, 0.0f, 0.0f);
+				scene->GetMutableComponent<TransformComponent>(instances[1])->Position = glm::vec3(175.0f, 0.0f, 0.0f);
 			}
 		}
 
@@ -54,11 +52,7 @@ namespace Tempus
 
 					if (Scene* scene = SCENE_MANAGER->GetActiveScene())
 					{
-						for (int i = 0; i < 100; i++)
-						{
-							Entity e = scene->AddEntity("Entity_" + std::to_string(i));
-							e.AddComponent<TransformComponent>();
-						}
+						scene->SpawnBatch(100, "Entity", TransformComponent());
 					}
 				}
 			}
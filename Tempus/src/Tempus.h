@@ -2,6 +2,7 @@
 
 #include "Tempus/Core/Application.h"
 #include "Tempus/Core/Log.h"
+#include "Tempus/Components/ComponentTypeTable.h"
 
 // Entry Point
 #include "Tempus/Core/EntryPoint.h"
@@ -1 +1,39 @@
-// Copyright Levi Spevakow (C) 2025
\ No newline at end of file
+// Copyright Levi Spevakow (C) 2025
+
+#include "CameraComponent.h"
+
+#include <imgui.h>
+
+bool Tempus::CameraComponent::DrawImGui(Scene& scene, uint32_t entityId, CameraComponent& component)
+{
+	bool bCommitted = false;
+	bool bEdited = false;
+
+	ImGui::Text("Projection Type:");
+	ImGui::SameLine();
+	const char* projLabel = component.ProjectionType == CamProjectionType::Perspective ? "Perspective" : "Orthographic";
+	if (ImGui::Button(projLabel))
+	{
+		// Swap projection type
+		component.ProjectionType = static_cast<CamProjectionType>((static_cast<int>(component.ProjectionType) + 1) % 2);
+		bEdited = true;
+		bCommitted = true;
+	}
+	if (ImGui::IsItemHovered())
+	{
+		ImGui::SetTooltip("Press to toggle projection type");
+	}
+	bEdited |= ImGui::SliderFloat("FOV", &component.Fov, 1.0f, 179.0f, "%.3f");
+	bCommitted |= ImGui::IsItemDeactivatedAfterEdit();
+	bEdited |= ImGui::SliderFloat("Ortho Size", &component.OrthoSize, 1.0f, 1000.0f, "%.1f");
+	bCommitted |= ImGui::IsItemDeactivatedAfterEdit();
+	bEdited |= ImGui::SliderFloat("Near Clip", &component.NearClip, 0.1f, 10.0f, "%.1f");
+	bCommitted |= ImGui::IsItemDeactivatedAfterEdit();
+	bEdited |= ImGui::SliderFloat("Far Clip", &component.FarClip, 10.0f, 10000.0f, "%.1f");
+	bCommitted |= ImGui::IsItemDeactivatedAfterEdit();
+	if (bEdited)
+	{
+		scene.MarkComponentChanged<CameraComponent>(entityId);
+	}
+	return bCommitted;
+}
@@ -27,6 +27,9 @@ namespace Tempus
 		float NearClip = 0.1f;
 		float FarClip = 1000.0f;
 		float AspectRatio = 16.0f / 9.0f;
+
+		// Inspector widgets, see ComponentTypeInfo::drawImGuiFunc
+		static bool DrawImGui(Scene& scene, uint32_t entityId, CameraComponent& component);
 	};
 }
 
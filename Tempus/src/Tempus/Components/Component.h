@@ -7,6 +7,9 @@
 
 namespace Tempus
 {
+    // Empty base marking a type as a component. Components are plain data without a vtable, they are never
+    // destroyed or drawn through a base pointer. Per type behaviour such as editor drawing lives in the
+    // component's ComponentTypeInfo entry.
     class TEMPUS_API Component
     {
         TPS_DEBUG_NAME("Component")
@@ -14,8 +17,7 @@ namespace Tempus
     protected:
         
         Component() = default;
-        virtual ~Component() = default;
-        virtual void OnDrawImGui() {};
+        ~Component() = default;
 
     };
-}
\ No newline at end of file
+}
@@ -3,9 +3,11 @@
 #pragma once
 
 #include "Core/Core.h"
-#include <unordered_set>
-#include <functional>
-#include <iostream>
+#include "Core/ComponentTypeOps.h"
+#include <memory>
+#include <span>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 #include "Core/Scene.h"
 #include "Utils/EnumClassFlagUtils.h"
@@ -14,15 +16,16 @@
 // - Must have a component ID 
 // - Must have a debug name declared with TPS_DEBUG_NAME()
 // - Additional ComponentMetaData flags can be added as a third parameter
+// - Must be listed in EngineComponentTypes (ComponentTypeTable.h), scenes reject unlisted types at compile time
 #define DECLARE_COMPONENT(type, id, ...) \
         TPS_STATIC_ASSERT(std::is_integral_v<decltype(id)>, "Component ID must be an integer"); \
-        TPS_STATIC_ASSERT((id) >= 0 && (id) <= std::numeric_limits<Tempus::ComponentId>::max(), "Component ID must be a positive integer <= 255"); \
+        TPS_STATIC_ASSERT((id) >= 0 && (id) < MAX_COMPONENTS, "Component ID must be a positive integer < MAX_COMPONENTS"); \
         public: \
         static constexpr ComponentId GetId() { return m_Id; } \
-        static ComponentMetaFlags GetMetaData() { return m_MetaData; } \
+        static constexpr ComponentMetaFlags GetMetaData() { return m_MetaData; } \
         private: \
         static constexpr ComponentId m_Id = id; \
-        static const inline ComponentMetaFlags m_MetaData = TPS_Private::ComponentRegistry::Register<type>(id __VA_OPT__(,) __VA_ARGS__);
+        static constexpr ComponentMetaFlags m_MetaData = ComponentMetaFlags::None __VA_OPT__(|) __VA_ARGS__;
 
 namespace Tempus
 {
@@ -39,90 +42,84 @@ namespace Tempus
     };
     ENUM_CLASS_FLAGS(ComponentMetaFlags);
     
+    // Reflection data for a component type, built at compile time
     struct ComponentTypeInfo
     {
-        std::string name;
-        ComponentId id;
+        const char* name = "";
+        ComponentId id = 0;
         ComponentMetaFlags metadata = ComponentMetaFlags::None;
-        std::function<void(Scene*, uint32_t)> addComponentFunc;
-        std::function<void(Scene*, uint32_t)> removeComponentFunc;
-    };
-}
+        ComponentTypeOps ops;
+        void (*addComponentFunc)(Scene*, uint32_t) = nullptr;
+        void (*removeComponentFunc)(Scene*, uint32_t) = nullptr;
+        // Draws the component's inspector widgets, nullptr unless the type declares a static DrawImGui(Scene&, uint32_t, T&).
+        // It marks the component changed on edit and returns true once an edit is committed, so an undo step is recorded.
+        bool (*drawImGuiFunc)(Scene& scene, uint32_t entityId, void* component) = nullptr;
+        // Creates an empty pool for the type, nullptr for tags
+        std::unique_ptr<IComponentPool> (*createPoolFunc)() = nullptr;
+        bool bTag = false;
 
-namespace TPS_Private
-{
-    struct ComponentRegistry
-    {
-        // I am unable to use the ValidComponent concept here as it's called before the class is fully created
-        template<typename T>
-        static Tempus::ComponentMetaFlags Register(Tempus::ComponentId id, Tempus::ComponentMetaFlags metadata = Tempus::ComponentMetaFlags::None)
-        {
-            // Component ID's must be unique
-            if (ComponentIds.contains(id))
-            {
-                // Throwing an exception here instead of a critical log as the logger is not initialized yet
-                throw std::runtime_error(std::format("Duplicate component ID's detected! {0}", id));
-                return Tempus::ComponentMetaFlags::None;
-            }
-
-            // Insert new unique ID
-            ComponentIds.insert(id);
+        // Size of one component in a scene file, 0 if the type has no data or can't be written.
+        // Types declaring a trivially copyable SerializedRecord with static range functions
+        // Encode(std::span<const T>, std::span<SerializedRecord>, NameTable&) and
+        // Decode(std::span<const SerializedRecord>, std::span<T>, std::span<const std::string_view>)
+        // are written through them, e.g. to replace pointers with string table indices.
+        // Other trivially copyable types are written raw.
+        uint32_t serializedSize = 0;
+        // Converts count components into records, nullptr for types written raw
+        void (*encodeFunc)(const void* components, void* records, uint32_t count, NameTable& strings) = nullptr;
+        // Assigns count records to already constructed components, nullptr for types written raw
+        void (*decodeFunc)(const void* records, void* components, uint32_t count, std::span<const std::string_view> strings) = nullptr;
 
-            // Reflection data
-            Tempus::ComponentTypeInfo data;
-            data.name = Tempus::TempusUtils::GetClassDebugName<T>();
-            data.id = id;
-            data.metadata = metadata;
-            // Templated function pointer for adding the component to a scene
-            data.addComponentFunc = [](Tempus::Scene* scene, uint32_t entityId)
-            {   
-                scene->AddComponent<T>(entityId);
-            };
-            data.removeComponentFunc = [](Tempus::Scene* scene, uint32_t entityId)
-            {
-                scene->RemoveComponent<T>(entityId);  
-            };
-            
-            RegisteredComponents.emplace_back(data);
-
-            std::sort(RegisteredComponents.begin(), RegisteredComponents.end(), [](const Tempus::ComponentTypeInfo& a, const Tempus::ComponentTypeInfo& b)
-            {
-                return a.id < b.id;
-            });
-            
-            ComponentMap[data.id] = data;
-
-            return metadata;
+        constexpr bool IsValid() const { return ops.IsValid(); }
+        // Whether the type is written to scene files, tags are stored in the entity's signature
+        constexpr bool IsSerializable() const
+        {
+            return IsValid() && !EnumCheckFlag(metadata, ComponentMetaFlags::NoSerialize) && (bTag || serializedSize != 0);
         }
 
-        static std::vector<std::string> GetRegisteredComponentNames()
+        template<ValidComponent T>
+        static constexpr ComponentTypeInfo Create()
         {
-            std::vector<std::string> componentNames;
-            for (const Tempus::ComponentTypeInfo& info : RegisteredComponents)
+            ComponentTypeInfo info;
+            info.name = TempusUtils::GetClassDebugName<T>();
+            info.id = T::GetId();
+            info.metadata = T::GetMetaData();
+            info.ops = ComponentTypeOps::Create<T>();
+            info.addComponentFunc = [](Scene* scene, uint32_t entityId) { scene->AddComponent<T>(entityId); };
+            info.removeComponentFunc = [](Scene* scene, uint32_t entityId) { scene->RemoveComponent<T>(entityId); };
+            if constexpr (requires(Scene& scene, uint32_t entityId, T& component) { { T::DrawImGui(scene, entityId, component) } -> std::same_as<bool>; })
             {
-                componentNames.emplace_back(info.name);
+                info.drawImGuiFunc = [](Scene& scene, uint32_t entityId, void* component) { return T::DrawImGui(scene, entityId, *static_cast<T*>(component)); };
             }
-            return componentNames;
-        }
-
-        static const std::vector<Tempus::ComponentTypeInfo>& GetRegisteredComponents()
-        {
-            return RegisteredComponents;
-        }
 
-        static Tempus::ComponentTypeInfo GetComponentTypeFromId(Tempus::ComponentId id)
-        {
-            if (ComponentMap.contains(id))
+            if constexpr (TagComponent<T>)
             {
-                return ComponentMap.at(id);
+                info.bTag = true;
             }
+            else
+            {
+                info.createPoolFunc = []() -> std::unique_ptr<IComponentPool> { return std::make_unique<ComponentPool<T>>(); };
 
-            TPS_CRITICAL("Component ID [{0}] not found in registry!", id);
+                if constexpr (requires { typename T::SerializedRecord; })
+                {
+                    using Record = typename T::SerializedRecord;
+                    TPS_STATIC_ASSERT(std::is_trivially_copyable_v<Record>, "SerializedRecord must be trivially copyable");
+                    info.serializedSize = sizeof(Record);
+                    info.encodeFunc = [](const void* components, void* records, uint32_t count, NameTable& strings)
+                    {
+                        T::Encode(std::span<const T>(static_cast<const T*>(components), count), std::span<Record>(static_cast<Record*>(records), count), strings);
+                    };
+                    info.decodeFunc = [](const void* records, void* components, uint32_t count, std::span<const std::string_view> strings)
+                    {
+                        T::Decode(std::span<const Record>(static_cast<const Record*>(records), count), std::span<T>(static_cast<T*>(components), count), strings);
+                    };
+                }
+                else if constexpr (std::is_trivially_copyable_v<T>)
+                {
+                    info.serializedSize = sizeof(T);
+                }
+            }
+            return info;
         }
-
-        private:
-        static inline std::vector<Tempus::ComponentTypeInfo> RegisteredComponents;
-        static inline std::map<Tempus::ComponentId, Tempus::ComponentTypeInfo> ComponentMap;
-        static inline std::unordered_set<Tempus::ComponentId> ComponentIds;
     };
 }
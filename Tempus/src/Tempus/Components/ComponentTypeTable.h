@@ -0,0 +1,131 @@
+// Copyright Levi Spevakow (C) 2025
+
+#pragma once
+
+#include "Core/Core.h"
+#include "ComponentRegistry.h"
+#include "CameraComponent.h"
+#include "EditorTagComponents.h"
+#include "HierarchyComponent.h"
+#include "LightComponent.h"
+#include "StaticMeshComponent.h"
+#include "TransformComponent.h"
+#include "WorldCellComponent.h"
+#include "WorldTransformComponent.h"
+#include <array>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Tempus
+{
+    template<ValidComponent... Ts>
+    struct ComponentTypeList {};
+
+    // Every component type known to the engine, new component types must be added here.
+    // The table is built into the engine, which snapshots, serializes and copies components through it, so client
+    // modules such as Sandbox add their component types to this list too and include their headers above.
+    // Adding a type that isn't listed to a scene fails to compile, see TPS_Private::IsListedComponentType().
+    using EngineComponentTypes = ComponentTypeList<
+        TransformComponent,
+        CameraComponent,
+        StaticMeshComponent,
+        EditorNoDeleteTag,
+        LightComponent,
+        HierarchyComponent,
+        WorldTransformComponent,
+        EditorNoSerializeTag,
+        EditorHideInOutlinerTag,
+        EditorNoAddComponentTag,
+        EditorNoRemoveComponentTag,
+        WorldCellComponent>;
+}
+
+namespace TPS_Private
+{
+    template<Tempus::ValidComponent... Ts>
+    constexpr bool AreComponentIdsUnique(Tempus::ComponentTypeList<Ts...>)
+    {
+        std::array<bool, MAX_COMPONENTS> used = {};
+        for (Tempus::ComponentId id : { Ts::GetId()... })
+        {
+            if (used[id])
+            {
+                return false;
+            }
+            used[id] = true;
+        }
+        return true;
+    }
+
+    template<Tempus::ValidComponent... Ts>
+    constexpr std::array<Tempus::ComponentTypeInfo, MAX_COMPONENTS> BuildComponentTypesById(Tempus::ComponentTypeList<Ts...>)
+    {
+        std::array<Tempus::ComponentTypeInfo, MAX_COMPONENTS> table = {};
+        ((table[Ts::GetId()] = Tempus::ComponentTypeInfo::Create<Ts>()), ...);
+        return table;
+    }
+
+    template<Tempus::ValidComponent... Ts>
+    constexpr std::array<Tempus::ComponentTypeInfo, sizeof...(Ts)> BuildRegisteredComponents(Tempus::ComponentTypeList<Ts...>, const std::array<Tempus::ComponentTypeInfo, MAX_COMPONENTS>& typesById)
+    {
+        // Walking the ID indexed table keeps the list sorted by ID
+        std::array<Tempus::ComponentTypeInfo, sizeof...(Ts)> registered = {};
+        size_t count = 0;
+        for (const Tempus::ComponentTypeInfo& info : typesById)
+        {
+            if (info.IsValid())
+            {
+                registered[count++] = info;
+            }
+        }
+        return registered;
+    }
+
+    template<Tempus::ValidComponent T>
+    consteval bool IsListedComponentType()
+    {
+        return []<typename... Ts>(Tempus::ComponentTypeList<Ts...>) { return (std::is_same_v<T, Ts> || ...); }(Tempus::EngineComponentTypes{});
+    }
+
+    template<Tempus::ValidComponent... Ts>
+    constexpr bool AreComponentsTriviallyRelocatable(Tempus::ComponentTypeList<Ts...>)
+    {
+        return (Tempus::IsTriviallyRelocatableV<Ts> && ...);
+    }
+
+    TPS_STATIC_ASSERT(AreComponentIdsUnique(Tempus::EngineComponentTypes{}), "Duplicate component ID's detected in EngineComponentTypes!");
+    // Lets storage relocate engine components with a memmove when rows are compacted, sorted or moved between archetypes.
+    // This says nothing about copying, copies and snapshots only memcpy components that are trivially copyable.
+    TPS_STATIC_ASSERT(AreComponentsTriviallyRelocatable(Tempus::EngineComponentTypes{}), "Engine components must be trivially relocatable, their bytes must be movable with a memmove");
+
+    inline constexpr std::array<Tempus::ComponentTypeInfo, MAX_COMPONENTS> ComponentTypesById = BuildComponentTypesById(Tempus::EngineComponentTypes{});
+    inline constexpr Tempus::ComponentTypeInfo InvalidComponentType = {};
+    inline constexpr auto RegisteredComponentTypes = BuildRegisteredComponents(Tempus::EngineComponentTypes{}, ComponentTypesById);
+
+    // Compile time table of every type in EngineComponentTypes, nothing is registered or allocated at startup
+    struct ComponentRegistry
+    {
+        static std::vector<std::string> GetRegisteredComponentNames()
+        {
+            std::vector<std::string> componentNames;
+            for (const Tempus::ComponentTypeInfo& info : RegisteredComponentTypes)
+            {
+                componentNames.emplace_back(info.name);
+            }
+            return componentNames;
+        }
+
+        // Sorted by ID
+        static constexpr std::span<const Tempus::ComponentTypeInfo> GetRegisteredComponents()
+        {
+            return RegisteredComponentTypes;
+        }
+
+        // Direct index by ID, the returned info is invalid if no listed component uses the ID
+        static constexpr const Tempus::ComponentTypeInfo& GetComponentTypeFromId(Tempus::ComponentId id)
+        {
+            return id < MAX_COMPONENTS ? ComponentTypesById[id] : InvalidComponentType;
+        }
+    };
+}
@@ -0,0 +1,49 @@
+// Copyright Levi Spevakow (C) 2025
+
+#pragma once
+
+#include "Core/Core.h"
+#include "Component.h"
+
+// Editor markers, each one is a tag component stored only as a bit in the entity's signature
+
+namespace Tempus
+{
+    // Disallows deletion of the entity in the editor
+    class TEMPUS_API EditorNoDeleteTag : public Component
+    {
+        DECLARE_COMPONENT(EditorNoDeleteTag, 3, ComponentMetaFlags::NoEditorAdd | ComponentMetaFlags::NoSerialize)
+        TPS_DEBUG_NAME("Editor No Delete Tag")
+    };
+
+    // Prevents the entity from being serialized in a scene file
+    class TEMPUS_API EditorNoSerializeTag : public Component
+    {
+        DECLARE_COMPONENT(EditorNoSerializeTag, 7, ComponentMetaFlags::NoEditorAdd | ComponentMetaFlags::NoSerialize)
+        TPS_DEBUG_NAME("Editor No Serialize Tag")
+    };
+
+    // Hides the entity from the outliner in the editor
+    class TEMPUS_API EditorHideInOutlinerTag : public Component
+    {
+        DECLARE_COMPONENT(EditorHideInOutlinerTag, 8, ComponentMetaFlags::NoEditorAdd | ComponentMetaFlags::NoSerialize)
+        TPS_DEBUG_NAME("Editor Hide In Outliner Tag")
+    };
+
+    // Disallows additional components being added to this entity in the editor
+    class TEMPUS_API EditorNoAddComponentTag : public Component
+    {
+        DECLARE_COMPONENT(EditorNoAddComponentTag, 9, ComponentMetaFlags::NoEditorAdd | ComponentMetaFlags::NoSerialize)
+        TPS_DEBUG_NAME("Editor No Add Component Tag")
+    };
+
+    // Disallows removal of components from this entity in the editor
+    class TEMPUS_API EditorNoRemoveComponentTag : public Component
+    {
+        DECLARE_COMPONENT(EditorNoRemoveComponentTag, 10, ComponentMetaFlags::NoEditorAdd | ComponentMetaFlags::NoSerialize)
+        TPS_DEBUG_NAME("Editor No Remove Component Tag")
+    };
+
+    TPS_STATIC_ASSERT(TagComponent<EditorNoDeleteTag> && TagComponent<EditorNoSerializeTag> && TagComponent<EditorHideInOutlinerTag>
+        && TagComponent<EditorNoAddComponentTag> && TagComponent<EditorNoRemoveComponentTag>, "Editor tags must stay empty");
+}
@@ -0,0 +1,39 @@
+// Copyright Levi Spevakow (C) 2025
+
+#include "HierarchyComponent.h"
+
+#include <imgui.h>
+
+bool Tempus::HierarchyComponent::DrawImGui(Scene& scene, uint32_t entityId, HierarchyComponent& component)
+{
+    // Read once, SetParent() changes it while the list is still being drawn
+    const uint32_t parentId = component.Parent;
+    const char* parentName = scene.HasEntity(parentId) ? scene.GetEntityName(parentId).data() : "None";
+    if (!ImGui::BeginCombo("Parent", parentName))
+    {
+        return false;
+    }
+
+    bool bCommitted = false;
+    if (ImGui::Selectable("None", parentId == INVALID_ENTITY_ID))
+    {
+        scene.SetParent(entityId, INVALID_ENTITY_ID);
+        bCommitted = true;
+    }
+    for (const uint32_t otherId : scene.GetEntityIDs())
+    {
+        if (otherId == entityId)
+        {
+            continue;
+        }
+        ImGui::PushID(static_cast<int>(otherId));
+        if (ImGui::Selectable(scene.GetEntityName(otherId).data(), parentId == otherId))
+        {
+            scene.SetParent(entityId, otherId);
+            bCommitted = true;
+        }
+        ImGui::PopID();
+    }
+    ImGui::EndCombo();
+    return bCommitted;
+}
@@ -0,0 +1,28 @@
+// Copyright Levi Spevakow (C) 2025
+
+#pragma once
+
+#include "Core/Core.h"
+#include "Component.h"
+
+namespace Tempus
+{
+    // Parents the entity's transform to another entity's world transform.
+    // Change the parent through Scene::SetParent(), which rejects cycles and marks the component changed.
+    class TEMPUS_API HierarchyComponent : public Component
+    {
+        DECLARE_COMPONENT(HierarchyComponent, 5, ComponentMetaFlags::NoDuplicate)
+        TPS_DEBUG_NAME("Hierarchy Component")
+
+    public:
+
+        HierarchyComponent() = default;
+        HierarchyComponent(uint32_t parent) : Parent(parent) {}
+
+        // INVALID_ENTITY_ID for a root. A parent that doesn't exist or has no transform also makes the entity a root.
+        uint32_t Parent = INVALID_ENTITY_ID;
+
+        // Inspector widgets, see ComponentTypeInfo::drawImGuiFunc. The parent is changed through Scene::SetParent().
+        static bool DrawImGui(Scene& scene, uint32_t entityId, HierarchyComponent& component);
+    };
+}
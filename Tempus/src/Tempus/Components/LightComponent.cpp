@@ -1,3 +1,21 @@
 // Copyright Levi Spevakow (C) 2025
 
 #include "LightComponent.h"
+
+#include <imgui.h>
+
+bool Tempus::LightComponent::DrawImGui(Scene& scene, uint32_t entityId, LightComponent& component)
+{
+    bool bCommitted = false;
+    bool bEdited = ImGui::SliderFloat("Radius", &component.Radius, 1.0f, 1000.0f);
+    bCommitted |= ImGui::IsItemDeactivatedAfterEdit();
+    bEdited |= ImGui::SliderFloat("Intensity", &component.Intensity, 1.0f, 1000.0f);
+    bCommitted |= ImGui::IsItemDeactivatedAfterEdit();
+    bEdited |= ImGui::ColorEdit3("Color", &component.Color.r);
+    bCommitted |= ImGui::IsItemDeactivatedAfterEdit();
+    if (bEdited)
+    {
+        scene.MarkComponentChanged<LightComponent>(entityId);
+    }
+    return bCommitted;
+}
@@ -20,6 +20,9 @@ namespace Tempus
         float Radius = 1.0f;
         float Intensity = 1.0f;
         glm::vec3 Color = glm::vec3(1.0f, 1.0f, 1.0f);
+
+        // Inspector widgets, see ComponentTypeInfo::drawImGuiFunc
+        static bool DrawImGui(Scene& scene, uint32_t entityId, LightComponent& component);
         
     };
 }
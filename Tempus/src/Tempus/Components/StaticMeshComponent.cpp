@@ -2,3 +2,88 @@
 
 #include "StaticMeshComponent.h"
 #include "tinyobjloader/tiny_obj_loader.h"
+#include <imgui.h>
+#include <unordered_map>
+
+size_t Tempus::StaticMeshData::Hash::operator()(const StaticMeshData& data) const
+{
+    const size_t modelHash = std::hash<std::string>{}(data.ModelName);
+    return modelHash ^ (std::hash<std::string>{}(data.TextureName) + 0x9e3779b97f4a7c15ull + (modelHash << 6) + (modelHash >> 2));
+}
+
+Tempus::StaticMeshComponent::StaticMeshComponent()
+{
+    // Looked up once, default constructed instances all share the default block
+    static const SharedRef<StaticMeshData> defaultMesh = GetSharedData().Acquire(StaticMeshData());
+    m_Mesh = defaultMesh;
+}
+
+Tempus::StaticMeshComponent::StaticMeshComponent(std::string_view modelName, std::string_view textureName)
+{
+    StaticMeshData data;
+    data.ModelName = modelName;
+    data.TextureName = textureName;
+    m_Mesh = GetSharedData().Acquire(data);
+}
+
+void Tempus::StaticMeshComponent::SetModelName(std::string_view modelName)
+{
+    m_Mesh = GetSharedData().Modify(m_Mesh, [modelName](StaticMeshData& data) { data.ModelName = modelName; });
+}
+
+void Tempus::StaticMeshComponent::SetTextureName(std::string_view textureName)
+{
+    m_Mesh = GetSharedData().Modify(m_Mesh, [textureName](StaticMeshData& data) { data.TextureName = textureName; });
+}
+
+Tempus::StaticMeshDataTable& Tempus::StaticMeshComponent::GetSharedData()
+{
+    static StaticMeshDataTable sharedData;
+    return sharedData;
+}
+
+void Tempus::StaticMeshComponent::Encode(std::span<const StaticMeshComponent> components, std::span<SerializedRecord> outRecords, NameTable& strings)
+{
+    // Instances sharing a block share its record, so each block's names are interned once
+    std::unordered_map<SharedDataHandle, SerializedRecord> records;
+    for (size_t i = 0; i < components.size(); i++)
+    {
+        const SharedRef<StaticMeshData>& mesh = components[i].m_Mesh;
+        auto [it, bInserted] = records.try_emplace(mesh.GetHandle());
+        if (bInserted)
+        {
+            it->second.ModelName = strings.Intern(mesh->ModelName);
+            it->second.TextureName = strings.Intern(mesh->TextureName);
+        }
+        outRecords[i] = it->second;
+    }
+}
+
+void Tempus::StaticMeshComponent::Decode(std::span<const SerializedRecord> records, std::span<StaticMeshComponent> outComponents, std::span<const std::string_view> strings)
+{
+    auto getString = [strings](uint32_t index) { return index < strings.size() ? strings[index] : std::string_view(); };
+
+    // Acquiring locks the shared table, so each distinct pair of names is only acquired once per range
+    std::unordered_map<uint64_t, SharedRef<StaticMeshData>> meshes;
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        const uint64_t key = (static_cast<uint64_t>(records[i].ModelName) << 32) | records[i].TextureName;
+        auto [it, bInserted] = meshes.try_emplace(key);
+        if (bInserted)
+        {
+            StaticMeshData data;
+            data.ModelName = getString(records[i].ModelName);
+            data.TextureName = getString(records[i].TextureName);
+            it->second = GetSharedData().Acquire(data);
+        }
+        outComponents[i].m_Mesh = it->second;
+    }
+}
+
+bool Tempus::StaticMeshComponent::DrawImGui(Scene& scene, uint32_t entityId, StaticMeshComponent& component)
+{
+    ImGui::Text("Model: %s", component.GetModelName().c_str());
+    ImGui::Text("Texture: %s", component.GetTextureName().c_str());
+    ImGui::Text("Shared Mesh: %u", component.GetMesh().GetHandle());
+    return false;
+}
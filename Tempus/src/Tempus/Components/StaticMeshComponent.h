@@ -3,18 +3,74 @@
 #pragma once
 
 #include "Core/Core.h"
+#include "Core/NameTable.h"
+#include "Core/SharedDataTable.h"
 #include "Component.h"
+#include <span>
+#include <string>
+#include <string_view>
 
 namespace Tempus
 {
+    // Asset data shared by every static mesh instance that uses the same model and texture
+    struct StaticMeshData
+    {
+        std::string ModelName = "grunt.fbx";
+        std::string TextureName = "grunt_diffuse.fbx";
+
+        bool operator==(const StaticMeshData& other) const = default;
+
+        struct Hash
+        {
+            size_t operator()(const StaticMeshData& data) const;
+        };
+    };
+
+    using StaticMeshDataTable = SharedDataTable<StaticMeshData, StaticMeshData::Hash>;
+
+    // Instances only hold a reference to their shared StaticMeshData, so any number of copies of one mesh cost a
+    // pointer each. Setting a field copies the data on write, leaving other instances on the original block. A block is
+    // freed with the last instance referencing it.
     class TEMPUS_API StaticMeshComponent : public Component
     {
         DECLARE_COMPONENT(StaticMeshComponent, 2)
         TPS_DEBUG_NAME("Static Mesh Component")
     public:
-        
-        std::string ModelName = "grunt.fbx";
-        std::string TextureName = "grunt_diffuse.fbx";
+
+        StaticMeshComponent();
+        StaticMeshComponent(SharedRef<StaticMeshData> mesh) : m_Mesh(mesh) {}
+        StaticMeshComponent(std::string_view modelName, std::string_view textureName);
+
+        const StaticMeshData& GetMeshData() const { return *m_Mesh; }
+        const SharedRef<StaticMeshData>& GetMesh() const { return m_Mesh; }
+        const std::string& GetModelName() const { return m_Mesh->ModelName; }
+        const std::string& GetTextureName() const { return m_Mesh->TextureName; }
+
+        void SetModelName(std::string_view modelName);
+        void SetTextureName(std::string_view textureName);
+
+        // Program wide, so instances in different scenes share blocks too
+        static StaticMeshDataTable& GetSharedData();
+
+        // Scene file form, the shared data pointer is replaced by the string table indices of its names
+        struct SerializedRecord
+        {
+            uint32_t ModelName = 0;
+            uint32_t TextureName = 0;
+        };
+
+        static void Encode(std::span<const StaticMeshComponent> components, std::span<SerializedRecord> outRecords, NameTable& strings);
+        static void Decode(std::span<const SerializedRecord> records, std::span<StaticMeshComponent> outComponents, std::span<const std::string_view> strings);
+
+        // Inspector widgets, see ComponentTypeInfo::drawImGuiFunc. Read only, so nothing is ever committed.
+        static bool DrawImGui(Scene& scene, uint32_t entityId, StaticMeshComponent& component);
+
+    private:
+
+        SharedRef<StaticMeshData> m_Mesh;
     };
-}
 
+    // The only member is a SharedRef, whose bytes can be moved along with its count
+    template<>
+    struct IsTriviallyRelocatable<StaticMeshComponent> : std::true_type {};
+}
@@ -6,6 +6,15 @@
 #include <glm/trigonometric.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+glm::mat4 Tempus::TransformComponent::GetLocalMatrix() const
+{
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), Position);
+    model = glm::rotate(model, glm::radians(Rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
+    model = glm::rotate(model, glm::radians(Rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
+    model = glm::rotate(model, glm::radians(Rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
+    return glm::scale(model, Scale);
+}
+
 glm::vec3 Tempus::TransformComponent::GetForwardVector() const
 {
     float pitch = glm::radians(Rotation.x);
@@ -36,17 +45,33 @@ glm::vec3 Tempus::TransformComponent::GetRightVector() const
 
 glm::vec3 Tempus::TransformComponent::GetUpVector() const
 {
-    glm::vec3 forward = GetForwardVector();
-    glm::vec3 right = GetRightVector();
-
-    glm::vec3 up = glm::normalize(glm::cross(right, forward));
+    glm::vec3 forward;
+    glm::vec3 right;
+    glm::vec3 up;
+    GetBasisVectors(forward, right, up);
     return up;
 }
 
-void Tempus::TransformComponent::OnDrawImGui()
+void Tempus::TransformComponent::GetBasisVectors(glm::vec3& outForward, glm::vec3& outRight, glm::vec3& outUp) const
 {
-    ImGui::Text("Transform Component");
-    ImGui::DragFloat3("Position", &Position.x, 0.1f);
-    ImGui::DragFloat3("Rotation", &Rotation.x, 0.1f);
-    ImGui::DragFloat3("Scale", &Scale.x, 0.1f);
+    outForward = GetForwardVector();
+    outRight = glm::normalize(glm::cross(glm::vec3(0.0f, 0.0f, 1.0f), outForward));
+    outUp = glm::normalize(glm::cross(outRight, outForward));
+}
+
+bool Tempus::TransformComponent::DrawImGui(Scene& scene, uint32_t entityId, TransformComponent& component)
+{
+    // Drags and typed values are committed when their widget is let go of
+    bool bCommitted = false;
+    bool bEdited = ImGui::DragFloat3("Position", &component.Position.x);
+    bCommitted |= ImGui::IsItemDeactivatedAfterEdit();
+    bEdited |= ImGui::DragFloat3("Rotation", &component.Rotation.x);
+    bCommitted |= ImGui::IsItemDeactivatedAfterEdit();
+    bEdited |= ImGui::DragFloat3("Scale", &component.Scale.x, 0.1f);
+    bCommitted |= ImGui::IsItemDeactivatedAfterEdit();
+    if (bEdited)
+    {
+        scene.MarkComponentChanged<TransformComponent>(entityId);
+    }
+    return bCommitted;
 }
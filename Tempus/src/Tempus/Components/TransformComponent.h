@@ -4,6 +4,7 @@
 
 #include "Core/Core.h"
 #include <glm/vec3.hpp>
+#include <glm/mat4x4.hpp>
 #include "Component.h"
 
 namespace Tempus
@@ -36,11 +37,17 @@ namespace Tempus
         glm::vec3 Rotation = glm::vec3(0.0f);
         glm::vec3 Scale = glm::vec3(1.0f);
 
+        // Translation, then X, Y and Z rotation in degrees, then scale, relative to the parent if the entity has one
+        glm::mat4 GetLocalMatrix() const;
+
         glm::vec3 GetForwardVector() const;
         glm::vec3 GetRightVector() const;
         glm::vec3 GetUpVector() const;
+        // All three vectors from a single forward vector evaluation, cheaper than calling each getter
+        void GetBasisVectors(glm::vec3& outForward, glm::vec3& outRight, glm::vec3& outUp) const;
 
-        void OnDrawImGui() override;
+        // Inspector widgets, see ComponentTypeInfo::drawImGuiFunc
+        static bool DrawImGui(Scene& scene, uint32_t entityId, TransformComponent& component);
         
     };
     
@@ -1,3 +1,3 @@
 // Copyright Levi Spevakow (C) 2025
 
-#include "EditorDataComponent.h"
+#include "WorldCellComponent.h"
@@ -0,0 +1,25 @@
+// Copyright Levi Spevakow (C) 2025
+
+#pragma once
+
+#include "Core/Core.h"
+#include "Component.h"
+
+namespace Tempus
+{
+    // Grid cell of a WorldPartition the entity was streamed in from.
+    // Written into the cell files, so every streamed entity knows which cell to unload it with.
+    class TEMPUS_API WorldCellComponent : public Component
+    {
+        DECLARE_COMPONENT(WorldCellComponent, 11, ComponentMetaFlags::NoEditorAdd | ComponentMetaFlags::NoDuplicate)
+        TPS_DEBUG_NAME("World Cell Component")
+
+    public:
+
+        WorldCellComponent() = default;
+        WorldCellComponent(int32_t x, int32_t y) : X(x), Y(y) {}
+
+        int32_t X = 0;
+        int32_t Y = 0;
+    };
+}
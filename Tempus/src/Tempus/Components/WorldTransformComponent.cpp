@@ -0,0 +1,3 @@
+// Copyright Levi Spevakow (C) 2025
+
+#include "WorldTransformComponent.h"
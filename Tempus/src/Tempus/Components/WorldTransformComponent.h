@@ -0,0 +1,32 @@
+// Copyright Levi Spevakow (C) 2025
+
+#pragma once
+
+#include "Core/Core.h"
+#include "Component.h"
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+namespace Tempus
+{
+    // Derived transform data cached by the TransformSystem, recomputed only when the entity's transform
+    // or one of its parents' transforms changes. Added to and removed from entities along with their TransformComponent.
+    // Read only, writes are overwritten the next time the transform changes.
+    class TEMPUS_API WorldTransformComponent : public Component
+    {
+        DECLARE_COMPONENT(WorldTransformComponent, 6, ComponentMetaFlags::NoEditorAdd | ComponentMetaFlags::NoSerialize | ComponentMetaFlags::NoDuplicate)
+        TPS_DEBUG_NAME("World Transform Component")
+
+    public:
+
+        // Local matrix combined with every parent's
+        glm::mat4 World = glm::mat4(1.0f);
+
+        // The TransformComponent's GetBasisVectors() turned by every parent's rotation, the same vectors for an entity without a parent
+        glm::vec3 Forward = glm::vec3(1.0f, 0.0f, 0.0f);
+        glm::vec3 Right = glm::vec3(0.0f, 1.0f, 0.0f);
+        glm::vec3 Up = glm::vec3(0.0f, 0.0f, -1.0f);
+
+        glm::vec3 GetPosition() const { return glm::vec3(World[3]); }
+    };
+}
@@ -9,6 +9,7 @@
 #include "Window.h"
 #include "Renderer.h"
 #include "Components/CameraComponent.h"
+#include "Components/ComponentTypeTable.h"
 #include "Events/EventDispatcher.h"
 
 #include "SDL3/SDL_vulkan.h"
@@ -20,8 +21,10 @@
 #include "Managers/SceneManager.h"
 #include "Entity/Entity.h"
 #include "Components/TransformComponent.h"
+#include "Components/WorldTransformComponent.h"
 #include "Utils/Profiling.h"
 #include "Utils/Time.h"
+#include "Jobs/JobSystem.h"
 
 namespace Tempus
 {
@@ -33,6 +36,7 @@ Tempus::Application::Application() : CurrentEvent(SDL_Event()), AppName("Applica
 	GApp = this;
 	m_Window = std::make_unique<Window>();
 	m_Renderer = std::make_unique<Renderer>();
+	m_JobSystem = std::make_unique<JobSystem>();
 
 	// Temporarily hard coding these values.
 	// Will be read from a config system once set up
@@ -77,6 +81,8 @@ R"(
 
 	InitSDL();
 
+	InitJobSystem();
+
 	InitManagers();
 
 	InitWindow();
@@ -84,10 +90,9 @@ R"(
 	InitRenderer();
 
 	// Printing registered components
-	auto components = TPS_Private::ComponentRegistry::GetRegisteredComponents();
 	std::stringstream ss;
 	ss << "Registered Components: \n";
-	for(auto component : components)
+	for (const ComponentTypeInfo& component : TPS_Private::ComponentRegistry::GetRegisteredComponents())
 	{
 		ss << " - " << component.name << '[' << static_cast<uint32_t>(component.id) << ']' << "\n";
 	}
@@ -163,6 +168,12 @@ void Tempus::Application::InitManagers()
 	CreateManager<SceneManager>();
 }
 
+void Tempus::Application::InitJobSystem()
+{
+	// The main thread is worker 0, remaining hardware threads are spawned as workers
+	m_JobSystem->Init();
+}
+
 void Tempus::Application::CoreUpdate()
 {
 	Time::CalculateDeltaTime();
@@ -325,7 +336,7 @@ void Tempus::Application::UpdateEditorCamera()
 	}
 
 	CameraComponent* camComp = activeScene->GetComponent<CameraComponent>(0);
-	TransformComponent* transComp = activeScene->GetComponent<TransformComponent>(0);
+	TransformComponent* transComp = activeScene->GetMutableComponent<TransformComponent>(0);
 
 	// Cam speed up
 	if(m_InputBits.test(6))
@@ -345,14 +356,26 @@ void Tempus::Application::UpdateEditorCamera()
 	
 	if (camComp && transComp)
 	{
+		// Rotation only changes below, so the basis the transform system cached last frame is still current
+		glm::vec3 forward, right, up;
+		if (const WorldTransformComponent* worldComp = activeScene->GetComponent<WorldTransformComponent>(0))
+		{
+			forward = worldComp->Forward;
+			right = worldComp->Right;
+		}
+		else
+		{
+			transComp->GetBasisVectors(forward, right, up);
+		}
+
 		if (SDL_GetWindowRelativeMouseMode(m_Window->GetNativeWindow()))
 		{
 			// Forward / Back Movement
-			transComp->Position += transComp->GetForwardVector() * (m_InputBits.test(0) * (Time::GetUnscaledDeltaTime() * m_EditorCamSpeed));
-			transComp->Position -= transComp->GetForwardVector() * (m_InputBits.test(2) * (Time::GetUnscaledDeltaTime() * m_EditorCamSpeed));
+			transComp->Position += forward * (m_InputBits.test(0) * (Time::GetUnscaledDeltaTime() * m_EditorCamSpeed));
+			transComp->Position -= forward * (m_InputBits.test(2) * (Time::GetUnscaledDeltaTime() * m_EditorCamSpeed));
 			// Right / Left Movement
-			transComp->Position -= transComp->GetRightVector() * (m_InputBits.test(1) * (Time::GetUnscaledDeltaTime() * m_EditorCamSpeed));
-			transComp->Position += transComp->GetRightVector() * (m_InputBits.test(3) * (Time::GetUnscaledDeltaTime() * m_EditorCamSpeed));
+			transComp->Position -= right * (m_InputBits.test(1) * (Time::GetUnscaledDeltaTime() * m_EditorCamSpeed));
+			transComp->Position += right * (m_InputBits.test(3) * (Time::GetUnscaledDeltaTime() * m_EditorCamSpeed));
 			// Up / Down Movement
 			transComp->Position.z -= m_InputBits.test(4) * (Time::GetUnscaledDeltaTime() * m_EditorCamSpeed);
 			transComp->Position.z += m_InputBits.test(5) * (Time::GetUnscaledDeltaTime() * m_EditorCamSpeed);
@@ -368,7 +391,7 @@ void Tempus::Application::UpdateEditorCamera()
 		}
 		else // Scroll movement when mouse is not captured
 		{
-			transComp->Position += transComp->GetForwardVector() * (static_cast<float>(m_SavedMouseScrolls) * 50.0f);
+			transComp->Position += forward * (static_cast<float>(m_SavedMouseScrolls) * 50.0f);
 		}
 	}
 }
@@ -385,6 +408,8 @@ void Tempus::Application::Cleanup()
 {
 	// Explicitly resetting as it uses an SDL function on cleanup
 	m_Window.reset();
+
+	m_JobSystem->Shutdown();
 	
 	SDL_Vulkan_UnloadLibrary();
 	SDL_Quit();
@@ -19,6 +19,7 @@ namespace Tempus {
 	class SceneManager;
 	class Window;
 	class Renderer;
+	class JobSystem;
 
 	class TEMPUS_API Application
 	{
@@ -47,6 +48,9 @@ namespace Tempus {
 			return nullptr;
 		}
 
+		JobSystem* GetJobSystem() const { return m_JobSystem.get(); }
+		Renderer* GetRenderer() const { return m_Renderer.get(); }
+
 		float GetMouseX() const { return m_LastMouseX; }
 		float GetMouseY() const { return m_LastMouseY; }
 		float GetMouseDeltaX() const { return m_MouseDeltaX; }
@@ -68,6 +72,7 @@ namespace Tempus {
 		void InitRenderer();
 		void InitSDL();
 		void InitManagers();
+		void InitJobSystem();
 
 		void CoreUpdate();
 		void ManagerUpdate();
@@ -109,6 +114,7 @@ namespace Tempus {
 		VkInstance m_Instance = nullptr;
 		std::unique_ptr<Window> m_Window;
 		std::unique_ptr<Renderer> m_Renderer;
+		std::unique_ptr<JobSystem> m_JobSystem;
 
 		bool bShouldQuit = false;
 		SDL_Event CurrentEvent;
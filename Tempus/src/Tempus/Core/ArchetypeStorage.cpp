@@ -0,0 +1,388 @@
+// Copyright Levi Spevakow (C) 2025
+
+#include "ArchetypeStorage.h"
+#include "Log.h"
+
+namespace
+{
+    size_t AlignUp(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    uint32_t LoadVersion(const std::atomic<uint32_t>* changeVersionSource)
+    {
+        return changeVersionSource ? changeVersionSource->load(std::memory_order_relaxed) : 1;
+    }
+}
+
+Tempus::Archetype::Archetype(const ComponentSignature& signature, const std::array<ComponentTypeOps, MAX_COMPONENTS>& typeOps, const std::atomic<uint32_t>* const& changeVersionSource)
+    : m_Signature(signature), m_TypeOps(typeOps), m_ChangeVersionSource(changeVersionSource)
+{
+    size_t bytesPerEntity = sizeof(uint32_t);
+    for (ComponentId id = 0; id < MAX_COMPONENTS; id++)
+    {
+        if (m_Signature.test(id))
+        {
+            m_ComponentIds.push_back(id);
+            bytesPerEntity += m_TypeOps[id].size + sizeof(uint32_t);
+        }
+    }
+
+    // Start from the ideal capacity and shrink until the aligned columns fit in a chunk
+    for (uint32_t capacity = static_cast<uint32_t>(ARCHETYPE_CHUNK_SIZE / bytesPerEntity); capacity > 0; capacity--)
+    {
+        size_t offset = sizeof(uint32_t) * capacity;
+        for (ComponentId id : m_ComponentIds)
+        {
+            offset = AlignUp(offset, m_TypeOps[id].alignment);
+            m_ColumnOffsets[id] = offset;
+            offset += m_TypeOps[id].size * capacity;
+        }
+        for (ComponentId id : m_ComponentIds)
+        {
+            offset = AlignUp(offset, alignof(uint32_t));
+            m_VersionOffsets[id] = offset;
+            offset += sizeof(uint32_t) * capacity;
+        }
+
+        if (offset <= ARCHETYPE_CHUNK_SIZE)
+        {
+            m_ChunkCapacity = capacity;
+            break;
+        }
+    }
+
+    TPS_ASSERT(m_ChunkCapacity > 0, "Archetype components exceed the chunk size of {0} bytes!", ARCHETYPE_CHUNK_SIZE);
+}
+
+Tempus::Archetype::~Archetype()
+{
+    for (uint32_t chunkIndex = 0; chunkIndex < m_Chunks.size(); chunkIndex++)
+    {
+        for (ComponentId id : m_ComponentIds)
+        {
+            m_TypeOps[id].destroy(GetColumn(chunkIndex, id), m_Chunks[chunkIndex]->count);
+        }
+    }
+}
+
+void Tempus::Archetype::AllocateRow(uint32_t entityId, uint32_t& outChunk, uint32_t& outRow)
+{
+    if (m_Chunks.empty() || m_Chunks.back()->count == m_ChunkCapacity)
+    {
+        m_Chunks.push_back(std::make_unique<ArchetypeChunk>());
+    }
+
+    outChunk = static_cast<uint32_t>(m_Chunks.size()) - 1;
+    outRow = m_Chunks.back()->count++;
+    m_Chunks.back()->changeVersion = LoadVersion(m_ChangeVersionSource);
+    GetEntities(outChunk)[outRow] = entityId;
+    m_EntityCount++;
+}
+
+void Tempus::Archetype::MarkChunkChanged(uint32_t chunkIndex)
+{
+    // Only written when the version differs, so systems marking rows of the same chunk don't keep dirtying its cache line
+    std::atomic_ref<uint32_t> chunkVersion(m_Chunks[chunkIndex]->changeVersion);
+    const uint32_t version = LoadVersion(m_ChangeVersionSource);
+    if (chunkVersion.load(std::memory_order_relaxed) != version)
+    {
+        chunkVersion.store(version, std::memory_order_relaxed);
+    }
+}
+
+uint32_t Tempus::Archetype::RemoveRow(uint32_t chunkIndex, uint32_t row)
+{
+    for (ComponentId id : m_ComponentIds)
+    {
+        m_TypeOps[id].destroy(GetComponent(chunkIndex, row, id), 1);
+    }
+
+    const uint32_t lastChunk = static_cast<uint32_t>(m_Chunks.size()) - 1;
+    const uint32_t lastRow = m_Chunks[lastChunk]->count - 1;
+    uint32_t movedEntity = InvalidEntity;
+
+    const uint32_t version = LoadVersion(m_ChangeVersionSource);
+    m_Chunks[chunkIndex]->changeVersion = version;
+    m_Chunks[lastChunk]->changeVersion = version;
+
+    // Fill the hole with the last row so chunks stay packed
+    if (chunkIndex != lastChunk || row != lastRow)
+    {
+        for (ComponentId id : m_ComponentIds)
+        {
+            m_TypeOps[id].relocate(GetComponent(chunkIndex, row, id), GetComponent(lastChunk, lastRow, id), 1);
+            GetVersion(chunkIndex, row, id) = GetVersion(lastChunk, lastRow, id);
+        }
+        movedEntity = GetEntities(lastChunk)[lastRow];
+        GetEntities(chunkIndex)[row] = movedEntity;
+    }
+
+    m_EntityCount--;
+    if (--m_Chunks[lastChunk]->count == 0)
+    {
+        m_Chunks.pop_back();
+    }
+
+    return movedEntity;
+}
+
+void Tempus::Archetype::Reorder(std::span<const uint32_t> order)
+{
+    TPS_ASSERT(order.size() == m_EntityCount, "Archetype reorder expects every one of its {0} rows, got {1}!", m_EntityCount, order.size());
+
+    std::vector<std::unique_ptr<ArchetypeChunk>> reordered;
+    reordered.reserve(m_Chunks.size());
+
+    for (uint32_t i = 0; i < m_EntityCount; i++)
+    {
+        if (i % m_ChunkCapacity == 0)
+        {
+            reordered.push_back(std::make_unique<ArchetypeChunk>());
+            reordered.back()->changeVersion = LoadVersion(m_ChangeVersionSource);
+        }
+
+        ArchetypeChunk& dstChunk = *reordered.back();
+        const uint32_t dstRow = dstChunk.count++;
+        const uint32_t srcChunk = order[i] / m_ChunkCapacity;
+        const uint32_t srcRow = order[i] % m_ChunkCapacity;
+
+        reinterpret_cast<uint32_t*>(dstChunk.data)[dstRow] = GetEntities(srcChunk)[srcRow];
+        for (ComponentId id : m_ComponentIds)
+        {
+            m_TypeOps[id].relocate(dstChunk.data + m_ColumnOffsets[id] + dstRow * m_TypeOps[id].size, GetComponent(srcChunk, srcRow, id), 1);
+            reinterpret_cast<uint32_t*>(dstChunk.data + m_VersionOffsets[id])[dstRow] = GetVersion(srcChunk, srcRow, id);
+        }
+    }
+
+    // Every component was relocated out of the old chunks, so they are released without destroying anything
+    m_Chunks = std::move(reordered);
+}
+
+void Tempus::Archetype::CopyChunks(const Archetype& source)
+{
+    TPS_ASSERT(m_Chunks.empty() && m_Signature == source.m_Signature, "Archetype chunks can only be copied into an empty archetype of the same signature!");
+
+    m_Chunks.reserve(source.m_Chunks.size());
+    for (const std::unique_ptr<ArchetypeChunk>& sourceChunk : source.m_Chunks)
+    {
+        // The entity column, versions and every trivially copyable column come across in one copy
+        ArchetypeChunk& chunk = *m_Chunks.emplace_back(std::make_unique<ArchetypeChunk>(*sourceChunk));
+        for (ComponentId id : m_ComponentIds)
+        {
+            if (!m_TypeOps[id].bTriviallyCopyable)
+            {
+                m_TypeOps[id].copyConstruct(chunk.data + m_ColumnOffsets[id], sourceChunk->data + m_ColumnOffsets[id], chunk.count);
+            }
+        }
+    }
+    m_EntityCount = source.m_EntityCount;
+}
+
+void Tempus::ArchetypeStorage::AddEntities(std::span<const uint32_t> entityIds, const ComponentSignature& signature)
+{
+    if (signature.none())
+    {
+        return;
+    }
+
+    Archetype* archetype = GetOrCreateArchetype(signature);
+    const uint32_t version = LoadVersion(m_ChangeVersionSource);
+
+    std::vector<ComponentId> componentIds;
+    for (ComponentId componentId = 0; componentId < MAX_COMPONENTS; componentId++)
+    {
+        if (signature.test(componentId))
+        {
+            componentIds.push_back(componentId);
+        }
+    }
+
+    for (uint32_t entityId : entityIds)
+    {
+        EntityLocation& location = m_EntityLocations.Ensure(GetEntityIndex(entityId));
+        location.archetype = archetype;
+        archetype->AllocateRow(entityId, location.chunk, location.row);
+        for (ComponentId componentId : componentIds)
+        {
+            archetype->GetVersion(location.chunk, location.row, componentId) = version;
+        }
+    }
+}
+
+void Tempus::ArchetypeStorage::RemoveComponent(uint32_t entityId, ComponentId componentId)
+{
+    ComponentSignature signature = GetSignature(entityId);
+    if (!signature.test(componentId))
+    {
+        return;
+    }
+
+    signature.reset(componentId);
+    MoveEntity(entityId, signature);
+}
+
+void Tempus::ArchetypeStorage::RemoveEntity(uint32_t entityId)
+{
+    EntityLocation* location = m_EntityLocations.TryGet(GetEntityIndex(entityId));
+    if (!location)
+    {
+        return;
+    }
+
+    if (location->archetype)
+    {
+        uint32_t movedEntity = location->archetype->RemoveRow(location->chunk, location->row);
+        if (movedEntity != Archetype::InvalidEntity)
+        {
+            m_EntityLocations[GetEntityIndex(movedEntity)] = *location;
+        }
+    }
+
+    *location = EntityLocation();
+}
+
+void* Tempus::ArchetypeStorage::GetComponentMemory(uint32_t entityId, ComponentId componentId)
+{
+    const EntityLocation* location = m_EntityLocations.TryGet(GetEntityIndex(entityId));
+    if (!location || !location->archetype || !location->archetype->GetSignature().test(componentId))
+    {
+        return nullptr;
+    }
+
+    return location->archetype->GetComponent(location->chunk, location->row, componentId);
+}
+
+void Tempus::ArchetypeStorage::MarkChanged(uint32_t entityId, ComponentId componentId)
+{
+    const EntityLocation* location = m_EntityLocations.TryGet(GetEntityIndex(entityId));
+    if (location && location->archetype && location->archetype->GetSignature().test(componentId))
+    {
+        location->archetype->GetVersion(location->chunk, location->row, componentId) = LoadVersion(m_ChangeVersionSource);
+        location->archetype->MarkChunkChanged(location->chunk);
+    }
+}
+
+uint32_t Tempus::ArchetypeStorage::GetVersion(uint32_t entityId, ComponentId componentId) const
+{
+    const EntityLocation* location = m_EntityLocations.TryGet(GetEntityIndex(entityId));
+    if (!location || !location->archetype || !location->archetype->GetSignature().test(componentId))
+    {
+        return 0;
+    }
+    return location->archetype->GetVersion(location->chunk, location->row, componentId);
+}
+
+size_t Tempus::ArchetypeStorage::GetMemoryUsage() const
+{
+    size_t bytes = m_EntityLocations.GetMemoryUsage();
+    for (const auto& [signature, archetype] : m_Archetypes)
+    {
+        bytes += archetype->GetMemoryUsage();
+    }
+    return bytes;
+}
+
+std::unique_ptr<Tempus::ArchetypeStorage> Tempus::ArchetypeStorage::Clone() const
+{
+    std::unique_ptr<ArchetypeStorage> clone = std::make_unique<ArchetypeStorage>();
+    clone->m_TypeOps = m_TypeOps;
+    clone->m_EntityLocations = m_EntityLocations;
+    clone->m_Archetypes.reserve(m_Archetypes.size());
+
+    for (const auto& [signature, archetype] : m_Archetypes)
+    {
+        std::unique_ptr<Archetype>& cloned = clone->m_Archetypes[signature];
+        cloned = std::make_unique<Archetype>(signature, clone->m_TypeOps, clone->m_ChangeVersionSource);
+        cloned->CopyChunks(*archetype);
+
+        // Chunk and row carry over from the copied locations, only the archetype they point at changes
+        for (uint32_t chunk = 0; chunk < cloned->GetChunkCount(); chunk++)
+        {
+            const uint32_t* entities = cloned->GetEntities(chunk);
+            for (uint32_t row = 0; row < cloned->GetChunk(chunk).count; row++)
+            {
+                clone->m_EntityLocations[GetEntityIndex(entities[row])].archetype = cloned.get();
+            }
+        }
+    }
+    return clone;
+}
+
+void Tempus::ArchetypeStorage::ReorderArchetype(Archetype& archetype, std::span<const uint32_t> order)
+{
+    archetype.Reorder(order);
+
+    for (uint32_t chunk = 0; chunk < archetype.GetChunkCount(); chunk++)
+    {
+        const uint32_t* entities = archetype.GetEntities(chunk);
+        for (uint32_t row = 0; row < archetype.GetChunk(chunk).count; row++)
+        {
+            EntityLocation& location = m_EntityLocations[GetEntityIndex(entities[row])];
+            location.chunk = chunk;
+            location.row = row;
+        }
+    }
+}
+
+Tempus::ComponentSignature Tempus::ArchetypeStorage::GetSignature(uint32_t entityId) const
+{
+    const EntityLocation* location = m_EntityLocations.TryGet(GetEntityIndex(entityId));
+    if (location && location->archetype)
+    {
+        return location->archetype->GetSignature();
+    }
+    return {};
+}
+
+Tempus::Archetype* Tempus::ArchetypeStorage::GetOrCreateArchetype(const ComponentSignature& signature)
+{
+    auto it = m_Archetypes.find(signature);
+    if (it != m_Archetypes.end())
+    {
+        return it->second.get();
+    }
+
+    TPS_CORE_TRACE("Archetype created! Signature: [{0}]", signature.to_string());
+    auto [newIt, inserted] = m_Archetypes.emplace(signature, std::make_unique<Archetype>(signature, m_TypeOps, m_ChangeVersionSource));
+    return newIt->second.get();
+}
+
+void Tempus::ArchetypeStorage::MoveEntity(uint32_t entityId, const ComponentSignature& newSignature)
+{
+    EntityLocation& location = m_EntityLocations.Ensure(GetEntityIndex(entityId));
+    Archetype* source = location.archetype;
+    EntityLocation destination;
+
+    if (newSignature.any())
+    {
+        destination.archetype = GetOrCreateArchetype(newSignature);
+        destination.archetype->AllocateRow(entityId, destination.chunk, destination.row);
+    }
+
+    if (source)
+    {
+        // Move shared components across, the source row is then destroyed which cleans up the moved-from objects
+        if (destination.archetype)
+        {
+            const ComponentSignature shared = source->GetSignature() & newSignature;
+            for (ComponentId id = 0; id < MAX_COMPONENTS; id++)
+            {
+                if (shared.test(id))
+                {
+                    m_TypeOps[id].moveConstruct(destination.archetype->GetComponent(destination.chunk, destination.row, id), source->GetComponent(location.chunk, location.row, id), 1);
+                    destination.archetype->GetVersion(destination.chunk, destination.row, id) = source->GetVersion(location.chunk, location.row, id);
+                }
+            }
+        }
+
+        uint32_t movedEntity = source->RemoveRow(location.chunk, location.row);
+        if (movedEntity != Archetype::InvalidEntity)
+        {
+            m_EntityLocations[GetEntityIndex(movedEntity)] = location;
+        }
+    }
+
+    m_EntityLocations[GetEntityIndex(entityId)] = destination;
+}
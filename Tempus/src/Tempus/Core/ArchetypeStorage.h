@@ -0,0 +1,290 @@
+// Copyright Levi Spevakow (C) 2025
+
+#pragma once
+
+#include "Core.h"
+#include "ComponentTypeOps.h"
+#include "PagedArray.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Tempus
+{
+    using ComponentSignature = std::bitset<MAX_COMPONENTS>;
+
+    // Size of a single archetype chunk in bytes
+    constexpr size_t ARCHETYPE_CHUNK_SIZE = 16 * 1024;
+
+    // Fixed size block of memory holding a number of entities of the same archetype.
+    // Laid out SoA: the entity ID column comes first, followed by one tightly packed array per component type,
+    // then one change version array per component type.
+    struct alignas(64) ArchetypeChunk
+    {
+        std::byte data[ARCHETYPE_CHUNK_SIZE];
+        uint32_t count = 0;
+        // Latest change version at which any row was added, moved, removed or marked changed
+        uint32_t changeVersion = 0;
+    };
+
+    // All entities sharing an identical component signature
+    class TEMPUS_API Archetype
+    {
+    public:
+
+        Archetype(const ComponentSignature& signature, const std::array<ComponentTypeOps, MAX_COMPONENTS>& typeOps, const std::atomic<uint32_t>* const& changeVersionSource);
+        ~Archetype();
+
+        Archetype(const Archetype&) = delete;
+        Archetype& operator=(const Archetype&) = delete;
+
+        const ComponentSignature& GetSignature() const { return m_Signature; }
+        uint32_t GetEntityCount() const { return m_EntityCount; }
+        uint32_t GetChunkCount() const { return static_cast<uint32_t>(m_Chunks.size()); }
+        uint32_t GetChunkCapacity() const { return m_ChunkCapacity; }
+        ArchetypeChunk& GetChunk(uint32_t chunkIndex) { return *m_Chunks[chunkIndex]; }
+
+        uint32_t* GetEntities(uint32_t chunkIndex) { return reinterpret_cast<uint32_t*>(m_Chunks[chunkIndex]->data); }
+
+        // Start of the packed array for a component type within a chunk
+        void* GetColumn(uint32_t chunkIndex, ComponentId componentId) { return m_Chunks[chunkIndex]->data + m_ColumnOffsets[componentId]; }
+
+        void* GetComponent(uint32_t chunkIndex, uint32_t row, ComponentId componentId)
+        {
+            return static_cast<std::byte*>(GetColumn(chunkIndex, componentId)) + row * m_TypeOps[componentId].size;
+        }
+
+        // Versions the components of a type in a chunk were added or last changed at, see Scene::AdvanceChangeVersion()
+        uint32_t* GetVersions(uint32_t chunkIndex, ComponentId componentId) { return reinterpret_cast<uint32_t*>(m_Chunks[chunkIndex]->data + m_VersionOffsets[componentId]); }
+        uint32_t& GetVersion(uint32_t chunkIndex, uint32_t row, ComponentId componentId) { return GetVersions(chunkIndex, componentId)[row]; }
+
+        // Stamps the chunk with the current change version, safe to call from parallel systems
+        void MarkChunkChanged(uint32_t chunkIndex);
+
+        // Appends a row for the entity. Component memory in the new row is left unconstructed.
+        void AllocateRow(uint32_t entityId, uint32_t& outChunk, uint32_t& outRow);
+
+        // Destroys every component in the row and fills the hole with the last row of the archetype.
+        // Returns the ID of the entity that was moved into the hole, or InvalidEntity if none was moved.
+        uint32_t RemoveRow(uint32_t chunkIndex, uint32_t row);
+
+        // Rearranges every row so that row i afterwards holds what row order[i] held, rows are numbered
+        // chunk * GetChunkCapacity() + row. order must be a permutation of all rows. Rows are relocated
+        // into freshly allocated chunks, so the archetype briefly needs twice its memory.
+        void Reorder(std::span<const uint32_t> order);
+
+        // Copies every chunk of an empty archetype with the same signature into this one.
+        // Chunks are copied whole, then every column whose type isn't trivially copyable is copy constructed from the
+        // source, so types that are only trivially relocatable, such as StaticMeshComponent, still run their copy constructors.
+        void CopyChunks(const Archetype& source);
+
+        size_t GetMemoryUsage() const { return m_Chunks.size() * sizeof(ArchetypeChunk); }
+
+        static constexpr uint32_t InvalidEntity = std::numeric_limits<uint32_t>::max();
+
+    private:
+
+        ComponentSignature m_Signature;
+        std::vector<ComponentId> m_ComponentIds;
+        std::array<size_t, MAX_COMPONENTS> m_ColumnOffsets = {};
+        std::array<size_t, MAX_COMPONENTS> m_VersionOffsets = {};
+        const std::array<ComponentTypeOps, MAX_COMPONENTS>& m_TypeOps;
+        // The owning storage's source, which is set after its archetypes may already exist
+        const std::atomic<uint32_t>* const& m_ChangeVersionSource;
+        uint32_t m_ChunkCapacity = 0;
+        uint32_t m_EntityCount = 0;
+        std::vector<std::unique_ptr<ArchetypeChunk>> m_Chunks;
+    };
+
+    // Alternative component storage that groups entities by component signature into chunks.
+    // Entities are moved between archetypes whenever a component is added or removed.
+    // Component pointers are invalidated by any structural change to the owning archetype.
+    class TEMPUS_API ArchetypeStorage
+    {
+    public:
+
+        struct EntityLocation
+        {
+            Archetype* archetype = nullptr;
+            uint32_t chunk = 0;
+            uint32_t row = 0;
+        };
+
+        template<ValidComponent T>
+        void RegisterType()
+        {
+            RegisterType(T::GetId(), ComponentTypeOps::Create<T>());
+        }
+
+        // Type-erased RegisterType(), for storage restored from component type info
+        void RegisterType(ComponentId componentId, const ComponentTypeOps& ops)
+        {
+            if (!m_TypeOps[componentId].IsValid())
+            {
+                m_TypeOps[componentId] = ops;
+            }
+        }
+
+        template<ValidComponent T, typename... Args>
+        T* AddComponent(uint32_t entityId, Args&&... args)
+        {
+            RegisterType<T>();
+
+            ComponentSignature signature = GetSignature(entityId);
+            signature.set(T::GetId());
+            MoveEntity(entityId, signature);
+
+            T* component = new (GetComponentMemory(entityId, T::GetId())) T(std::forward<Args>(args)...);
+            MarkChanged(entityId, T::GetId());
+            return component;
+        }
+
+        // Places entities that have no components yet into the archetype of the given component types,
+        // each row receiving a copy of the prototypes. Rows are filled chunk by chunk in ID order.
+        // Tags are skipped, they are never part of an archetype.
+        template<ValidComponent... Ts>
+        void AddEntities(std::span<const uint32_t> entityIds, const Ts&... prototypes)
+        {
+            ComponentSignature signature;
+            (signature.set(Ts::GetId(), !TagComponent<Ts>), ...);
+            if (signature.none())
+            {
+                return;
+            }
+
+            (RegisterType<Ts>(), ...);
+
+            Archetype* archetype = GetOrCreateArchetype(signature);
+            const uint32_t version = m_ChangeVersionSource ? m_ChangeVersionSource->load(std::memory_order_relaxed) : 1;
+
+            for (uint32_t entityId : entityIds)
+            {
+                EntityLocation& location = m_EntityLocations.Ensure(GetEntityIndex(entityId));
+                location.archetype = archetype;
+                archetype->AllocateRow(entityId, location.chunk, location.row);
+                (ConstructPrototype(*archetype, location, prototypes, version), ...);
+            }
+        }
+
+        // Places entities that have no components yet into the archetype of the signature, rows are filled in the order given.
+        // Every component type in the signature must be registered. Component memory in the new rows is left
+        // unconstructed, the caller must construct every component of every row before the storage is used.
+        void AddEntities(std::span<const uint32_t> entityIds, const ComponentSignature& signature);
+
+        template<ValidComponent T>
+        T* GetComponent(uint32_t entityId)
+        {
+            return static_cast<T*>(GetComponentMemory(entityId, T::GetId()));
+        }
+
+        void RemoveComponent(uint32_t entityId, ComponentId componentId);
+        void RemoveEntity(uint32_t entityId);
+
+        void* GetComponentMemory(uint32_t entityId, ComponentId componentId);
+
+        // nullptr if the entity isn't stored in any archetype
+        const EntityLocation* GetLocation(uint32_t entityId) const
+        {
+            const EntityLocation* location = m_EntityLocations.TryGet(GetEntityIndex(entityId));
+            return location && location->archetype ? location : nullptr;
+        }
+
+        // Stamps the component with the current change version
+        void MarkChanged(uint32_t entityId, ComponentId componentId);
+        // Version the component was added or last marked changed at, 0 if the entity doesn't have the component
+        uint32_t GetVersion(uint32_t entityId, ComponentId componentId) const;
+        // Counter read when stamping components, owned by the scene
+        void SetChangeVersionSource(const std::atomic<uint32_t>* changeVersion) { m_ChangeVersionSource = changeVersion; }
+
+        // Sorts the rows of every archetype containing T into ascending keyFunc(const T&) order, ties keep their current order.
+        // Archetypes are sorted independently, an entity never changes archetype.
+        template<ValidComponent T, typename KeyFunc>
+        void Sort(KeyFunc&& keyFunc)
+        {
+            using Key = std::decay_t<std::invoke_result_t<KeyFunc&, const T&>>;
+
+            ComponentSignature required;
+            required.set(T::GetId());
+
+            std::vector<std::pair<Key, uint32_t>> keys;
+            std::vector<uint32_t> order;
+            ForEachArchetype(required, [&](Archetype& archetype)
+            {
+                keys.clear();
+                for (uint32_t chunk = 0; chunk < archetype.GetChunkCount(); chunk++)
+                {
+                    const T* column = static_cast<const T*>(archetype.GetColumn(chunk, T::GetId()));
+                    for (uint32_t row = 0; row < archetype.GetChunk(chunk).count; row++)
+                    {
+                        keys.emplace_back(keyFunc(column[row]), chunk * archetype.GetChunkCapacity() + row);
+                    }
+                }
+                std::sort(keys.begin(), keys.end());
+
+                order.clear();
+                for (const auto& [key, row] : keys)
+                {
+                    order.push_back(row);
+                }
+                ReorderArchetype(archetype, order);
+            });
+        }
+
+        // Invokes func(Archetype&) for every non-empty archetype containing all required components
+        template<typename Func>
+        void ForEachArchetype(const ComponentSignature& required, Func&& func)
+        {
+            for (auto& [signature, archetype] : m_Archetypes)
+            {
+                if ((signature & required) == required && archetype->GetEntityCount() > 0)
+                {
+                    func(*archetype);
+                }
+            }
+        }
+
+        uint32_t GetArchetypeCount() const { return static_cast<uint32_t>(m_Archetypes.size()); }
+
+        // Copy of every archetype and entity location, without a change version source
+        std::unique_ptr<ArchetypeStorage> Clone() const;
+        size_t GetMemoryUsage() const;
+
+    private:
+
+        // AddEntities() row initialization, tags have no column
+        template<ValidComponent T>
+        static void ConstructPrototype(Archetype& archetype, const EntityLocation& location, const T& prototype, uint32_t version)
+        {
+            if constexpr (!TagComponent<T>)
+            {
+                new (archetype.GetComponent(location.chunk, location.row, T::GetId())) T(prototype);
+                archetype.GetVersion(location.chunk, location.row, T::GetId()) = version;
+            }
+        }
+
+        ComponentSignature GetSignature(uint32_t entityId) const;
+        // Archetype::Reorder() plus the location update of every entity in it
+        void ReorderArchetype(Archetype& archetype, std::span<const uint32_t> order);
+        Archetype* GetOrCreateArchetype(const ComponentSignature& signature);
+
+        // Moves an entity into the archetype matching the new signature.
+        // Components present in both archetypes are moved across, components only in the new signature are left unconstructed.
+        void MoveEntity(uint32_t entityId, const ComponentSignature& newSignature);
+
+        std::array<ComponentTypeOps, MAX_COMPONENTS> m_TypeOps = {};
+        std::unordered_map<ComponentSignature, std::unique_ptr<Archetype>> m_Archetypes;
+        // Indexed by entity index, the chunk entity columns hold the full entity IDs
+        PagedArray<EntityLocation> m_EntityLocations;
+        const std::atomic<uint32_t>* m_ChangeVersionSource = nullptr;
+    };
+}
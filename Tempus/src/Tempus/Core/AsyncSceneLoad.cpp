@@ -0,0 +1,56 @@
+// Copyright Levi Spevakow (C) 2025
+
+#include "AsyncSceneLoad.h"
+
+#include "SceneSerializer.h"
+#include "Jobs/JobSystem.h"
+#include "Systems/TransformSystem.h"
+#include <chrono>
+
+std::shared_ptr<Tempus::AsyncSceneLoad> Tempus::AsyncSceneLoad::Start(const std::filesystem::path& path, JobSystem* jobSystem, PrepareFunc prepare)
+{
+    std::shared_ptr<AsyncSceneLoad> load(new AsyncSceneLoad(path));
+
+    if (!jobSystem || jobSystem->GetWorkerCount() <= 1)
+    {
+        load->Load(prepare);
+        return load;
+    }
+
+    // The job keeps the load alive, so the caller is free to drop it at any time
+    jobSystem->RunBackground([load, prepare = std::move(prepare)]()
+    {
+        load->Load(prepare);
+    });
+    return load;
+}
+
+std::unique_ptr<Tempus::Scene> Tempus::AsyncSceneLoad::TakeScene()
+{
+    return IsFinished() ? std::move(m_Scene) : nullptr;
+}
+
+void Tempus::AsyncSceneLoad::Load(const PrepareFunc& prepare)
+{
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    std::unique_ptr<Scene> scene = SceneSerializer::Load(m_Path);
+    if (scene)
+    {
+        // Everything the first update of a freshly loaded scene would otherwise rebuild on the main thread
+        scene->FlushComponentObservers();
+        if (TransformSystem* transformSystem = scene->GetTransformSystem())
+        {
+            transformSystem->OnUpdate(0.0f);
+        }
+
+        if (prepare)
+        {
+            prepare(*scene);
+        }
+    }
+
+    m_LoadMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    m_Scene = std::move(scene);
+    m_bFinished.store(true, std::memory_order_release);
+}
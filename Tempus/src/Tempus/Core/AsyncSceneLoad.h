@@ -0,0 +1,56 @@
+// Copyright Levi Spevakow (C) 2025
+
+#pragma once
+
+#include "Core.h"
+#include "Scene.h"
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <memory>
+
+namespace Tempus
+{
+    class JobSystem;
+
+    // Loads a scene file on a background worker while the current scene keeps updating and rendering.
+    // Besides reading the file the worker resolves the scene's derived data, such as world transforms, and runs the
+    // prepare callback for resource preloading, so swapping the finished scene in costs the main thread next to nothing.
+    // The load is shared with the worker, dropping every other reference to it discards the scene once the worker is done.
+    class TEMPUS_API AsyncSceneLoad
+    {
+    public:
+
+        // Runs on the loading worker once the scene is complete
+        using PrepareFunc = std::function<void(Scene&)>;
+
+        // Starts loading the file as a background job. Loads on the calling thread before returning if jobSystem
+        // is nullptr or has no workers besides the calling thread.
+        static std::shared_ptr<AsyncSceneLoad> Start(const std::filesystem::path& path, JobSystem* jobSystem, PrepareFunc prepare = {});
+
+        AsyncSceneLoad(const AsyncSceneLoad&) = delete;
+        AsyncSceneLoad& operator=(const AsyncSceneLoad&) = delete;
+
+        // True once the worker is done, whether the file loaded or not
+        bool IsFinished() const { return m_bFinished.load(std::memory_order_acquire); }
+
+        // The loaded scene, nullptr if the load isn't finished, failed or the scene was taken already
+        std::unique_ptr<Scene> TakeScene();
+
+        const std::filesystem::path& GetPath() const { return m_Path; }
+        // Time the worker spent loading and preparing the scene, valid once finished
+        double GetLoadMs() const { return m_LoadMs; }
+
+    private:
+
+        explicit AsyncSceneLoad(std::filesystem::path path) : m_Path(std::move(path)) {}
+
+        void Load(const PrepareFunc& prepare);
+
+        std::filesystem::path m_Path;
+        // Written by the worker before m_bFinished is set, only read after
+        std::unique_ptr<Scene> m_Scene;
+        double m_LoadMs = 0.0;
+        std::atomic<bool> m_bFinished = false;
+    };
+}
@@ -0,0 +1,354 @@
+// Copyright Levi Spevakow (C) 2025
+
+#pragma once
+
+#include "Core.h"
+#include "PagedArray.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <limits>
+#include <span>
+#include "Log.h"
+
+namespace Tempus
+{
+    // Base class for type-erased component pools
+    class IComponentPool
+    {
+    public:
+        virtual ~IComponentPool() = default;
+        virtual void RemoveComponent(uint32_t entityId) = 0;
+        virtual bool HasComponent(uint32_t entityId) const = 0;
+        virtual uint32_t GetSize() const = 0;
+        virtual std::span<const uint32_t> GetEntityIds() const = 0;
+        // Packed components, element i belongs to GetEntityIds()[i]
+        virtual const void* GetComponentData() const = 0;
+        // nullptr if the entity doesn't have the component
+        virtual void* GetComponentMemory(uint32_t entityId) = 0;
+        // Appends a default constructed component for every entity and returns the first new one, the rest follow it
+        // contiguously. None of the entities may already have the component.
+        virtual void* AddDefaultComponents(std::span<const uint32_t> entityIds) = 0;
+        // Counter read when stamping components as they are added or marked changed, owned by the scene
+        virtual void SetChangeVersionSource(const std::atomic<uint32_t>* changeVersion) = 0;
+        // Approximate heap memory owned by the pool in bytes
+        virtual size_t GetMemoryUsage() const = 0;
+        // Whether a sort started by BeginSort() still has components to move
+        virtual bool IsSorting() const = 0;
+        // Moves up to maxMoves components into their sorted position, returns true once the sort has finished
+        virtual bool ContinueSort(uint32_t maxMoves) = 0;
+        // Latest change version at which any of count dense elements from begin was added, moved, removed or marked changed
+        virtual uint32_t GetChangeVersion(uint32_t begin, uint32_t count) const = 0;
+        // Copy of the pool including any sort in progress, without a change version source
+        virtual std::unique_ptr<IComponentPool> Clone() const = 0;
+    };
+
+    // Sparse set component pool that stores components of a specific type
+    // - Paged sparse array maps entity index -> index in the dense arrays
+    // - Dense arrays store the live components, their owning entity IDs and the version they were last changed at tightly packed
+    // - Every ChangePageSize dense elements also share the version of their last add, move, removal or change
+    // Removal swaps the last component into the freed slot, so iteration only ever touches live components.
+    // Component pointers are invalidated by any add, remove or sort on the same pool.
+    template<ValidComponent T>
+    class ComponentPool : public IComponentPool
+    {
+    public:
+
+        static constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+        // Dense elements sharing one page change version, see GetChangeVersion()
+        static constexpr uint32_t ChangePageSize = 256;
+
+        template<typename... Args>
+        T* AddComponent(uint32_t entityId, Args&&... args)
+        {
+            // By this point the Scene class should have already checked for the component existence, checking again for safety
+            if (HasComponent(entityId))
+            {
+                TPS_ERROR("Component already exists for entity [{0}]!", entityId);
+                return nullptr;
+            }
+
+            const uint32_t index = static_cast<uint32_t>(m_Dense.size());
+            m_Sparse.Ensure(GetEntityIndex(entityId)) = index;
+            m_DenseEntities.push_back(entityId);
+            m_Versions.push_back(GetCurrentVersion());
+            StampPages(index, index + 1);
+            return &m_Dense.emplace_back(std::forward<Args>(args)...);
+        }
+
+        // Appends a copy of the prototype for every entity in one contiguous range.
+        // None of the entities may already have the component.
+        void AddComponents(std::span<const uint32_t> entityIds, const T& prototype)
+        {
+            const uint32_t firstIndex = static_cast<uint32_t>(m_Dense.size());
+            uint32_t denseIndex = firstIndex;
+            for (uint32_t entityId : entityIds)
+            {
+                m_Sparse.Ensure(GetEntityIndex(entityId)) = denseIndex++;
+            }
+
+            m_DenseEntities.insert(m_DenseEntities.end(), entityIds.begin(), entityIds.end());
+            m_Versions.insert(m_Versions.end(), entityIds.size(), GetCurrentVersion());
+            m_Dense.insert(m_Dense.end(), entityIds.size(), prototype);
+            StampPages(firstIndex, denseIndex);
+        }
+
+        void* AddDefaultComponents(std::span<const uint32_t> entityIds) override
+        {
+            const uint32_t firstIndex = static_cast<uint32_t>(m_Dense.size());
+            uint32_t denseIndex = firstIndex;
+            for (uint32_t entityId : entityIds)
+            {
+                m_Sparse.Ensure(GetEntityIndex(entityId)) = denseIndex++;
+            }
+
+            m_DenseEntities.insert(m_DenseEntities.end(), entityIds.begin(), entityIds.end());
+            m_Versions.insert(m_Versions.end(), entityIds.size(), GetCurrentVersion());
+            m_Dense.resize(m_Dense.size() + entityIds.size());
+            StampPages(firstIndex, denseIndex);
+            return m_Dense.data() + firstIndex;
+        }
+
+        void RemoveComponent(uint32_t entityId) override
+        {
+            if (!HasComponent(entityId))
+            {
+                return;
+            }
+
+            // Filling the hole can move an unsorted component into the already sorted range
+            CancelSort();
+
+            const uint32_t index = m_Sparse[GetEntityIndex(entityId)];
+            const uint32_t lastIndex = static_cast<uint32_t>(m_Dense.size()) - 1;
+
+            // Swap and pop to keep the dense arrays packed
+            if (index != lastIndex)
+            {
+                const uint32_t lastEntity = m_DenseEntities[lastIndex];
+                m_Dense[index] = std::move(m_Dense[lastIndex]);
+                m_DenseEntities[index] = lastEntity;
+                m_Versions[index] = m_Versions[lastIndex];
+                m_Sparse[GetEntityIndex(lastEntity)] = index;
+            }
+
+            StampPages(index, index + 1);
+            StampPages(lastIndex, lastIndex + 1);
+            m_Dense.pop_back();
+            m_DenseEntities.pop_back();
+            m_Versions.pop_back();
+            m_PageVersions.resize((m_Dense.size() + ChangePageSize - 1) / ChangePageSize);
+            m_Sparse[GetEntityIndex(entityId)] = InvalidIndex;
+        }
+
+        T* GetComponent(uint32_t entityId)
+        {
+            if (HasComponent(entityId))
+            {
+                return &m_Dense[m_Sparse[GetEntityIndex(entityId)]];
+            }
+            return nullptr;
+        }
+
+        // Same as GetComponent() but also marks the component as changed, use whenever the component will be written
+        T* GetMutableComponent(uint32_t entityId)
+        {
+            if (HasComponent(entityId))
+            {
+                const uint32_t index = m_Sparse[GetEntityIndex(entityId)];
+                m_Versions[index] = GetCurrentVersion();
+                StampChanged(index);
+                return &m_Dense[index];
+            }
+            return nullptr;
+        }
+
+        void MarkChanged(uint32_t entityId)
+        {
+            if (HasComponent(entityId))
+            {
+                const uint32_t index = m_Sparse[GetEntityIndex(entityId)];
+                m_Versions[index] = GetCurrentVersion();
+                StampChanged(index);
+            }
+        }
+
+        // Version the component was added or last marked changed at, 0 if the entity doesn't have the component
+        uint32_t GetVersion(uint32_t entityId) const
+        {
+            return HasComponent(entityId) ? m_Versions[m_Sparse[GetEntityIndex(entityId)]] : 0;
+        }
+
+        void SetChangeVersionSource(const std::atomic<uint32_t>* changeVersion) override { m_ChangeVersionSource = changeVersion; }
+
+        bool HasComponent(uint32_t entityId) const override
+        {
+            const uint32_t* denseIndex = m_Sparse.TryGet(GetEntityIndex(entityId));
+            // Comparing the stored ID also rejects stale IDs from a previous generation of the slot
+            return denseIndex && *denseIndex != InvalidIndex && m_DenseEntities[*denseIndex] == entityId;
+        }
+
+        uint32_t GetSize() const override { return static_cast<uint32_t>(m_Dense.size()); }
+
+        void Reserve(uint32_t count)
+        {
+            m_DenseEntities.reserve(count);
+            m_Versions.reserve(count);
+            m_Dense.reserve(count);
+        }
+
+        size_t GetMemoryUsage() const override
+        {
+            return m_Sparse.GetMemoryUsage() + (m_DenseEntities.capacity() + m_Versions.capacity() + m_PageVersions.capacity() + m_SortOrder.capacity()) * sizeof(uint32_t)
+                + m_Dense.capacity() * sizeof(T);
+        }
+
+        uint32_t GetChangeVersion(uint32_t begin, uint32_t count) const override
+        {
+            uint32_t version = 0;
+            const size_t endPage = std::min<size_t>((static_cast<size_t>(begin) + count + ChangePageSize - 1) / ChangePageSize, m_PageVersions.size());
+            for (size_t page = begin / ChangePageSize; page < endPage; page++)
+            {
+                version = std::max(version, m_PageVersions[page]);
+            }
+            return version;
+        }
+
+        // Plans a reorder of the dense arrays into ascending keyFunc(const T&) order, ties keep their current order.
+        // Nothing moves until ContinueSort() is called, so the work can be spread over several frames.
+        // Components added while sorting end up after the sorted range, removing a component cancels the sort.
+        template<typename KeyFunc>
+        void BeginSort(KeyFunc&& keyFunc)
+        {
+            using Key = std::decay_t<std::invoke_result_t<KeyFunc&, const T&>>;
+
+            std::vector<std::pair<Key, uint32_t>> keys;
+            keys.reserve(m_Dense.size());
+            for (uint32_t i = 0; i < m_Dense.size(); i++)
+            {
+                keys.emplace_back(keyFunc(std::as_const(m_Dense[i])), i);
+            }
+            std::sort(keys.begin(), keys.end());
+
+            m_SortOrder.clear();
+            m_SortOrder.reserve(keys.size());
+            for (const auto& [key, index] : keys)
+            {
+                m_SortOrder.push_back(m_DenseEntities[index]);
+            }
+            m_SortCursor = 0;
+        }
+
+        bool ContinueSort(uint32_t maxMoves) override
+        {
+            const uint32_t end = static_cast<uint32_t>(std::min<size_t>(m_SortOrder.size(), static_cast<size_t>(m_SortCursor) + maxMoves));
+            for (; m_SortCursor < end; m_SortCursor++)
+            {
+                // Everything before the cursor is in place, so the entity's component is always at or after it
+                const uint32_t index = m_Sparse[GetEntityIndex(m_SortOrder[m_SortCursor])];
+                if (index != m_SortCursor)
+                {
+                    SwapDense(index, m_SortCursor);
+                }
+            }
+
+            if (m_SortCursor < m_SortOrder.size())
+            {
+                return false;
+            }
+            CancelSort();
+            return true;
+        }
+
+        // Reorders the whole pool at once, see BeginSort()
+        template<typename KeyFunc>
+        void Sort(KeyFunc&& keyFunc)
+        {
+            BeginSort(std::forward<KeyFunc>(keyFunc));
+            ContinueSort(static_cast<uint32_t>(m_SortOrder.size()));
+        }
+
+        bool IsSorting() const override { return !m_SortOrder.empty(); }
+
+        // Copy constructs the sparse pages and every dense array, the clone reads no change versions until a scene adopts it
+        std::unique_ptr<IComponentPool> Clone() const override
+        {
+            std::unique_ptr<ComponentPool<T>> clone = std::make_unique<ComponentPool<T>>(*this);
+            clone->m_ChangeVersionSource = nullptr;
+            return clone;
+        }
+
+        void CancelSort()
+        {
+            m_SortOrder.clear();
+            m_SortOrder.shrink_to_fit();
+            m_SortCursor = 0;
+        }
+
+        // Contiguous access to live components, index i belongs to GetEntityIds()[i]
+        std::span<T> GetComponents() { return m_Dense; }
+        std::span<const uint32_t> GetEntityIds() const override { return m_DenseEntities; }
+        const void* GetComponentData() const override { return m_Dense.data(); }
+        void* GetComponentMemory(uint32_t entityId) override { return GetComponent(entityId); }
+        std::span<const uint32_t> GetVersions() const { return m_Versions; }
+
+        auto begin() { return m_Dense.begin(); }
+        auto end() { return m_Dense.end(); }
+
+    private:
+
+        uint32_t GetCurrentVersion() const { return m_ChangeVersionSource ? m_ChangeVersionSource->load(std::memory_order_relaxed) : 1; }
+
+        // Stamps the pages of dense elements [begin, end) after a structural change
+        void StampPages(uint32_t begin, uint32_t end)
+        {
+            if (begin == end)
+            {
+                return;
+            }
+
+            const uint32_t lastPage = (end - 1) / ChangePageSize;
+            if (lastPage >= m_PageVersions.size())
+            {
+                m_PageVersions.resize(lastPage + 1, 0);
+            }
+            std::fill(m_PageVersions.begin() + begin / ChangePageSize, m_PageVersions.begin() + lastPage + 1, GetCurrentVersion());
+        }
+
+        // Systems mark components changed in parallel, so the page is stamped atomically and only written when its version differs
+        void StampChanged(uint32_t index)
+        {
+            std::atomic_ref<uint32_t> pageVersion(m_PageVersions[index / ChangePageSize]);
+            const uint32_t version = GetCurrentVersion();
+            if (pageVersion.load(std::memory_order_relaxed) != version)
+            {
+                pageVersion.store(version, std::memory_order_relaxed);
+            }
+        }
+
+        void SwapDense(uint32_t a, uint32_t b)
+        {
+            StampPages(a, a + 1);
+            StampPages(b, b + 1);
+            std::swap(m_Dense[a], m_Dense[b]);
+            std::swap(m_DenseEntities[a], m_DenseEntities[b]);
+            std::swap(m_Versions[a], m_Versions[b]);
+            m_Sparse[GetEntityIndex(m_DenseEntities[a])] = a;
+            m_Sparse[GetEntityIndex(m_DenseEntities[b])] = b;
+        }
+
+        // Paged so a pool only pays for the index ranges its entities actually live in
+        PagedArray<uint32_t> m_Sparse{ InvalidIndex };
+        std::vector<uint32_t> m_DenseEntities;
+        std::vector<uint32_t> m_Versions;
+        std::vector<uint32_t> m_PageVersions;
+        std::vector<T> m_Dense;
+        const std::atomic<uint32_t>* m_ChangeVersionSource = nullptr;
+        // Entity IDs in sorted order and how many of them are already in place, empty when no sort is in progress
+        std::vector<uint32_t> m_SortOrder;
+        uint32_t m_SortCursor = 0;
+    };
+}
@@ -0,0 +1,80 @@
+// Copyright Levi Spevakow (C) 2025
+
+#pragma once
+
+#include "Core.h"
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+namespace Tempus
+{
+    // Types whose objects can be moved to a new address with a plain memcpy, leaving nothing to destroy at the old one.
+    // Trivially copyable types qualify automatically, specialize for types that are safe to relocate bytewise
+    // without being trivially copyable.
+    template<typename T>
+    struct IsTriviallyRelocatable : std::bool_constant<std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>> {};
+
+    template<typename T>
+    inline constexpr bool IsTriviallyRelocatableV = IsTriviallyRelocatable<T>::value;
+
+    // Type-erased lifetime operations for a component type living in raw memory.
+    // Every operation works on a contiguous range of count components so bulk copies, moves and teardown
+    // cost one indirect call per range instead of one per component.
+    struct ComponentTypeOps
+    {
+        size_t size = 0;
+        size_t alignment = 0;
+        // Default constructs count components at dst, the destination memory must be unconstructed
+        void (*defaultConstruct)(void* dst, uint32_t count) = nullptr;
+        // Constructs count components at dst, the destination memory must be unconstructed
+        void (*copyConstruct)(void* dst, const void* src, uint32_t count) = nullptr;
+        // Constructs count components at dst, the source components are left moved-from but still alive
+        void (*moveConstruct)(void* dst, void* src, uint32_t count) = nullptr;
+        void (*destroy)(void* ptr, uint32_t count) = nullptr;
+        // Move constructs at dst and destroys the source, a single memmove for trivially relocatable types
+        void (*relocate)(void* dst, void* src, uint32_t count) = nullptr;
+        // Whole ranges of the type can be copied and snapshotted bytewise
+        bool bTriviallyCopyable = false;
+
+        constexpr bool IsValid() const { return size != 0; }
+
+        template<ValidComponent T>
+        static constexpr ComponentTypeOps Create()
+        {
+            ComponentTypeOps ops;
+            ops.size = sizeof(T);
+            ops.alignment = alignof(T);
+            ops.bTriviallyCopyable = std::is_trivially_copyable_v<T>;
+            ops.defaultConstruct = [](void* dst, uint32_t count) { std::uninitialized_value_construct_n(static_cast<T*>(dst), count); };
+            ops.destroy = [](void* ptr, uint32_t count) { std::destroy_n(static_cast<T*>(ptr), count); };
+
+            // A type specialized as relocatable can still have copy and move constructors that must run
+            if constexpr (std::is_trivially_copyable_v<T>)
+            {
+                ops.copyConstruct = [](void* dst, const void* src, uint32_t count) { std::memcpy(dst, src, sizeof(T) * count); };
+                ops.moveConstruct = [](void* dst, void* src, uint32_t count) { std::memcpy(dst, src, sizeof(T) * count); };
+            }
+            else
+            {
+                ops.copyConstruct = [](void* dst, const void* src, uint32_t count) { std::uninitialized_copy_n(static_cast<const T*>(src), count, static_cast<T*>(dst)); };
+                ops.moveConstruct = [](void* dst, void* src, uint32_t count) { std::uninitialized_move_n(static_cast<T*>(src), count, static_cast<T*>(dst)); };
+            }
+
+            if constexpr (IsTriviallyRelocatableV<T>)
+            {
+                ops.relocate = [](void* dst, void* src, uint32_t count) { std::memmove(dst, src, sizeof(T) * count); };
+            }
+            else
+            {
+                ops.relocate = [](void* dst, void* src, uint32_t count)
+                {
+                    std::uninitialized_move_n(static_cast<T*>(src), count, static_cast<T*>(dst));
+                    std::destroy_n(static_cast<T*>(src), count);
+                };
+            }
+            return ops;
+        }
+    };
+}
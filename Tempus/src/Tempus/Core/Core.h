@@ -31,6 +31,7 @@
 // Core includes
 #include <cstdint>
 #include <concepts>
+#include <type_traits>
 #include "Log.h"
 #include "CoreGlobals.h"
 
@@ -79,11 +80,18 @@
 #define TPS_CALL_ONCE(Func, ...) static int32_t ANONYMOUS_VARIABLE(UniqueOnce) = ((Func)(__VA_ARGS__), 1)
 
 // Global constants
-// Max entities per scene
-constexpr uint32_t MAX_ENTITIES = 5000;
 // Max components per entity
 constexpr uint8_t MAX_COMPONENTS = 32;
 
+// Entity IDs are generational handles.
+// The low bits index the entity's slot in scene storage, the high bits hold the slot's generation.
+// A slot's generation is bumped when its entity is removed, so stale IDs never alias a newer entity.
+// Scenes grow on demand, the index bits are the only limit on live entities per scene (~1M).
+constexpr uint32_t ENTITY_INDEX_BITS = 20;
+constexpr uint32_t ENTITY_INDEX_MASK = (1u << ENTITY_INDEX_BITS) - 1;
+constexpr uint32_t ENTITY_GENERATION_MASK = (1u << (32 - ENTITY_INDEX_BITS)) - 1;
+constexpr uint32_t INVALID_ENTITY_ID = 0xFFFFFFFF;
+
 namespace Tempus
 {
     using ComponentId = uint8_t;
@@ -94,5 +102,22 @@ namespace Tempus
     // Constraint #2: Must implement valid ID using 'DECLARE_COMPONENT(ComponentName, ID)'
     template<typename T>
     concept ValidComponent = std::derived_from<T, Component> && requires {{T::GetId()} -> std::convertible_to<ComponentId>;};
+
+    // Components without any data, such as markers. A tag is stored only as a bit in its entity's signature,
+    // no pool or archetype column is created for it, so adding or removing one is a bit flip.
+    template<typename T>
+    concept TagComponent = ValidComponent<T> && std::is_empty_v<T>;
+
+    // Tags hold no per entity data, every entity with a tag hands out this same instance
+    template<TagComponent T>
+    T& GetTagInstance()
+    {
+        static T instance;
+        return instance;
+    }
+
+    constexpr uint32_t MakeEntityId(uint32_t index, uint32_t generation) { return ((generation & ENTITY_GENERATION_MASK) << ENTITY_INDEX_BITS) | (index & ENTITY_INDEX_MASK); }
+    constexpr uint32_t GetEntityIndex(uint32_t entityId) { return entityId & ENTITY_INDEX_MASK; }
+    constexpr uint32_t GetEntityGeneration(uint32_t entityId) { return entityId >> ENTITY_INDEX_BITS; }
 }
 
@@ -0,0 +1,51 @@
+// Copyright Levi Spevakow (C) 2025
+
+#include "NameTable.h"
+
+#include <algorithm>
+#include <cstring>
+
+Tempus::NameId Tempus::NameTable::Intern(std::string_view str)
+{
+    if (auto it = m_Index.find(str); it != m_Index.end())
+    {
+        return it->second;
+    }
+
+    // Blocks are only ever appended to, so earlier strings never move
+    const size_t size = str.size() + 1;
+    if (m_ArenaBlocks.empty() || m_ArenaBlocks.back().size - m_ArenaBlocks.back().used < size)
+    {
+        ArenaBlock block;
+        block.size = std::max(ArenaBlockSize, size);
+        block.data = std::make_unique<char[]>(block.size);
+        m_ArenaBlocks.push_back(std::move(block));
+    }
+
+    ArenaBlock& block = m_ArenaBlocks.back();
+    char* stored = block.data.get() + block.used;
+    std::memcpy(stored, str.data(), str.size());
+    stored[str.size()] = '\0';
+    block.used += size;
+
+    const NameId id = static_cast<NameId>(m_Strings.size());
+    m_Strings.emplace_back(stored, str.size());
+    m_Index.emplace(m_Strings.back(), id);
+    return id;
+}
+
+Tempus::NameId Tempus::NameTable::Find(std::string_view str) const
+{
+    auto it = m_Index.find(str);
+    return it != m_Index.end() ? it->second : INVALID_NAME_ID;
+}
+
+size_t Tempus::NameTable::GetMemoryUsage() const
+{
+    size_t arenaBytes = 0;
+    for (const ArenaBlock& block : m_ArenaBlocks)
+    {
+        arenaBytes += block.size;
+    }
+    return arenaBytes + m_Strings.capacity() * sizeof(std::string_view) + m_Index.size() * (sizeof(std::string_view) + sizeof(NameId) + sizeof(void*));
+}
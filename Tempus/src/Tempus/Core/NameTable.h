@@ -0,0 +1,61 @@
+// Copyright Levi Spevakow (C) 2025
+
+#pragma once
+
+#include "Core.h"
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Tempus
+{
+    using NameId = uint32_t;
+    constexpr NameId INVALID_NAME_ID = std::numeric_limits<NameId>::max();
+
+    // Interned string storage. Every distinct string is stored once, null terminated, in arena blocks that never move,
+    // and is identified by a dense 32-bit ID handed out in interning order.
+    // Strings are kept until the table is destroyed, so views returned by GetString() stay valid for its lifetime.
+    class TEMPUS_API NameTable
+    {
+    public:
+
+        NameTable() = default;
+
+        NameTable(NameTable&&) noexcept = default;
+        NameTable& operator=(NameTable&&) noexcept = default;
+
+        // Returns the existing ID if the string was interned before
+        NameId Intern(std::string_view str);
+        // INVALID_NAME_ID if the string was never interned, never allocates
+        NameId Find(std::string_view str) const;
+
+        // The view's data is null terminated, an invalid ID returns an empty string
+        std::string_view GetString(NameId id) const { return id < m_Strings.size() ? m_Strings[id] : std::string_view(""); }
+        const char* GetCString(NameId id) const { return GetString(id).data(); }
+
+        uint32_t GetCount() const { return static_cast<uint32_t>(m_Strings.size()); }
+        size_t GetMemoryUsage() const;
+
+        NameTable(const NameTable&) = delete;
+        NameTable& operator=(const NameTable&) = delete;
+
+    private:
+
+        // Size of a single arena block, longer strings get a dedicated block
+        static constexpr size_t ArenaBlockSize = 16 * 1024;
+
+        struct ArenaBlock
+        {
+            std::unique_ptr<char[]> data;
+            size_t size = 0;
+            size_t used = 0;
+        };
+
+        std::vector<ArenaBlock> m_ArenaBlocks;
+        // Views into the arena, indexed by name ID
+        std::vector<std::string_view> m_Strings;
+        std::unordered_map<std::string_view, NameId> m_Index;
+    };
+}
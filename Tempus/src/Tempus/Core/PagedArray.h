@@ -0,0 +1,118 @@
+// Copyright Levi Spevakow (C) 2025
+
+#pragma once
+
+#include "Core.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace Tempus
+{
+    // Number of elements in a single page of entity indexed storage
+    constexpr uint32_t ENTITY_PAGE_SIZE = 4096;
+
+    // Array indexed by entity index that grows in fixed size pages on demand.
+    // Nothing is allocated up front, and a page is only allocated once an index inside it is first written,
+    // so storage for sparse high indices stays proportional to the pages actually touched.
+    // Growing never moves existing elements, references stay valid until Clear().
+    template<typename T, uint32_t PageSize = ENTITY_PAGE_SIZE>
+    class PagedArray
+    {
+        TPS_STATIC_ASSERT((PageSize & (PageSize - 1)) == 0, "PagedArray page size must be a power of two");
+
+    public:
+
+        // Newly allocated pages are filled with the default value
+        explicit PagedArray(const T& defaultValue = T{}) : m_DefaultValue(defaultValue) {}
+
+        PagedArray(PagedArray&&) noexcept = default;
+        PagedArray& operator=(PagedArray&&) noexcept = default;
+
+        // Deep copy, only the pages allocated in the other array are allocated
+        PagedArray(const PagedArray& other) : m_DefaultValue(other.m_DefaultValue)
+        {
+            CopyPages(other);
+        }
+
+        PagedArray& operator=(const PagedArray& other)
+        {
+            if (this != &other)
+            {
+                m_DefaultValue = other.m_DefaultValue;
+                CopyPages(other);
+            }
+            return *this;
+        }
+
+        // The page holding the index must already exist
+        T& operator[](uint32_t index) { return m_Pages[index / PageSize][index & PageMask]; }
+        const T& operator[](uint32_t index) const { return m_Pages[index / PageSize][index & PageMask]; }
+
+        // Allocates the page holding the index if needed
+        T& Ensure(uint32_t index)
+        {
+            const uint32_t page = index / PageSize;
+            if (page >= m_Pages.size())
+            {
+                m_Pages.resize(page + 1);
+            }
+            if (!m_Pages[page])
+            {
+                m_Pages[page] = std::make_unique<T[]>(PageSize);
+                std::fill_n(m_Pages[page].get(), PageSize, m_DefaultValue);
+                m_AllocatedPages++;
+            }
+            return m_Pages[page][index & PageMask];
+        }
+
+        // Returns nullptr if the page holding the index was never allocated
+        T* TryGet(uint32_t index)
+        {
+            const uint32_t page = index / PageSize;
+            return page < m_Pages.size() && m_Pages[page] ? &m_Pages[page][index & PageMask] : nullptr;
+        }
+
+        const T* TryGet(uint32_t index) const
+        {
+            const uint32_t page = index / PageSize;
+            return page < m_Pages.size() && m_Pages[page] ? &m_Pages[page][index & PageMask] : nullptr;
+        }
+
+        void Clear()
+        {
+            m_Pages.clear();
+            m_AllocatedPages = 0;
+        }
+
+        uint32_t GetAllocatedPageCount() const { return m_AllocatedPages; }
+
+        size_t GetMemoryUsage() const
+        {
+            return m_Pages.capacity() * sizeof(std::unique_ptr<T[]>) + static_cast<size_t>(m_AllocatedPages) * PageSize * sizeof(T);
+        }
+
+    private:
+
+        static constexpr uint32_t PageMask = PageSize - 1;
+
+        void CopyPages(const PagedArray& other)
+        {
+            m_Pages.clear();
+            m_Pages.resize(other.m_Pages.size());
+            for (size_t page = 0; page < other.m_Pages.size(); page++)
+            {
+                if (other.m_Pages[page])
+                {
+                    m_Pages[page] = std::make_unique_for_overwrite<T[]>(PageSize);
+                    std::copy_n(other.m_Pages[page].get(), PageSize, m_Pages[page].get());
+                }
+            }
+            m_AllocatedPages = other.m_AllocatedPages;
+        }
+
+        std::vector<std::unique_ptr<T[]>> m_Pages;
+        uint32_t m_AllocatedPages = 0;
+        T m_DefaultValue;
+    };
+}
@@ -0,0 +1,40 @@
+// Copyright Levi Spevakow (C) 2025
+
+#pragma once
+
+#include "Core.h"
+#include <string>
+#include <tuple>
+
+namespace Tempus
+{
+    // Named set of component prototypes, instantiated into a scene with Scene::Instantiate().
+    // Every instance receives a copy of each prototype, components referencing shared data such as
+    // StaticMeshComponent keep sharing the prefab's blocks until an instance overrides a field.
+    //
+    // Prefab<TransformComponent, StaticMeshComponent> grunt("Grunt", TransformComponent(), StaticMeshComponent("grunt.fbx", "grunt_diffuse.fbx"));
+    // scene->Instantiate(grunt, 1000);
+    template<ValidComponent... Ts>
+    class Prefab
+    {
+    public:
+
+        Prefab(std::string name, Ts... components) : m_Name(std::move(name)), m_Components(std::move(components)...) {}
+
+        const std::string& GetName() const { return m_Name; }
+
+        // Edits affect instances created afterwards, existing instances keep their copies
+        template<ValidComponent T>
+        T& GetPrototype() { return std::get<T>(m_Components); }
+
+        template<ValidComponent T>
+        const T& GetPrototype() const { return std::get<T>(m_Components); }
+
+        const std::tuple<Ts...>& GetPrototypes() const { return m_Components; }
+
+    private:
+
+        std::string m_Name;
+        std::tuple<Ts...> m_Components;
+    };
+}
@@ -28,11 +28,18 @@
 
 #include "Application.h"
 #include "Scene.h"
+#include "SceneBenchmark.h"
+#include "SceneSerializer.h"
+#include "TransformKernelBenchmark.h"
+#include "WorldPartition.h"
 #include "Components/CameraComponent.h"
-#include "Components/EditorDataComponent.h"
+#include "Components/ComponentTypeTable.h"
+#include "Components/EditorTagComponents.h"
 #include "Components/LightComponent.h"
 #include "Components/StaticMeshComponent.h"
+#include "Components/HierarchyComponent.h"
 #include "Components/TransformComponent.h"
+#include "Components/WorldTransformComponent.h"
 #include "Managers/SceneManager.h"
 #include "Events/EventDispatcher.h"
 #include "stb_image/stb_image.h"
@@ -40,6 +47,8 @@
 #include "Entity/Entity.h"
 #include "Utils/Profiling.h"
 #include "Utils/Time.h"
+#include "Jobs/JobSystem.h"
+#include "Jobs/JobSystemBenchmark.h"
 
 #define NVIDIA_VENDOR_ID 0X10DE
 
@@ -160,7 +169,7 @@ void Tempus::Renderer::FocusEntity(uint32_t entityId)
 {
 	if(Scene* currentScene = SCENE_MANAGER->GetActiveScene())
 	{
-		if(entityId <= 0 || !currentScene->HasEntity(entityId))
+		if(entityId == 0 || !currentScene->HasEntity(entityId))
 		{
 			return;
 		}
@@ -168,10 +177,16 @@ void Tempus::Renderer::FocusEntity(uint32_t entityId)
 		if(TransformComponent* transComp = currentScene->GetComponent<TransformComponent>(entityId))
 		{
 			// Ensure editor cam exists
-			if(TransformComponent* editorCamTrans = currentScene->GetComponent<TransformComponent>(0))
+			if(TransformComponent* editorCamTrans = currentScene->GetMutableComponent<TransformComponent>(0))
 			{
+				// Cached world data is a frame behind at most, falling back to the transforms until it exists
+				const WorldTransformComponent* worldComp = currentScene->GetComponent<WorldTransformComponent>(entityId);
+				const WorldTransformComponent* editorCamWorld = currentScene->GetComponent<WorldTransformComponent>(0);
+				const glm::vec3 targetPosition = worldComp ? worldComp->GetPosition() : transComp->Position;
+				const glm::vec3 camForward = editorCamWorld ? editorCamWorld->Forward : editorCamTrans->GetForwardVector();
+
 				float maxScale = glm::max(glm::max(transComp->Scale.x, transComp->Scale.y), transComp->Scale.z);
-				editorCamTrans->Position = transComp->Position - (editorCamTrans->GetForwardVector() * (m_EntityFocusDistance * maxScale));
+				editorCamTrans->Position = targetPosition - (camForward * (m_EntityFocusDistance * maxScale));
 			}
 		}
 		else
@@ -300,6 +315,12 @@ void Tempus::Renderer::DrawFrame()
 	// Reset fence signal
 	vkResetFences(m_Device, 1, &m_InFlightFences[m_CurrentFrame]);
 
+	// Grow per object storage before anything is recorded against it
+	if (Scene* activeScene = SCENE_MANAGER->GetActiveScene())
+	{
+		EnsureObjectCapacity(activeScene->View<WorldTransformComponent, StaticMeshComponent>().GetSize());
+	}
+
 	vkResetCommandBuffer(m_CommandBuffers[m_CurrentFrame], 0);
 
 	RecordCommandBuffer(m_CommandBuffers[m_CurrentFrame], imageIndex);
@@ -364,7 +385,9 @@ void Tempus::Renderer::UpdateUniformBuffer(uint32_t currentImage)
 
 	CameraComponent camComponent = CameraComponent();
 	TransformComponent camTransform = TransformComponent();
+	glm::vec3 camPosition = camTransform.Position;
 	glm::vec3 camForward = glm::vec3(1.0f, 0.0f, 0.0f);
+	bool bHasCamWorld = false;
 
 	if (activeScene->HasEntity(m_ActiveCamEntityId))
 	{
@@ -376,18 +399,29 @@ void Tempus::Renderer::UpdateUniformBuffer(uint32_t currentImage)
 		{
 			camTransform = *transComp;
 		}
+		// Cached by the transform system, so the basis isn't recomputed every frame the camera stands still
+		if (WorldTransformComponent* worldComp = activeScene->GetComponent<WorldTransformComponent>(m_ActiveCamEntityId))
+		{
+			camPosition = worldComp->GetPosition();
+			camForward = worldComp->Forward;
+			bHasCamWorld = true;
+		}
 	}
 	
-	if (camTransform.Rotation.y > 360.0f || camTransform.Rotation.y < -360.0f)
+	if (!bHasCamWorld)
 	{
-		camTransform.Rotation.y = 0.0f;
+		if (camTransform.Rotation.y > 360.0f || camTransform.Rotation.y < -360.0f)
+		{
+			camTransform.Rotation.y = 0.0f;
+		}
+		camPosition = camTransform.Position;
+		camForward = camTransform.GetForwardVector();
 	}
-	camForward = camTransform.GetForwardVector();
 	
 	GlobalUBO globalUbo{};
 	glm::mat4 view;
 	glm::mat4 proj;
-	view = glm::lookAtLH(camTransform.Position, camTransform.Position + camForward, glm::vec3(0.0f, 0.0f, 1.0f));
+	view = glm::lookAtLH(camPosition, camPosition + camForward, glm::vec3(0.0f, 0.0f, 1.0f));
 	
 	switch (camComponent.ProjectionType)
 	{
@@ -432,31 +466,31 @@ void Tempus::Renderer::UpdateUniformBuffer(uint32_t currentImage)
 	std::memcpy(m_GlobalUniformBuffersMapped[currentImage], &globalUbo, sizeof(globalUbo));
 
 	// Update per instance model UBOs
-	// @TODO In the future I will implement a way to iterate over only the entities that have specific component signatures
-	std::vector<uint32_t> entityIds = activeScene->GetEntityIDs();
-	uint32_t objectIndex = 0;
+	// Iteration order must match RecordCommandBuffer so object indices line up
+	auto meshView = activeScene->View<WorldTransformComponent, StaticMeshComponent>();
 
-	for (uint32_t entityId : entityIds)
-	{
-		StaticMeshComponent* meshComp = activeScene->GetComponent<StaticMeshComponent>(entityId);
-		TransformComponent* transComp = activeScene->GetComponent<TransformComponent>(entityId);
+	// The object buffer persists between frames, so only world matrices changed since the last upload need rewriting.
+	// Everything is rewritten when the object order may have changed, or the buffer was reallocated.
+	const bool bFullUpload = m_bObjectBufferReset || m_UploadedSceneSerial != activeScene->GetSceneSerial() || m_UploadedViewStructureVersion != meshView.GetStructureVersion();
+	const uint32_t sinceVersion = bFullUpload ? 0 : m_UploadedChangeVersion;
 
-		if (!meshComp || !transComp || objectIndex >= m_MaxObjects)
+	m_bObjectBufferReset = false;
+	m_UploadedSceneSerial = activeScene->GetSceneSerial();
+	m_UploadedViewStructureVersion = meshView.GetStructureVersion();
+	m_UploadedChangeVersion = activeScene->AdvanceChangeVersion();
+
+	std::span<const uint32_t> entityIds = meshView.GetEntityIds();
+	const uint32_t objectCount = std::min(static_cast<uint32_t>(entityIds.size()), m_MaxObjects);
+	for (uint32_t objectIndex = 0; objectIndex < objectCount; objectIndex++)
+	{
+		const uint32_t entityId = entityIds[objectIndex];
+		if (meshView.GetVersion<WorldTransformComponent>(entityId) <= sinceVersion)
 		{
 			continue;
 		}
 
-		glm::mat4 model = glm::mat4(1.0f);
-		model = glm::translate(model, transComp->Position);
-		model = glm::rotate(model, glm::radians(transComp->Rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
-		model = glm::rotate(model, glm::radians(transComp->Rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
-		model = glm::rotate(model, glm::radians(transComp->Rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
-		model = glm::scale(model, transComp->Scale);
-
 		ObjectUBO* objectUbo = (ObjectUBO*)((uint64_t)m_DynamicUniformBufferMapped + (objectIndex * m_DynamicAlignment));
-		objectUbo->model = model;
-
-		objectIndex++;
+		objectUbo->model = meshView.Get<WorldTransformComponent>(entityId).World;
 	}
 	
 }
@@ -473,6 +507,7 @@ void Tempus::Renderer::DrawImGui()
 	static bool bShowDemoWindow = false;
 	static bool bShowDebugWindow = false;
 	static bool bShowShaderReloadWindow = true;
+	static bool bSceneLoadPending = false;
 
 	ImGui_ImplVulkan_NewFrame();
 	ImGui_ImplSDL3_NewFrame();
@@ -480,14 +515,64 @@ void Tempus::Renderer::DrawImGui()
 
 	//ImGui::ShowStyleEditor();
 
+	// The selection belongs to the scene the finished load replaced
+	if (bSceneLoadPending && !SCENE_MANAGER->IsLoadingScene())
+	{
+		m_SelectedEntityId = INVALID_ENTITY_ID;
+		bSceneLoadPending = false;
+	}
+
+	// -- Undo shortcuts, left to text fields while one is being typed into
+	if (!ImGui::GetIO().WantTextInput)
+	{
+		if (ImGui::IsKeyChordPressed(ImGuiMod_Ctrl | ImGuiKey_Z))
+		{
+			SCENE_MANAGER->Undo();
+		}
+		else if (ImGui::IsKeyChordPressed(ImGuiMod_Ctrl | ImGuiMod_Shift | ImGuiKey_Z))
+		{
+			SCENE_MANAGER->Redo();
+		}
+	}
+
 	// -- Main menu bar
 	if (ImGui::BeginMainMenuBar()) 
 	{
 		if (ImGui::BeginMenu("File")) 
 		{
 			if (ImGui::MenuItem("New"))  {  }
-			if (ImGui::MenuItem("Open")) {  }
-			if (ImGui::MenuItem("Save")) {  }
+			if (ImGui::BeginMenu("Open"))
+			{
+				// Every scene file in the scenes directory, loaded in the background while the current scene keeps rendering
+				const bool bLoading = SCENE_MANAGER->IsLoadingScene();
+				std::error_code error;
+				bool bFoundScene = false;
+				for (const auto& entry : std::filesystem::directory_iterator(FileUtils::ScenesDir(), error))
+				{
+					if (entry.path().extension() != SceneSerializer::FileExtension)
+					{
+						continue;
+					}
+
+					bFoundScene = true;
+					if (ImGui::MenuItem(entry.path().stem().string().c_str(), nullptr, false, !bLoading) && SCENE_MANAGER->LoadSceneAsync(entry.path()))
+					{
+						bSceneLoadPending = true;
+					}
+				}
+				if (!bFoundScene)
+				{
+					ImGui::TextDisabled("No saved scenes");
+				}
+				ImGui::EndMenu();
+			}
+			if (ImGui::MenuItem("Save"))
+			{
+				if (Scene* activeScene = SCENE_MANAGER->GetActiveScene())
+				{
+					SCENE_MANAGER->SaveActiveScene(FileUtils::ScenesDir() / (activeScene->GetName() + SceneSerializer::FileExtension));
+				}
+			}
 			if (ImGui::MenuItem("Open Logs"))
 			{
 				FileUtils::OpenDirectory(FileUtils::LogsDir().string());
@@ -498,8 +583,9 @@ void Tempus::Renderer::DrawImGui()
 
 		if (ImGui::BeginMenu("Edit")) 
 		{
-			if (ImGui::MenuItem("Undo")) {  }
-			if (ImGui::MenuItem("Redo")) { }
+			const bool bPlaying = SCENE_MANAGER->IsPlaying();
+			if (ImGui::MenuItem("Undo", "Ctrl+Z", false, !bPlaying && SCENE_MANAGER->GetHistory().CanUndo())) { SCENE_MANAGER->Undo(); }
+			if (ImGui::MenuItem("Redo", "Ctrl+Shift+Z", false, !bPlaying && SCENE_MANAGER->GetHistory().CanRedo())) { SCENE_MANAGER->Redo(); }
 			ImGui::EndMenu();
 		}
 
@@ -535,6 +621,21 @@ void Tempus::Renderer::DrawImGui()
 			ImGui::EndMenu();
 		}
 
+		// Plays a copy of the scene, stopping swaps the edited scene back in
+		if (SCENE_MANAGER->IsPlaying())
+		{
+			if (ImGui::MenuItem("Stop")) { SCENE_MANAGER->EndPlay(); }
+		}
+		else if (ImGui::MenuItem("Play"))
+		{
+			SCENE_MANAGER->BeginPlay();
+		}
+
+		if (SCENE_MANAGER->IsLoadingScene())
+		{
+			ImGui::TextDisabled("Loading %s...", SCENE_MANAGER->GetLoadingScenePath().stem().string().c_str());
+		}
+
 		//ImGui::Separator();
 		//ImGui::Text("Current Scene: %s", SCENE_MANAGER->GetActiveScene() ? SCENE_MANAGER->GetActiveScene()->GetName().c_str() : "None");
 		
@@ -581,6 +682,7 @@ void Tempus::Renderer::DrawImGui()
 			ImGui::Text("Swapchain extent: %ux%u", m_SwapChainExtent.width, m_SwapChainExtent.height);
 			ImGui::Text("Delta Time: %f", Time::GetUnscaledDeltaTime());
 			ImGui::Text("Time: %f", Time::GetAppTime());
+			ImGui::Text("Job Workers: %u", JOB_SYSTEM->GetWorkerCount());
 			static constexpr int frameTimeCount = 64;
 			static float frameTimes[frameTimeCount] = { 0.0f };
 			static int values_offset = 0;
@@ -639,7 +741,7 @@ void Tempus::Renderer::DrawImGui()
 		{
 			DrawAllEntityNames(currentScene);
 		}
-		if (m_bShowSelectedEntity && m_SelectedEntityId >= 1)
+		if (m_bShowSelectedEntity && m_SelectedEntityId != INVALID_ENTITY_ID && m_SelectedEntityId != 0)
 		{
 			DrawEntityName(currentScene, m_SelectedEntityId, IM_COL32(252, 186, 3, 255));
 		}
@@ -660,6 +762,11 @@ void Tempus::Renderer::DrawImGui()
 				SCENE_MANAGER->CreateScene("Debug Scene");
 			}
 			ImGui::SameLine();
+			if (ImGui::Button("Archetype Scene"))
+			{
+				SCENE_MANAGER->CreateScene("Debug Archetype Scene", SceneStorageMode::Archetypes);
+			}
+			ImGui::SameLine();
 			if(ImGui::Button("Focus Selected Entity"))
 			{
 				FocusEntity(m_SelectedEntityId);
@@ -687,6 +794,216 @@ void Tempus::Renderer::DrawImGui()
 				std::this_thread::sleep_for(std::chrono::duration<float, std::milli>(lagMs));
 			}
 		
+			ImGui::Separator();
+			static std::vector<JobSystemBenchmark::Result> jobBenchmarkResults;
+			if (ImGui::Button("Run Job Benchmark"))
+			{
+				jobBenchmarkResults = JobSystemBenchmark::Run();
+			}
+			for (const JobSystemBenchmark::Result& result : jobBenchmarkResults)
+			{
+				ImGui::Text("Workers: %u | %.1f ns/job | ParallelFor: %.3f ms (%.2fx)", result.workerCount, result.nsPerJob, result.parallelForMs, result.speedup);
+			}
+
+			static std::vector<SceneBenchmark::Result> sceneBenchmarkResults;
+			if (ImGui::Button("Run Scene Benchmark"))
+			{
+				sceneBenchmarkResults = SceneBenchmark::Run();
+			}
+			for (const SceneBenchmark::Result& result : sceneBenchmarkResults)
+			{
+				ImGui::Text("%s | %u entities | Create: %.2f ms (%.0f ns/entity) | Iterate: %.3f ms | Destroy: %.2f ms | %.2f MB",
+					GetStorageModeName(result.storageMode), result.entityCount,
+					result.createMs, result.nsPerEntity, result.iterateMs, result.destroyMs, static_cast<double>(result.componentMemoryBytes) / (1024.0 * 1024.0));
+			}
+
+			static std::vector<SceneBenchmark::ComponentPoolResult> componentPoolResults;
+			if (ImGui::Button("Run Component Pool Benchmark"))
+			{
+				componentPoolResults = SceneBenchmark::RunComponentPool();
+			}
+			for (const SceneBenchmark::ComponentPoolResult& result : componentPoolResults)
+			{
+				ImGui::Text("%u entities, %u components | Optional vs sparse | Add: %.3f / %.3f ms | Get: %.3f / %.3f ms | Iterate: %.3f / %.3f ms | Remove: %.3f / %.3f ms | %.1f / %.1f KB%s",
+					result.entityCount, result.componentCount, result.optionalAddMs, result.sparseAddMs, result.optionalGetMs, result.sparseGetMs,
+					result.optionalIterateMs, result.sparseIterateMs, result.optionalRemoveMs, result.sparseRemoveMs,
+					result.optionalMemoryBytes / 1024.0, result.sparseMemoryBytes / 1024.0, result.bPoolsMatch ? "" : " | Pools differ!");
+			}
+
+			static std::vector<SceneBenchmark::ChangeTrackingResult> changeTrackingResults;
+			if (ImGui::Button("Run Change Tracking Benchmark"))
+			{
+				changeTrackingResults = SceneBenchmark::RunChangeTracking();
+			}
+			for (const SceneBenchmark::ChangeTrackingResult& result : changeTrackingResults)
+			{
+				ImGui::Text("%s | %u entities, %u moving | Full: %.3f ms | Changed: %.3f ms (%.1fx)%s",
+					GetStorageModeName(result.storageMode), result.entityCount, result.movingCount,
+					result.fullRebuildMs, result.incrementalMs, result.speedup, result.bMatchesFullRebuild ? "" : " | Results differ!");
+			}
+
+			static std::vector<SceneBenchmark::WorldMatrixCacheResult> worldMatrixCacheResults;
+			if (ImGui::Button("Run World Matrix Cache Benchmark"))
+			{
+				worldMatrixCacheResults = SceneBenchmark::RunWorldMatrixCache();
+			}
+			for (const SceneBenchmark::WorldMatrixCacheResult& result : worldMatrixCacheResults)
+			{
+				ImGui::Text("%s | %u static entities | Recompute: %.3f ms | Cached: %.3f ms (%.1fx)%s",
+					GetStorageModeName(result.storageMode), result.entityCount,
+					result.recomputeMs, result.cachedMs, result.speedup, result.bMatchesRecompute ? "" : " | Results differ!");
+			}
+
+			static std::vector<TransformKernelBenchmark::Result> transformKernelResults;
+			if (ImGui::Button("Run Transform Kernel Benchmark"))
+			{
+				transformKernelResults = TransformKernelBenchmark::Run();
+			}
+			for (const TransformKernelBenchmark::Result& result : transformKernelResults)
+			{
+				ImGui::Text("%s | %u transforms | glm: %.3f ms | Kernel: %.3f ms (%.2f ns/matrix, %.2fx) | Max error: %.2e%s",
+					TransformKernels::GetLevelName(result.level), result.transformCount, result.glmMs, result.kernelMs, result.nsPerMatrix,
+					result.speedup, result.maxError, result.bWithinTolerance ? "" : " | Out of tolerance!");
+			}
+
+			static std::vector<SceneBenchmark::SpawnResult> spawnResults;
+			if (ImGui::Button("Run Spawn Benchmark"))
+			{
+				spawnResults = SceneBenchmark::RunSpawn();
+			}
+			for (const SceneBenchmark::SpawnResult& result : spawnResults)
+			{
+				ImGui::Text("%s | %u entities | Individual: %.2f ms | Batch: %.2f ms (%.1fM entities/s, %.1fx) | Despawn: %.2f ms%s",
+					GetStorageModeName(result.storageMode), result.entityCount,
+					result.individualSpawnMs, result.batchSpawnMs, result.entitiesPerSecond / 1'000'000.0, result.speedup,
+					result.batchDespawnMs, result.bMatchesIndividual ? "" : " | Results differ!");
+			}
+
+			static std::vector<SceneBenchmark::SortResult> sortResults;
+			if (ImGui::Button("Run Sort Benchmark"))
+			{
+				sortResults = SceneBenchmark::RunSort();
+			}
+			for (const SceneBenchmark::SortResult& result : sortResults)
+			{
+				ImGui::Text("%s | %u entities | Churned: %.3f ms | Sorted: %.3f ms (%.2fx) | Sort: %.2f ms | Mesh switches: %u -> %u | Incremental: %u updates, max %.3f ms%s",
+					GetStorageModeName(result.storageMode), result.entityCount,
+					result.churnedIterateMs, result.sortedIterateMs, result.speedup, result.sortMs, result.churnedMeshSwitches, result.sortedMeshSwitches,
+					result.incrementalUpdates, result.incrementalMaxUpdateMs, result.bSortedCorrectly ? "" : " | Sort failed!");
+			}
+
+			static std::vector<SceneBenchmark::SerializeResult> serializeResults;
+			if (ImGui::Button("Run Serialize Benchmark"))
+			{
+				serializeResults = SceneBenchmark::RunSerialize();
+			}
+			for (const SceneBenchmark::SerializeResult& result : serializeResults)
+			{
+				ImGui::Text("%s | %u entities | Save: %.2f ms | Load: %.2f ms | World transforms: %.2f ms | File: %.1f MB%s",
+					GetStorageModeName(result.storageMode), result.entityCount,
+					result.saveMs, result.loadMs, result.derivedDataMs, result.fileBytes / (1024.0 * 1024.0), result.bMatchesSaved ? "" : " | Scenes differ!");
+			}
+
+			static std::vector<SceneBenchmark::UndoResult> undoResults;
+			if (ImGui::Button("Run Undo Benchmark"))
+			{
+				undoResults = SceneBenchmark::RunUndo();
+			}
+			for (const SceneBenchmark::UndoResult& result : undoResults)
+			{
+				ImGui::Text("%s | %u entities | First step: %.2f ms, %.1f MB | Per edit: %.3f ms, %.1f KB | Undo: %.2f ms | Retained: %.1f MB%s",
+					GetStorageModeName(result.storageMode), result.entityCount,
+					result.baselineMs, result.baselineBytes / (1024.0 * 1024.0), result.editMs, result.editBytes / 1024.0,
+					result.undoMs, result.retainedBytes / (1024.0 * 1024.0), result.bUndoMatches ? "" : " | Scenes differ!");
+			}
+
+			static std::vector<SceneBenchmark::CloneResult> cloneResults;
+			if (ImGui::Button("Run Clone Benchmark"))
+			{
+				cloneResults = SceneBenchmark::RunClone();
+			}
+			for (const SceneBenchmark::CloneResult& result : cloneResults)
+			{
+				ImGui::Text("%s | %u entities | Clone: %.2f ms | Per entity copy: %.2f ms (%.1fx) | First update: %.2f ms | Restore: %.3f ms%s",
+					GetStorageModeName(result.storageMode), result.entityCount,
+					result.cloneMs, result.perEntityCopyMs, result.speedup, result.firstUpdateMs, result.restoreMs, result.bCloneMatches ? "" : " | Scenes differ!");
+			}
+
+			static std::vector<SceneBenchmark::AsyncLoadResult> asyncLoadResults;
+			if (ImGui::Button("Run Async Load Benchmark"))
+			{
+				asyncLoadResults = SceneBenchmark::RunAsyncLoad();
+			}
+			for (const SceneBenchmark::AsyncLoadResult& result : asyncLoadResults)
+			{
+				ImGui::Text("%s | %u entities | Sync load hitch: %.2f ms | Async: %u frames, avg %.2f ms, max %.2f ms | Swap frame: %.2f ms | Load: %.2f ms%s",
+					GetStorageModeName(result.storageMode), result.entityCount,
+					result.syncHitchMs, result.loadingFrameCount, result.loadingFrameAvgMs, result.loadingFrameMaxMs, result.swapFrameMs, result.loadMs,
+					result.bLoadMatches ? "" : " | Scenes differ!");
+			}
+
+			static std::vector<SceneBenchmark::WorldStreamingResult> worldStreamingResults;
+			if (ImGui::Button("Run World Streaming Benchmark"))
+			{
+				worldStreamingResults = SceneBenchmark::RunWorldStreaming();
+			}
+			for (const SceneBenchmark::WorldStreamingResult& result : worldStreamingResults)
+			{
+				ImGui::Text("%s | %u entities in %u cells | Resident world frame: %.2f ms | Streaming frames: avg %.2f ms, max %.2f ms | Update max: %.2f ms | Peak: %u cells, %.1f MB/s | Thrash: %u (%u without hysteresis)%s",
+					GetStorageModeName(result.storageMode), result.entityCount, result.cellCount,
+					result.residentWorldFrameMs, result.frameAvgMs, result.frameMaxMs, result.streamingMaxMs, result.peakResidentCells, result.peakBandwidthMBps,
+					result.thrashCount, result.thrashCountWithoutHysteresis, result.bStreamingMatches ? "" : " | Cells differ!");
+			}
+
+			// Groups draws by mesh over the next few frames
+			if (ImGui::Button("Sort Meshes"))
+			{
+				if (Scene* activeScene = SCENE_MANAGER->GetActiveScene())
+				{
+					activeScene->SortPoolIncremental<StaticMeshComponent>([](const StaticMeshComponent& mesh) { return mesh.GetMesh().GetHandle(); }, 10'000);
+				}
+			}
+
+			// Moves the active scene's world into cells streamed around the active camera
+			ImGui::Separator();
+			static float worldCellSize = 1000.0f;
+			ImGui::PushItemWidth(150.0f);
+			ImGui::InputFloat("Cell Size", &worldCellSize, 100.0f, 1000.0f, "%.0f");
+			ImGui::PopItemWidth();
+			worldCellSize = std::max(worldCellSize, 1.0f);
+			ImGui::SameLine();
+			Scene* partitionScene = SCENE_MANAGER->GetActiveScene();
+			ImGui::BeginDisabled(!partitionScene || SCENE_MANAGER->IsPlaying() || SCENE_MANAGER->GetWorldPartition());
+			if (ImGui::Button("Partition Active Scene"))
+			{
+				const std::filesystem::path cellsDirectory = FileUtils::ScenesDir() / (partitionScene->GetName() + " Cells");
+				std::vector<uint32_t> partitionedIds;
+				if (WorldPartition::BuildCells(*partitionScene, cellsDirectory, worldCellSize, partitionedIds))
+				{
+					// The world now lives in the cell files, undoing back past this would duplicate it with the streamed cells
+					partitionScene->DespawnBatch(partitionedIds);
+					SCENE_MANAGER->GetHistory().Clear();
+					SCENE_MANAGER->OpenWorldPartition(cellsDirectory);
+				}
+			}
+			ImGui::EndDisabled();
+			if (const WorldPartition* partition = SCENE_MANAGER->GetWorldPartition())
+			{
+				ImGui::SameLine();
+				if (ImGui::Button("Close World Partition"))
+				{
+					SCENE_MANAGER->CloseWorldPartition();
+				}
+				else
+				{
+					const WorldPartition::Stats& stats = partition->GetStats();
+					ImGui::Text("Cells: %u resident, %u loading, %u unloading of %u | Entities: %u", stats.residentCells, stats.loadingCells, stats.unloadingCells,
+						stats.cellCount, stats.residentEntities);
+					ImGui::Text("Streamed: %.1f MB, %.2f MB/s | Last cell load: %.2f ms | Update: %.2f ms, max %.2f ms", stats.bytesLoaded / (1024.0 * 1024.0),
+						stats.bandwidthBytesPerSecond / (1024.0 * 1024.0), stats.lastCellLoadMs, stats.lastUpdateMs, stats.maxUpdateMs);
+				}
+			}
+
 			ImGui::Separator();
 			ImGui::Text("X: %.4u Y: %.4u", GApp->GetMouseX(), GApp->GetMouseY());
 			ImGui::Text("Delta X: %.2i Delta Y: %.2i", GApp->GetMouseDeltaX(),GApp->GetMouseDeltaY());
@@ -698,6 +1015,17 @@ void Tempus::Renderer::DrawImGui()
 	ImVec2 outScreen;
 	WorldToScreen(m_LastGlobalUbo.lightPos, outScreen);
 	dl->AddCircleFilled(outScreen, 5.0f, IM_COL32(255, 255, 0, 255), 12);
+
+	// An undo step is recorded once an edit is committed, or when any widget is released in case it changed the scene.
+	// Nothing is recorded while a widget is still held, and releases that didn't change the scene record nothing.
+	// A new scene gets its first step straight away.
+	const bool bEditing = ImGui::IsAnyItemActive();
+	if (!bEditing && (m_bWasEditing || m_bSceneEditCommitted || SCENE_MANAGER->GetHistory().GetStepCount() == 0))
+	{
+		SCENE_MANAGER->RecordUndoStep();
+	}
+	m_bWasEditing = bEditing;
+	m_bSceneEditCommitted = false;
 	
 	ImGui::Render();
 }
@@ -717,6 +1045,11 @@ void Tempus::Renderer::DrawSceneWindow(Scene* currentScene)
 				DrawSceneInfoTab(currentScene);
 				ImGui::EndTabItem();
 			}
+			if (ImGui::BeginTabItem("Systems"))
+			{
+				DrawSceneSystemsTab(currentScene);
+				ImGui::EndTabItem();
+			}
 			ImGui::EndTabBar();
 		}
 	ImGui::End();
@@ -774,6 +1107,42 @@ void Tempus::Renderer::DrawProfilerDataWindow(Scene* currentScene)
 		{
 			Profiling::ResetSlowestTimes();
 		}
+
+		// -- Undo history, what each recorded editor operation cost
+		ImGui::SeparatorText("Undo History");
+		SceneHistory& history = SCENE_MANAGER->GetHistory();
+		int budgetMb = static_cast<int>(history.GetMemoryBudget() / (1024 * 1024));
+		if (ImGui::SliderInt("Memory Budget (MB)", &budgetMb, 16, 4096))
+		{
+			history.SetMemoryBudget(static_cast<size_t>(budgetMb) * 1024 * 1024);
+		}
+		ImGui::Text("Steps: %u | Retained: %.2f MB", history.GetStepCount(), static_cast<double>(history.GetRetainedBytes()) / (1024.0 * 1024.0));
+
+		if (history.GetStepCount() > 0 && ImGui::BeginTable("UndoHistoryTable", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY, ImVec2(0.0f, 150.0f)))
+		{
+			ImGui::TableSetupColumn("Step", ImGuiTableColumnFlags_WidthFixed, 50.0f);
+			ImGui::TableSetupColumn("Snapshot (ms)", ImGuiTableColumnFlags_WidthFixed, 100.0f);
+			ImGui::TableSetupColumn("Pages (new / shared)", ImGuiTableColumnFlags_WidthStretch);
+			ImGui::TableSetupColumn("Retained (KB)", ImGuiTableColumnFlags_WidthFixed, 100.0f);
+			ImGui::TableSetupScrollFreeze(0, 1);
+			ImGui::TableHeadersRow();
+
+			// Newest first
+			for (uint32_t step = history.GetStepCount(); step-- > 0;)
+			{
+				const SceneHistory::StepStats& stats = history.GetStepStats(step);
+				ImGui::TableNextRow();
+				ImGui::TableSetColumnIndex(0);
+				ImGui::Text(step == history.GetCurrentStep() ? "> %u" : "%u", step);
+				ImGui::TableSetColumnIndex(1);
+				ImGui::Text("%.3f", stats.captureMs);
+				ImGui::TableSetColumnIndex(2);
+				ImGui::Text("%u / %u", stats.newPages, stats.sharedPages);
+				ImGui::TableSetColumnIndex(3);
+				ImGui::Text("%.1f", static_cast<double>(stats.retainedBytes) / 1024.0);
+			}
+			ImGui::EndTable();
+		}
 	
 	ImGui::End();
 }
@@ -781,7 +1150,8 @@ void Tempus::Renderer::DrawProfilerDataWindow(Scene* currentScene)
 void Tempus::Renderer::DrawAllEntityNames(Scene* currentScene)
 {
 	TPS_SCOPED_TIMER();
-	for (uint32_t entityId : currentScene->GetEntityIDs())
+	// Draw order doesn't matter, so the view's packed list is used as is
+	for (uint32_t entityId : currentScene->View<TransformComponent>().GetEntityIds())
 	{
 		if ((entityId == m_SelectedEntityId && m_bShowSelectedEntity) || entityId == 0)
 		{
@@ -789,10 +1159,7 @@ void Tempus::Renderer::DrawAllEntityNames(Scene* currentScene)
 			continue;
 		}
 		
-		if (currentScene->HasComponent<TransformComponent>(entityId))
-		{
-			DrawEntityName(currentScene, entityId, IM_COL32(255, 255, 255, 255));
-		}
+		DrawEntityName(currentScene, entityId, IM_COL32(255, 255, 255, 255));
 	}
 }
 
@@ -803,13 +1170,14 @@ void Tempus::Renderer::DrawEntityName(Scene* currentScene, uint32_t entId, ImU32
 	{
 		ImGui::PushFont(m_LargeFont);
 		ImVec2 spos;
-		glm::vec3 worldPos = transComp->Position;
+		const WorldTransformComponent* worldComp = currentScene->GetComponent<WorldTransformComponent>(entId);
+		glm::vec3 worldPos = worldComp ? worldComp->GetPosition() : transComp->Position;
         
 		if (WorldToScreen(worldPos, spos))
 		{
 			spos.x *= 0.95f;
-			std::string entityName = currentScene->GetEntityName(entId);
-			const char* text = entityName.c_str();
+			// Interned names are null terminated
+			const char* text = currentScene->GetEntityName(entId).data();
 
 			// @TODO Slow. Need to get a font with an outline built in
 			// Draw outline
@@ -908,24 +1276,33 @@ void Tempus::Renderer::DrawSceneOutlinerTab(Scene *currentScene)
     
 	ImGui::BeginChild("EntityList", ImVec2(0, 300), true);
 
-	std::vector<uint32_t> entIDs = currentScene->GetEntityIDs();
+	std::vector<uint32_t>& entIDs = m_OutlinerEntityIds;
+	currentScene->GetEntityIDs(entIDs);
 	// Check if the scene is empty
 	if (entIDs.empty())
 	{
-		m_SelectedEntityId = -1;
+		m_SelectedEntityId = INVALID_ENTITY_ID;
 		ImGui::EndChild();
 		return;
 	}
 
 	for (const uint32_t entID : entIDs)
 	{
-		std::string label = currentScene->GetEntityName(entID) + "##" + std::to_string(entID);
-		if (ImGui::Selectable(label.c_str(), selectedEntityID == entID))
+		if (currentScene->HasComponent<EditorHideInOutlinerTag>(entID))
+		{
+			continue;
+		}
+
+		// The ID disambiguates entities with the same name without building a label string
+		ImGui::PushID(static_cast<int>(entID));
+		const bool bSelected = ImGui::Selectable(currentScene->GetEntityName(entID).data(), selectedEntityID == entID);
+		ImGui::PopID();
+		if (bSelected)
 		{
 			selectedEntityID = entID;
 			
 			// If we are re-selecting the same entity, focus it
-			if (std::cmp_equal(selectedEntityID, m_SelectedEntityId))
+			if (selectedEntityID == m_SelectedEntityId)
 			{
 				FocusEntity(selectedEntityID);
 			}
@@ -941,7 +1318,7 @@ void Tempus::Renderer::DrawSceneOutlinerTab(Scene *currentScene)
 		return;
 	}
 
-	m_SelectedEntityId = static_cast<int>(selectedEntityID);
+	m_SelectedEntityId = selectedEntityID;
 
 	ImGui::Text("Entities: %u", currentScene->GetEntityCount());
 	
@@ -949,6 +1326,7 @@ void Tempus::Renderer::DrawSceneOutlinerTab(Scene *currentScene)
 	if(ImGui::Button("Add##entity"))
 	{
 		currentScene->AddEntity("Debug Entity");
+		m_bSceneEditCommitted = true;
 	}
 	ImGui::SameLine();
 	// Remove entity from scene
@@ -956,19 +1334,17 @@ void Tempus::Renderer::DrawSceneOutlinerTab(Scene *currentScene)
 	{
 		// Disallow entity removal if marked NoDelete
 		bool bCanDeleteEntity = true;
-		if (EditorDataComponent* editorData = currentScene->GetComponent<EditorDataComponent>(selectedEntityID))
+		if (currentScene->HasComponent<EditorNoDeleteTag>(selectedEntityID))
 		{
-			if (EnumCheckFlag(editorData->flags, EditorEntityDataFlags::NoDelete))
-			{
-				bCanDeleteEntity = false;
-				TPS_CORE_ERROR("Cannot remove entity [{}], it is marked as NoDelete!", selectedEntityID);
-			}
+			bCanDeleteEntity = false;
+			TPS_CORE_ERROR("Cannot remove entity [{}], it is marked as NoDelete!", selectedEntityID);
 		}
 
 		if (bCanDeleteEntity)
 		{
 			currentScene->RemoveEntity(selectedEntityID);
-			m_SelectedEntityId = -1;
+			m_SelectedEntityId = INVALID_ENTITY_ID;
+			m_bSceneEditCommitted = true;
 			return;
 		}
 	}
@@ -985,11 +1361,7 @@ void Tempus::Renderer::DrawSceneOutlinerTab(Scene *currentScene)
 	ImGui::SameLine();
 	ImGui::Checkbox("Show Selected Entity?", &m_bShowSelectedEntity);
 
-	bool bCanAddComponents = true;
-	if (EditorDataComponent* editorData = currentScene->GetComponent<EditorDataComponent>(selectedEntityID))
-	{
-		bCanAddComponents = !EnumCheckFlag(editorData->flags, EditorEntityDataFlags::NoAddComponent);
-	}
+	const bool bCanAddComponents = !currentScene->HasComponent<EditorNoAddComponentTag>(selectedEntityID);
 	
 	ImGui::Separator();
 	ImGui::Text("Details");
@@ -998,18 +1370,17 @@ void Tempus::Renderer::DrawSceneOutlinerTab(Scene *currentScene)
 	// Component list dropdown
 	if (bCanAddComponents)
 	{
-		static ComponentTypeInfo selectedComponent;
-		if (ImGui::BeginCombo(" ", selectedComponent.name.c_str()))
+		static const ComponentTypeInfo* selectedComponent = nullptr;
+		if (ImGui::BeginCombo(" ", selectedComponent ? selectedComponent->name : ""))
 		{
-			const auto& registeredComponents = TPS_Private::ComponentRegistry::GetRegisteredComponents();
-			for (const auto& component : registeredComponents)
+			for (const ComponentTypeInfo& component : TPS_Private::ComponentRegistry::GetRegisteredComponents())
 			{
 				// If the component has not been specifically marked as no editor add
 				if (!EnumCheckFlag(component.metadata, ComponentMetaFlags::NoEditorAdd))
 				{
-					if (ImGui::Selectable(component.name.c_str()))
+					if (ImGui::Selectable(component.name))
 					{
-						selectedComponent = component;
+						selectedComponent = &component;
 					}
 				}
 			}
@@ -1018,9 +1389,10 @@ void Tempus::Renderer::DrawSceneOutlinerTab(Scene *currentScene)
 		ImGui::SameLine();
 		if(ImGui::Button("Add##component")) // Add component button
 		{
-			if (selectedComponent.addComponentFunc)
+			if (selectedComponent)
 			{
-				selectedComponent.addComponentFunc(currentScene, selectedEntityID);
+				selectedComponent->addComponentFunc(currentScene, selectedEntityID);
+				m_bSceneEditCommitted = true;
 			}
 			else
 			{
@@ -1032,95 +1404,36 @@ void Tempus::Renderer::DrawSceneOutlinerTab(Scene *currentScene)
 	}
 
 	// Disallow component removal if entity has NoRemoveComponent flag
-	bool bCanRemoveComponent = true;
-	if (EditorDataComponent* editorData = currentScene->GetComponent<EditorDataComponent>(selectedEntityID))
-	{
-		bCanRemoveComponent = !EnumCheckFlag(editorData->flags, EditorEntityDataFlags::NoRemoveComponent);
-	}
+	const bool bCanRemoveComponent = !currentScene->HasComponent<EditorNoRemoveComponentTag>(selectedEntityID);
 
 	// Component details
 	ImGui::BeginChild("Details");
-		// @TODO Components should probably store their own virtual ImGui rendering function which can be invoked from here
-		if (TransformComponent* transformComp = currentScene->GetComponent<TransformComponent>(selectedEntityID))
+		for (const ComponentTypeInfo& component : TPS_Private::ComponentRegistry::GetRegisteredComponents())
 		{
-			if (ImGui::TreeNodeEx(TempusUtils::GetClassDebugName<TransformComponent>(), ImGuiTreeNodeFlags_DefaultOpen))
+			// Types without a DrawImGui, such as tags and derived data, aren't listed
+			void* componentMemory = component.drawImGuiFunc ? currentScene->GetComponentMemory(selectedEntityID, component.id) : nullptr;
+			if (!componentMemory)
 			{
-				if (bCanRemoveComponent)
-				{
-					ImGui::SameLine();
-					if (ImGui::Button("Remove"))
-					{
-						currentScene->RemoveComponent<TransformComponent>(selectedEntityID);
-					}
-				}
-				ImGui::DragFloat3("Position", &transformComp->Position.x);
-				ImGui::DragFloat3("Rotation", &transformComp->Rotation.x);
-				ImGui::DragFloat3("Scale", &transformComp->Scale.x, 0.1f);
-				ImGui::TreePop();
-			}
-		}
-		if (CameraComponent* cameraComp = currentScene->GetComponent<CameraComponent>(selectedEntityID))
-		{
-			if (ImGui::TreeNodeEx(TempusUtils::GetClassDebugName<CameraComponent>(), ImGuiTreeNodeFlags_DefaultOpen))
-			{
-				if (bCanRemoveComponent)
-				{
-					ImGui::SameLine();
-					if (ImGui::Button("Remove"))
-					{
-						currentScene->RemoveComponent<CameraComponent>(selectedEntityID);
-					}
-				}
-				ImGui::Text("Projection Type:");
-				ImGui::SameLine();
-				std::string projLabel = cameraComp->ProjectionType == CamProjectionType::Perspective ? "Perspective" : "Orthographic";
-				if (ImGui::Button(projLabel.c_str()))
-				{
-					// Swap projection type
-					cameraComp->ProjectionType = static_cast<CamProjectionType>((static_cast<int>(cameraComp->ProjectionType) + 1) % 2);
-				}
-				if (ImGui::IsItemHovered())
-				{
-					ImGui::SetTooltip("Press to toggle projection type");
-				}
-				ImGui::SliderFloat("FOV", &cameraComp->Fov, 1.0f, 179.0f, "%.3f");
-				ImGui::SliderFloat("Ortho Size", &cameraComp->OrthoSize, 1.0f, 1000.0f, "%.1f");
-				ImGui::SliderFloat("Near Clip", &cameraComp->NearClip, 0.1f, 10.0f, "%.1f");
-				ImGui::SliderFloat("Far Clip", &cameraComp->FarClip, 10.0f, 10000.0f, "%.1f");
-				ImGui::TreePop();
+				continue;
 			}
-		}
-		if (StaticMeshComponent* meshComp = currentScene->GetComponent<StaticMeshComponent>(selectedEntityID))
-		{
-			if (ImGui::TreeNodeEx(TempusUtils::GetClassDebugName<StaticMeshComponent>(), ImGuiTreeNodeFlags_DefaultOpen))
+
+			if (ImGui::TreeNodeEx(component.name, ImGuiTreeNodeFlags_DefaultOpen))
 			{
 				if (bCanRemoveComponent)
 				{
 					ImGui::SameLine();
 					if (ImGui::Button("Remove"))
 					{
-						currentScene->RemoveComponent<StaticMeshComponent>(selectedEntityID);
+						// Removal moves another entity's component into this slot, so the pointer must not be used afterwards
+						component.removeComponentFunc(currentScene, selectedEntityID);
+						componentMemory = nullptr;
+						m_bSceneEditCommitted = true;
 					}
 				}
-				ImGui::Text("WIP");
-				ImGui::TreePop();
-			}
-		}
-		if (LightComponent* lightComp = currentScene->GetComponent<LightComponent>(selectedEntityID))
-		{
-			if (ImGui::TreeNodeEx(TempusUtils::GetClassDebugName<LightComponent>(), ImGuiTreeNodeFlags_DefaultOpen))
-			{
-				if (bCanRemoveComponent)
+				if (componentMemory)
 				{
-					ImGui::SameLine();
-					if (ImGui::Button("Remove"))
-					{
-						currentScene->RemoveComponent<StaticMeshComponent>(selectedEntityID);
-					}
+					m_bSceneEditCommitted |= component.drawImGuiFunc(*currentScene, selectedEntityID, componentMemory);
 				}
-				ImGui::SliderFloat("Radius" , &lightComp->Radius, 1.0f, 1000.0f);
-				ImGui::SliderFloat("Intensity" , &lightComp->Intensity, 1.0f, 1000.0f);
-				ImGui::ColorEdit3("Color", &lightComp->Color.r);
 				ImGui::TreePop();
 			}
 		}
@@ -1132,10 +1445,71 @@ void Tempus::Renderer::DrawSceneInfoTab(Scene* currentScene)
 	// --- Scene info
 	ImGui::Text("Name: %s", currentScene->GetName().c_str());
 	ImGui::Text("Scene Time: %f", currentScene->GetSceneTime());
+	ImGui::Text("Storage: %s", GetStorageModeName(currentScene->GetStorageMode()));
+	ImGui::Text("Component Memory: %.2f KB", static_cast<double>(currentScene->GetComponentMemoryUsage()) / 1024.0);
 	ImGui::Separator();
 	ImGui::ColorPicker3("Clear Color", &m_ClearColor[0]);
 }
 
+void Tempus::Renderer::DrawSceneSystemsTab(Scene* currentScene)
+{
+	// --- System scheduler timings
+	SystemScheduler& scheduler = currentScene->GetSystemScheduler();
+
+	bool bSerial = scheduler.IsSerialExecution();
+	if (ImGui::Checkbox("Serial Execution (Deterministic)", &bSerial))
+	{
+		scheduler.SetSerialExecution(bSerial);
+	}
+	ImGui::Text("Systems: %u", scheduler.GetSystemCount());
+	ImGui::Text("Update: %.4f ms | Critical Path: %.4f ms", scheduler.GetFrameMs(), scheduler.GetCriticalPathMs());
+
+	const auto& timings = scheduler.GetTimings();
+	if (ImGui::BeginTable("SystemTable", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable))
+	{
+		ImGui::TableSetupColumn("System", ImGuiTableColumnFlags_WidthStretch);
+		ImGui::TableSetupColumn("Start (ms)", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+		ImGui::TableSetupColumn("Time (ms)", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+		ImGui::TableSetupColumn("Slowest (ms)", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+		ImGui::TableSetupColumn("Waits On", ImGuiTableColumnFlags_WidthStretch);
+		ImGui::TableHeadersRow();
+
+		for (const SystemScheduler::SystemTiming& timing : timings)
+		{
+			ImGui::TableNextRow();
+			ImGui::TableSetColumnIndex(0);
+			// Systems on the critical path are highlighted as they bound the update time
+			if (timing.bOnCriticalPath)
+			{
+				ImGui::TextColored(ImVec4(1.0f, 0.73f, 0.01f, 1.0f), "%s", timing.name);
+			}
+			else
+			{
+				ImGui::Text("%s", timing.name);
+			}
+			ImGui::TableSetColumnIndex(1);
+			ImGui::Text("%.4f", timing.startMs);
+			ImGui::TableSetColumnIndex(2);
+			ImGui::Text("%.4f", timing.durationMs);
+			ImGui::TableSetColumnIndex(3);
+			ImGui::Text("%.4f", timing.highestDurationMs);
+			ImGui::TableSetColumnIndex(4);
+			std::string dependencies;
+			for (uint32_t dependency : timing.dependencies)
+			{
+				if (!dependencies.empty())
+				{
+					dependencies += ", ";
+				}
+				dependencies += timings[dependency].name;
+			}
+			ImGui::Text("%s", dependencies.empty() ? "None" : dependencies.c_str());
+		}
+
+		ImGui::EndTable();
+	}
+}
+
 void Tempus::Renderer::CreateVulkanInstance()
 {
 	if (m_bEnableValidationLayers && !CheckValidationLayerSupport())
@@ -1780,7 +2154,7 @@ void Tempus::Renderer::CreateTextureSampler()
 	}
 }
 
-void Tempus::Renderer::CreateVertexBuffer(VkBuffer& buffer, VkDeviceMemory& bufferMemory, std::vector<Vertex>& vertices)
+void Tempus::Renderer::CreateVertexBuffer(VkBuffer& buffer, VkDeviceMemory& bufferMemory, const std::vector<Vertex>& vertices)
 {
 	VkDeviceSize bufferSize = sizeof(vertices[0]) * vertices.size();
 
@@ -1805,7 +2179,7 @@ void Tempus::Renderer::CreateVertexBuffer(VkBuffer& buffer, VkDeviceMemory& buff
 	vkFreeMemory(m_Device, stagingBufferMemory, nullptr);
 }
 
-void Tempus::Renderer::CreateIndexBuffer(VkBuffer& buffer, VkDeviceMemory& bufferMemory, std::vector<uint32_t>& indices)
+void Tempus::Renderer::CreateIndexBuffer(VkBuffer& buffer, VkDeviceMemory& bufferMemory, const std::vector<uint32_t>& indices)
 {
 	VkDeviceSize bufferSize = sizeof(indices[0]) * indices.size();
 
@@ -1853,12 +2227,62 @@ void Tempus::Renderer::CreateUniformBuffers()
 		m_DynamicAlignment = (m_DynamicAlignment + minUboAlignment - 1) & ~(minUboAlignment - 1);
 	}
 	
+	CreateDynamicUniformBuffer();
+}
+
+void Tempus::Renderer::CreateDynamicUniformBuffer()
+{
 	VkDeviceSize dynamicBufferSize = m_DynamicAlignment * m_MaxObjects;
 	CreateBuffer(dynamicBufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
 		m_DynamicUniformBuffer, m_DynamicUniformBufferMemory);
 	vkMapMemory(m_Device, m_DynamicUniformBufferMemory, 0, dynamicBufferSize, 0, &m_DynamicUniformBufferMapped);
 }
 
+void Tempus::Renderer::EnsureObjectCapacity(uint32_t objectCount)
+{
+	if (objectCount <= m_MaxObjects)
+	{
+		return;
+	}
+
+	// Grow geometrically so a scene that keeps spawning doesn't reallocate every frame
+	const uint32_t newMaxObjects = std::max(objectCount, m_MaxObjects * 2);
+
+	// The previous buffer may still be read by a frame in flight
+	vkDeviceWaitIdle(m_Device);
+
+	vkUnmapMemory(m_Device, m_DynamicUniformBufferMemory);
+	vkDestroyBuffer(m_Device, m_DynamicUniformBuffer, nullptr);
+	vkFreeMemory(m_Device, m_DynamicUniformBufferMemory, nullptr);
+
+	m_MaxObjects = newMaxObjects;
+	CreateDynamicUniformBuffer();
+	// The new buffer starts empty
+	m_bObjectBufferReset = true;
+
+	// Point every frame's descriptor set at the new buffer
+	for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+	{
+		VkDescriptorBufferInfo dynamicBufferInfo{};
+		dynamicBufferInfo.buffer = m_DynamicUniformBuffer;
+		dynamicBufferInfo.offset = 0;
+		dynamicBufferInfo.range = sizeof(ObjectUBO);
+
+		VkWriteDescriptorSet descriptorWrite{};
+		descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		descriptorWrite.dstSet = m_DescriptorSets[i];
+		descriptorWrite.dstBinding = 1;
+		descriptorWrite.dstArrayElement = 0;
+		descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+		descriptorWrite.descriptorCount = 1;
+		descriptorWrite.pBufferInfo = &dynamicBufferInfo;
+
+		vkUpdateDescriptorSets(m_Device, 1, &descriptorWrite, 0, nullptr);
+	}
+
+	TPS_CORE_INFO("Object uniform buffer resized to {0} objects", m_MaxObjects);
+}
+
 void Tempus::Renderer::CreateDescriptorPool()
 {
 	std::array<VkDescriptorPoolSize, 3> poolSizes{};
@@ -1990,6 +2414,15 @@ void Tempus::Renderer::CreateSyncObjects()
 }
 
 void Tempus::Renderer::LoadModel(const std::string& modelName)
+{
+	ModelData model;
+	if (ReadModel(modelName, model))
+	{
+		UploadModel(model);
+	}
+}
+
+bool Tempus::Renderer::ReadModel(const std::string& modelName, ModelData& outModel)
 {
 	std::string modelPath = FileUtils::ModelDir().string() + '/' + modelName;
 	
@@ -2002,11 +2435,14 @@ void Tempus::Renderer::LoadModel(const std::string& modelName)
     if (!scene)
     {
         TPS_CORE_ERROR("Failed to load FBX: {}", error.description.data);
-        return;
+        return false;
     }
 
-    std::vector<Vertex> vertices;
-    std::vector<uint32_t> indices;
+	outModel.name = modelName;
+	std::vector<Vertex>& vertices = outModel.vertices;
+	std::vector<uint32_t>& indices = outModel.indices;
+	vertices.clear();
+	indices.clear();
 	
 	for (size_t meshIdx = 0; meshIdx < scene->meshes.count; meshIdx++)
 	{
@@ -2062,16 +2498,35 @@ void Tempus::Renderer::LoadModel(const std::string& modelName)
 	
     TPS_CORE_INFO("Loaded FBX: {} ({} vertices, {} indices)", modelPath, vertices.size(), indices.size());
 
+    ufbx_free_scene(scene);
+	return true;
+}
+
+void Tempus::Renderer::UploadModel(const ModelData& model)
+{
+	if (IsModelLoaded(model.name))
+	{
+		return;
+	}
+
 	VkBuffer vertexBuffer = VK_NULL_HANDLE;
 	VkDeviceMemory vertexBufferMemory = VK_NULL_HANDLE;
-	CreateVertexBuffer(vertexBuffer, vertexBufferMemory, vertices);
+	CreateVertexBuffer(vertexBuffer, vertexBufferMemory, model.vertices);
 	VkBuffer indexBuffer = VK_NULL_HANDLE;
 	VkDeviceMemory indexBufferMemory = VK_NULL_HANDLE;
-	CreateIndexBuffer(indexBuffer, indexBufferMemory, indices);
+	CreateIndexBuffer(indexBuffer, indexBufferMemory, model.indices);
 	
-	m_ModelBufferRegistry[modelName] = ModelBuffer{ vertexBuffer, vertexBufferMemory, indexBuffer, indexBufferMemory, static_cast<uint32_t>(indices.size()) };
+	m_ModelBufferRegistry[model.name] = ModelBuffer{ vertexBuffer, vertexBufferMemory, indexBuffer, indexBufferMemory, static_cast<uint32_t>(model.indices.size()) };
+}
 
-    ufbx_free_scene(scene);
+std::unordered_set<std::string> Tempus::Renderer::GetLoadedModelNames() const
+{
+	std::unordered_set<std::string> names;
+	for (const auto& [name, buffer] : m_ModelBufferRegistry)
+	{
+		names.insert(name);
+	}
+	return names;
 }
 
 bool Tempus::Renderer::IsModelLoaded(const std::string& modelName) const
@@ -2079,6 +2534,28 @@ bool Tempus::Renderer::IsModelLoaded(const std::string& modelName) const
 	return m_ModelBufferRegistry.contains(modelName);
 }
 
+const Tempus::ModelBuffer& Tempus::Renderer::GetMeshModelBuffer(const SharedRef<StaticMeshData>& mesh)
+{
+	const SharedDataHandle handle = mesh.GetHandle();
+	if (handle >= m_MeshModelBuffers.size())
+	{
+		m_MeshModelBuffers.resize(handle + 1, nullptr);
+	}
+
+	if (!m_MeshModelBuffers[handle])
+	{
+		// @TODO Slow. Currently lazily loading here, will initialize beforehand once assets are setup.
+		if (!IsModelLoaded(mesh->ModelName))
+		{
+			LoadModel(mesh->ModelName);
+		}
+		// Registry elements never move, so the pointer stays valid as more models are loaded
+		m_MeshModelBuffers[handle] = &m_ModelBufferRegistry[mesh->ModelName];
+	}
+
+	return *m_MeshModelBuffers[handle];
+}
+
 void Tempus::Renderer::CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory)
 {
 	VkBufferCreateInfo bufferInfo{};
@@ -2346,17 +2823,24 @@ void Tempus::Renderer::RecordCommandBuffer(VkCommandBuffer commandBuffer, uint32
 
 	if (Scene* activeScene = SCENE_MANAGER->GetActiveScene())
 	{
-		// @TODO In the future I will implement a way to iterate over only the entities that have a mesh component
-		std::vector<uint32_t> entities = activeScene->GetEntityIDs();
+		// Handles of freed mesh blocks are reused for new meshes, so the cache starts over once any was freed
+		const uint32_t meshReleaseCount = StaticMeshComponent::GetSharedData().GetReleaseCount();
+		if (meshReleaseCount != m_MeshModelBuffersReleaseCount)
+		{
+			m_MeshModelBuffers.clear();
+			m_MeshModelBuffersReleaseCount = meshReleaseCount;
+		}
+
 		uint32_t objectIndex = 0;
+		// Consecutive draws of the same mesh skip rebinding its buffers, see Scene::SortPool()
+		const ModelBuffer* boundModelBuffer = nullptr;
 
-		for (uint32_t entityId : entities)
+		// Only entities with a world transform receive a model UBO, so they are the only ones drawn
+		activeScene->View<WorldTransformComponent, StaticMeshComponent>().Each([this, commandBuffer, &objectIndex, &boundModelBuffer](uint32_t entityId, WorldTransformComponent& worldComp, StaticMeshComponent& meshComp)
 		{
-			StaticMeshComponent* meshComp = activeScene->GetComponent<StaticMeshComponent>(entityId);
-
-			if (!meshComp || objectIndex >= m_MaxObjects)
+			if (objectIndex >= m_MaxObjects)
 			{
-				continue;
+				return;
 			}
 
 			// Calculate dynamic offset for this object
@@ -2366,23 +2850,20 @@ void Tempus::Renderer::RecordCommandBuffer(VkCommandBuffer commandBuffer, uint32
 			vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
 				m_PipelineLayout, 0, 1, &m_DescriptorSets[m_CurrentFrame], 1, &dynamicOffset);
 
-			// Ensure model is loaded
-			// @TODO Slow. Currently lazily loading here, will initialize beforehand once assets are setup.
-			if (!IsModelLoaded(meshComp->ModelName))
+			const ModelBuffer& modelBuffer = GetMeshModelBuffer(meshComp.GetMesh());
+			// Bind vertex/index buffers and draw
+			if (boundModelBuffer != &modelBuffer)
 			{
-				LoadModel(meshComp->ModelName);
+				VkBuffer vertexBuffers[] = { modelBuffer.vertexBuffer };
+				VkDeviceSize offsets[] = { 0 };
+				vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
+				vkCmdBindIndexBuffer(commandBuffer, modelBuffer.indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+				boundModelBuffer = &modelBuffer;
 			}
-			
-			ModelBuffer modelBuffer = m_ModelBufferRegistry[meshComp->ModelName];
-			// Bind vertex/index buffers and draw
-			VkBuffer vertexBuffers[] = { modelBuffer.vertexBuffer };
-			VkDeviceSize offsets[] = { 0 };
-			vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
-			vkCmdBindIndexBuffer(commandBuffer, modelBuffer.indexBuffer, 0, VK_INDEX_TYPE_UINT32);
 
 			vkCmdDrawIndexed(commandBuffer, modelBuffer.indexCount, 1, 0, 0, 0);
 			objectIndex++;
-		}
+		});
 	}
 
 	ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), commandBuffer);
@@ -3084,6 +3565,7 @@ void Tempus::Renderer::Cleanup()
 		vkDestroyBuffer(m_Device, modelBuffer.indexBuffer, nullptr);
 		vkFreeMemory(m_Device, modelBuffer.indexBufferMemory, nullptr);
 	}
+	m_MeshModelBuffers.clear();
 
 	vkDestroyPipeline(m_Device, m_GraphicsPipeline, nullptr);
 	vkDestroyPipelineLayout(m_Device, m_PipelineLayout, nullptr);
@@ -9,10 +9,12 @@
 #include "vulkan/vulkan.h"
 #include <optional>
 #include "Log.h"
+#include "SharedDataTable.h"
 #include "Events/IEventListener.h"
 #include "glm/glm.hpp"
 #include <array>
 #include <bitset>
+#include <unordered_set>
 #include "imgui/imgui.h"
 #include <future>
 #define GLM_ENABLE_EXPERIMENTAL
@@ -28,6 +30,8 @@
 
 namespace Tempus {
 
+	struct StaticMeshData;
+
 	struct TEMPUS_API Vertex {
 
 		glm::vec3 pos;
@@ -85,6 +89,14 @@ namespace Tempus {
 		glm::mat4 model;
 	};
 
+	// Geometry of a model on the CPU, filled by Renderer::ReadModel()
+	struct ModelData
+	{
+		std::string name;
+		std::vector<Vertex> vertices;
+		std::vector<uint32_t> indices;
+	};
+
 	struct ModelBuffer
 	{
 		VkBuffer vertexBuffer;
@@ -122,12 +134,20 @@ namespace Tempus {
 
 		void SetClearColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a);
 		void SetActiveCamera(uint32_t cameraEntityId);
+		uint32_t GetActiveCamera() const { return m_ActiveCamEntityId; }
 		bool WorldToScreen(const glm::vec3& worldPos, ImVec2& outScreen) const;
 		void FocusSelectedEntity() { FocusEntity(m_SelectedEntityId); }
 		void FocusEntity(uint32_t entityId);
 
 		void ReloadShaders();
 
+		// Parses a model file into triangles. Touches no renderer state, so loaders can call it from any thread.
+		static bool ReadModel(const std::string& modelName, ModelData& outModel);
+		// Creates the GPU buffers of a model read with ReadModel(), skipped if the model is already loaded
+		void UploadModel(const ModelData& model);
+		// Snapshot for loaders deciding which models still need reading
+		std::unordered_set<std::string> GetLoadedModelNames() const;
+
 		const int MAX_FRAMES_IN_FLIGHT = 3;
 
 	private:
@@ -137,11 +157,17 @@ namespace Tempus {
 		float m_ClearColor[4] = {0.25f, 0.5f, 0.1f, 0.0f};
 
 		uint32_t m_ActiveCamEntityId = 0;
-		int m_SelectedEntityId = -1;
+		uint32_t m_SelectedEntityId = INVALID_ENTITY_ID;
 		GlobalUBO m_LastGlobalUbo;
 		bool m_bDrawEntityNames = false;
 		bool m_bShowSelectedEntity = true;
+		// Whether a widget was held last frame, see DrawImGui()
+		bool m_bWasEditing = false;
+		// Set by any editor widget or tool that finished changing the scene this frame, an undo step is recorded at the end of it
+		bool m_bSceneEditCommitted = false;
 		float m_EntityFocusDistance = 200.0f;
+		// Reused every frame so listing the outliner doesn't allocate
+		std::vector<uint32_t> m_OutlinerEntityIds;
 
 		std::future<ShaderCompileResult> m_ShaderCompileResult;
 		ShaderCompileResult m_LastShaderCompileResult;
@@ -192,9 +218,12 @@ namespace Tempus {
 		void CreateTextureImage();
 		void CreateTextureImageView();
 		void CreateTextureSampler();
-		void CreateVertexBuffer(VkBuffer& buffer, VkDeviceMemory& bufferMemory, std::vector<Vertex>& vertices);
-		void CreateIndexBuffer(VkBuffer& buffer, VkDeviceMemory& bufferMemory, std::vector<uint32_t>& indices);
+		void CreateVertexBuffer(VkBuffer& buffer, VkDeviceMemory& bufferMemory, const std::vector<Vertex>& vertices);
+		void CreateIndexBuffer(VkBuffer& buffer, VkDeviceMemory& bufferMemory, const std::vector<uint32_t>& indices);
 		void CreateUniformBuffers();
+		void CreateDynamicUniformBuffer();
+		// Reallocates the per object uniform buffer when the scene has outgrown it
+		void EnsureObjectCapacity(uint32_t objectCount);
 		void CreateDescriptorPool();
 		void CreateDescriptorSets();
 		void CreateCommandBuffer();
@@ -203,6 +232,8 @@ namespace Tempus {
 		// @TODO Right now models are backed by unique file names, this will change once I have assets setup
 		void LoadModel(const std::string& modelName);
 		inline bool IsModelLoaded(const std::string& modelName) const;
+		// Buffers of the mesh's model, loading it on first use. Cached per shared mesh block so drawing doesn't hash model names.
+		const ModelBuffer& GetMeshModelBuffer(const SharedRef<StaticMeshData>& mesh);
 
 		void CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory);
 		void CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size);
@@ -255,6 +286,7 @@ namespace Tempus {
 		void DrawSceneWindow(class Scene* currentScene);
 		void DrawSceneInfoTab(Scene* currentScene);
 		void DrawSceneOutlinerTab(Scene* currentScene);
+		void DrawSceneSystemsTab(Scene* currentScene);
 		void DrawProfilerDataWindow(Scene* currentScene);
 		void DrawAllEntityNames(Scene* currentScene);
 		void DrawEntityName(Scene* currentScene, uint32_t entId, ImU32 color);
@@ -302,6 +334,10 @@ namespace Tempus {
 		uint32_t m_CurrentFrame = 0;
 
 		std::unordered_map<std::string, ModelBuffer> m_ModelBufferRegistry;
+		// Indexed by StaticMeshData handle, points into m_ModelBufferRegistry
+		std::vector<const ModelBuffer*> m_MeshModelBuffers;
+		// Shared mesh data release count m_MeshModelBuffers was built at, see SharedDataTable::GetReleaseCount()
+		uint32_t m_MeshModelBuffersReleaseCount = 0;
 
 		std::vector<VkBuffer> m_GlobalUniformBuffers;
 		std::vector<VkDeviceMemory> m_GlobalUniformBuffersMemory;
@@ -312,7 +348,13 @@ namespace Tempus {
 		void* m_DynamicUniformBufferMapped = nullptr;
 
 		size_t m_DynamicAlignment = 0;
-		uint32_t m_MaxObjects = MAX_ENTITIES;
+		// Initial per object uniform buffer capacity, grows with the scene
+		uint32_t m_MaxObjects = 1024;
+		// What the object buffer currently holds, used to only rewrite changed model matrices
+		uint64_t m_UploadedSceneSerial = 0;
+		uint32_t m_UploadedViewStructureVersion = 0;
+		uint32_t m_UploadedChangeVersion = 0;
+		bool m_bObjectBufferReset = true;
 
 		VkDescriptorPool m_DescriptorPool = VK_NULL_HANDLE;
 		std::vector<VkDescriptorSet> m_DescriptorSets;
@@ -3,45 +3,70 @@
 #include "Scene.h"
 #include "Entity/Entity.h"
 #include "Log.h"
+#include "Components/ComponentTypeTable.h"
+#include "Components/HierarchyComponent.h"
 #include "Systems/EditorCameraSystem.h"
+#include "Systems/TransformSystem.h"
+#include "Utils/Profiling.h"
+#include <algorithm>
+#include <atomic>
+
+namespace
+{
+    std::atomic<uint64_t> g_NextSceneSerial = 1;
+
+    // The command buffer the current thread last used, skips the scene's lock on repeat lookups
+    struct CachedCommandBuffer
+    {
+        uint64_t sceneSerial = 0;
+        Tempus::SceneCommandBuffer* buffer = nullptr;
+    };
+    thread_local CachedCommandBuffer t_CachedCommandBuffer;
+
+    // Observers that keep reacting to each other's structural changes are cut off after this many delivery passes
+    constexpr uint32_t MaxObserverFlushPasses = 16;
+}
 
 void Tempus::Scene::OnUpdate(float DeltaTime)
 {
     m_SceneTime += static_cast<double>(DeltaTime);
+
+    // Deliver changes made directly since the last update before systems run
+    FlushComponentObservers();
     
-    // Update all systems in scene with update enabled
-     for (const auto& system : m_Systems)
-     {
-         if (system->IsUpdating())
-         {
-             system->OnUpdate(DeltaTime);
-         }
-     }
+    // Update all systems in scene with update enabled, non-conflicting systems run in parallel
+    m_SystemScheduler.Update(DeltaTime);
+
+    // Sync point, every system has finished so deferred structural changes can be applied safely
+    PlaybackCommandBuffers();
+
+    // Nothing is iterating the scene anymore, so storage can be reordered
+    UpdateIncrementalSorts();
 }
 
-Tempus::Scene::Scene(std::string sceneName) : m_SceneName(std::move(sceneName))
+Tempus::Scene::Scene(std::string sceneName, SceneStorageMode storageMode) : m_StorageMode(storageMode), m_SceneName(std::move(sceneName))
 {
-    for (uint32_t entity = 0; entity < MAX_ENTITIES; entity++)
+    m_SceneSerial = g_NextSceneSerial.fetch_add(1, std::memory_order_relaxed);
+
+    if (m_StorageMode == SceneStorageMode::Archetypes)
     {
-        m_AvailableEntityIds.push(entity); 
+        m_ArchetypeStorage = std::make_unique<ArchetypeStorage>();
+        m_ArchetypeStorage->SetChangeVersionSource(&m_ChangeVersion);
     }
 
     // Core systems
-    m_Systems.push_back(std::make_unique<EditorCameraSystem>());
-    
-    for (const auto& system : m_Systems)
-    {
-        system->OnInit(this);
-    }
+    AddSystem<EditorCameraSystem>();
+    m_TransformSystem = AddSystem<TransformSystem>();
 }
 
-Tempus::Entity Tempus::Scene::AddEntity(std::string name)
+Tempus::Entity Tempus::Scene::AddEntity(std::string_view name)
 {
-    TPS_ASSERT(m_EntityCount < MAX_ENTITIES, "Max entity count reached! Cannot create entity");
-
-    uint32_t id = m_AvailableEntityIds.front();
-    m_AvailableEntityIds.pop();
-    m_EntityCount++;
+    const uint32_t id = CreateEntityId();
+    if (id == INVALID_ENTITY_ID)
+    {
+        TPS_CORE_CRITICAL("Max entity count reached! Cannot create entity [{0}]", name);
+        return Entity(INVALID_ENTITY_ID);
+    }
 
     Entity newEntity = Entity(id);
     newEntity.m_OwnerScene = this;
@@ -49,56 +74,1083 @@ Tempus::Entity Tempus::Scene::AddEntity(std::string name)
 
     TPS_CORE_TRACE("Entity Created! Name: [{0}] ID: [{1}]", name, id);
     
-    m_Entities.insert(id);
-    m_EntityNames[id] = std::move(name);
+    SetEntityName(id, m_NameTable.Intern(name));
     
     return newEntity;
 }
 
 void Tempus::Scene::RemoveEntity(uint32_t id)
 {
-    TPS_ASSERT(m_EntityCount < MAX_ENTITIES, "Cannot remove entity of ID [{0}]. ID exceeds maximum!", id);
-
-    if (!m_EntityNames.contains(id))
+    if (!HasEntity(id))
     {
         TPS_CORE_ERROR("Cannot remove entity of ID [{0}]. Does not exist!", id);
         return;
     }
+
+    DestroyEntity(id);
     
-    m_AvailableEntityIds.push(id);
+    TPS_CORE_TRACE("Entity Removed! ID: [{0}]", id);
+}
+
+void Tempus::Scene::DespawnBatch(std::span<const uint32_t> ids)
+{
+    uint32_t removedCount = 0;
+    m_FreeEntityIndices.reserve(m_FreeEntityIndices.size() + ids.size());
+    for (uint32_t id : ids)
+    {
+        if (!HasEntity(id))
+        {
+            TPS_CORE_ERROR("Cannot despawn entity of ID [{0}]. Does not exist!", id);
+            continue;
+        }
+
+        DestroyEntity(id);
+        removedCount++;
+    }
+
+    TPS_CORE_TRACE("Entity batch despawned! Count: [{0}]", removedCount);
+}
+
+void Tempus::Scene::DespawnBatch(std::span<const Entity> entities)
+{
+    std::vector<uint32_t> ids;
+    ids.reserve(entities.size());
+    for (const Entity& entity : entities)
+    {
+        ids.push_back(entity.GetId());
+    }
+    DespawnBatch(std::span<const uint32_t>(ids));
+}
+
+uint32_t Tempus::Scene::CreateEntityId()
+{
+    uint32_t index = m_NextEntityIndex;
+    if (!m_FreeEntityIndices.empty())
+    {
+        index = m_FreeEntityIndices.back();
+        m_FreeEntityIndices.pop_back();
+    }
+    else
+    {
+        // The all ones index is reserved so no valid ID can equal INVALID_ENTITY_ID
+        if (m_NextEntityIndex >= ENTITY_INDEX_MASK)
+        {
+            return INVALID_ENTITY_ID;
+        }
+        m_NextEntityIndex++;
+
+        // First use of this slot, allocates a new page of slot data every ENTITY_PAGE_SIZE entities
+        m_EntityComponents.Ensure(index);
+        m_EntityGenerations.Ensure(index);
+        m_EntityListIndex.Ensure(index);
+        m_EntityNameIds.Ensure(index);
+        m_EntityNamePositions.Ensure(index);
+    }
+
+    const uint32_t id = MakeEntityId(index, m_EntityGenerations[index]);
+    m_EntityListIndex[index] = static_cast<uint32_t>(m_EntityList.size());
+    m_EntityList.push_back(id);
+    m_bOrderedEntityListDirty = true;
+    m_EntityCount++;
+    m_EntityListChangeVersion = GetChangeVersion();
+    return id;
+}
+
+std::vector<uint32_t> Tempus::Scene::CreateEntityBatch(uint32_t count, std::string_view name)
+{
+    std::vector<uint32_t> ids;
+    if (count == 0)
+    {
+        return ids;
+    }
+
+    // Checked up front so a batch is either created whole or not at all
+    const size_t availableSlots = m_FreeEntityIndices.size() + (ENTITY_INDEX_MASK - m_NextEntityIndex);
+    if (count > availableSlots)
+    {
+        TPS_CORE_CRITICAL("Max entity count reached! Cannot create batch of {0} entities [{1}]", count, name);
+        return ids;
+    }
+
+    ids.resize(count);
+    m_EntityList.reserve(m_EntityList.size() + count);
+    for (uint32_t& id : ids)
+    {
+        id = CreateEntityId();
+    }
+
+    // One name lookup for the whole batch, appended to the name's list as one range
+    const NameId nameId = m_NameTable.Intern(name);
+    if (nameId >= m_EntitiesByName.size())
+    {
+        m_EntitiesByName.resize(nameId + 1);
+    }
+    std::vector<uint32_t>& namedEntities = m_EntitiesByName[nameId];
+    uint32_t namePosition = static_cast<uint32_t>(namedEntities.size());
+    for (uint32_t id : ids)
+    {
+        m_EntityNameIds[GetEntityIndex(id)] = nameId;
+        m_EntityNamePositions[GetEntityIndex(id)] = namePosition++;
+    }
+    namedEntities.insert(namedEntities.end(), ids.begin(), ids.end());
+
+    return ids;
+}
+
+void Tempus::Scene::OnEntityBatchCreated(std::span<const uint32_t> ids, const ComponentSignature& signature, std::string_view name)
+{
+    for (uint32_t id : ids)
+    {
+        m_EntityComponents[GetEntityIndex(id)] = signature;
+    }
+
+    OnEntitiesAdded(ids, signature);
+
+    TPS_CORE_TRACE("Entity batch spawned! Name: [{0}] Count: [{1}] Components: [{2}]", name, ids.size(), signature.count());
+}
+
+void Tempus::Scene::OnEntitiesAdded(std::span<const uint32_t> ids, const ComponentSignature& signature)
+{
+    m_EntityListChangeVersion = GetChangeVersion();
+    for (auto& [cacheSignature, cache] : m_ViewCaches)
+    {
+        if (cache->Matches(signature))
+        {
+            cache->AddEntities(ids);
+        }
+    }
+
+    const ComponentSignature observedChanges = signature & m_ObservedComponents;
+    for (ComponentId componentId = 0; componentId < MAX_COMPONENTS && observedChanges.any(); componentId++)
+    {
+        if (observedChanges.test(componentId))
+        {
+            std::vector<ObservedChange>& pendingChanges = m_ComponentObservers[componentId].pendingChanges;
+            pendingChanges.reserve(pendingChanges.size() + ids.size());
+            for (uint32_t id : ids)
+            {
+                pendingChanges.push_back({ id, true });
+            }
+        }
+    }
+    m_PendingObservedComponents |= observedChanges;
+}
+
+bool Tempus::Scene::RestoreEntities(std::span<const uint32_t> ids, std::span<const NameId> nameIds, std::span<const ComponentSignature> signatures)
+{
+    if (m_NextEntityIndex != 0)
+    {
+        TPS_CORE_ERROR("Cannot restore entities into scene [{0}], it already has entities!", m_SceneName);
+        return false;
+    }
+
+    // Validated up front so the scene is either restored whole or left untouched
+    uint32_t slotCount = 0;
+    std::vector<bool> usedSlots;
+    for (uint32_t id : ids)
+    {
+        const uint32_t index = GetEntityIndex(id);
+        if (id == INVALID_ENTITY_ID || index == ENTITY_INDEX_MASK)
+        {
+            TPS_CORE_ERROR("Cannot restore entity of invalid ID [{0}]!", id);
+            return false;
+        }
+        if (index >= usedSlots.size())
+        {
+            usedSlots.resize(index + 1);
+        }
+        if (usedSlots[index])
+        {
+            TPS_CORE_ERROR("Cannot restore entity [{0}], its slot is used by another restored entity!", id);
+            return false;
+        }
+        usedSlots[index] = true;
+        slotCount = std::max(slotCount, index + 1);
+    }
+
+    // HasEntity() reads every slot below m_NextEntityIndex, so every page up to the highest slot must exist
+    for (uint32_t index = 0; index < slotCount; index += ENTITY_PAGE_SIZE)
+    {
+        m_EntityComponents.Ensure(index);
+        m_EntityGenerations.Ensure(index);
+        m_EntityListIndex.Ensure(index);
+        m_EntityNameIds.Ensure(index);
+        m_EntityNamePositions.Ensure(index);
+    }
+    m_NextEntityIndex = slotCount;
+
+    m_EntityList.reserve(ids.size());
+    for (size_t i = 0; i < ids.size(); i++)
+    {
+        const uint32_t index = GetEntityIndex(ids[i]);
+        m_EntityGenerations[index] = GetEntityGeneration(ids[i]);
+        m_EntityListIndex[index] = static_cast<uint32_t>(m_EntityList.size());
+        m_EntityList.push_back(ids[i]);
+        m_EntityComponents[index] = signatures[i];
+        SetEntityName(ids[i], nameIds[i]);
+    }
+    m_bOrderedEntityListDirty = true;
+    m_EntityCount = static_cast<uint32_t>(ids.size());
+
+    // Pushed highest first so the lowest free slot is reused first
+    for (uint32_t index = slotCount; index-- > 0;)
+    {
+        if (!usedSlots[index])
+        {
+            m_FreeEntityIndices.push_back(index);
+        }
+    }
+
+    std::unordered_map<ComponentSignature, std::vector<uint32_t>> entitiesBySignature;
+    for (size_t i = 0; i < ids.size(); i++)
+    {
+        entitiesBySignature[signatures[i]].push_back(ids[i]);
+    }
+    for (const auto& [signature, signatureIds] : entitiesBySignature)
+    {
+        OnEntitiesAdded(signatureIds, signature);
+    }
+
+    TPS_CORE_TRACE("Entities restored! Count: [{0}] Slots: [{1}]", ids.size(), slotCount);
+    return true;
+}
+
+std::unique_ptr<Tempus::Scene> Tempus::Scene::Clone() const
+{
+    TPS_SCOPED_TIMER();
+
+    std::unique_ptr<Scene> clone = std::make_unique<Scene>(m_SceneName, m_StorageMode);
+
+    clone->m_EntityComponents = m_EntityComponents;
+    clone->m_EntityGenerations = m_EntityGenerations;
+    clone->m_EntityListIndex = m_EntityListIndex;
+    clone->m_EntityList = m_EntityList;
+    clone->m_FreeEntityIndices = m_FreeEntityIndices;
+    clone->m_NextEntityIndex = m_NextEntityIndex;
+    clone->m_EntityNameIds = m_EntityNameIds;
+    clone->m_EntityNamePositions = m_EntityNamePositions;
+    clone->m_EntitiesByName = m_EntitiesByName;
+    clone->m_EntityCount = m_EntityCount;
+
+    // Interning every name in ID order hands out the same IDs again
+    for (NameId nameId = 0; nameId < m_NameTable.GetCount(); nameId++)
+    {
+        clone->m_NameTable.Intern(m_NameTable.GetString(nameId));
+    }
+
+    if (m_ArchetypeStorage)
+    {
+        clone->m_ArchetypeStorage = m_ArchetypeStorage->Clone();
+        clone->m_ArchetypeStorage->SetChangeVersionSource(&clone->m_ChangeVersion);
+    }
+    for (const auto& [componentId, pool] : m_ComponentPools)
+    {
+        std::unique_ptr<IComponentPool> clonedPool = pool->Clone();
+        clonedPool->SetChangeVersionSource(&clone->m_ChangeVersion);
+        clone->m_ComponentPools.emplace(componentId, std::move(clonedPool));
+    }
+
+    for (const auto& [signature, cache] : m_ViewCaches)
+    {
+        clone->m_ViewCaches.emplace(signature, std::make_unique<SceneViewCache>(*cache));
+    }
+
+    clone->m_SortingComponents = m_SortingComponents;
+    clone->m_SortMovesPerUpdate = m_SortMovesPerUpdate;
+    clone->m_ChangeVersion.store(m_ChangeVersion.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    clone->m_EntityListChangeVersion = m_EntityListChangeVersion;
+    clone->m_SceneTime = m_SceneTime;
+
+    // Changes this scene hasn't delivered yet are delivered to the clone's observers instead
+    const ComponentSignature pendingChanges = m_PendingObservedComponents & clone->m_ObservedComponents;
+    for (ComponentId componentId = 0; componentId < MAX_COMPONENTS && pendingChanges.any(); componentId++)
+    {
+        if (pendingChanges.test(componentId))
+        {
+            clone->m_ComponentObservers[componentId].pendingChanges = m_ComponentObservers[componentId].pendingChanges;
+        }
+    }
+    clone->m_PendingObservedComponents = pendingChanges;
+
+    TPS_CORE_TRACE("Scene cloned! Name: [{0}] Entities: [{1}]", m_SceneName, m_EntityCount);
+    return clone;
+}
+
+std::vector<uint32_t> Tempus::Scene::CopyEntities(Scene& source, std::span<const uint32_t> sourceIds, std::unordered_map<uint32_t, uint32_t>& idMap)
+{
+    std::vector<uint32_t> newIds;
+    if (&source == this)
+    {
+        TPS_CORE_ERROR("Cannot copy entities of scene [{0}] into itself!", m_SceneName);
+        return newIds;
+    }
+
+    std::vector<uint32_t> copiedIds;
+    copiedIds.reserve(sourceIds.size());
+    for (uint32_t sourceId : sourceIds)
+    {
+        if (!source.HasEntity(sourceId))
+        {
+            TPS_CORE_ERROR("Cannot copy entity of ID [{0}] from scene [{1}]. Does not exist!", sourceId, source.m_SceneName);
+            continue;
+        }
+        copiedIds.push_back(sourceId);
+    }
+
+    // Checked up front so the copy is either made whole or not at all
+    const size_t availableSlots = m_FreeEntityIndices.size() + (ENTITY_INDEX_MASK - m_NextEntityIndex);
+    if (copiedIds.size() > availableSlots)
+    {
+        TPS_CORE_CRITICAL("Max entity count reached! Cannot copy {0} entities from scene [{1}]", copiedIds.size(), source.m_SceneName);
+        return newIds;
+    }
+
+    // Each source name is interned once, entities are grouped by signature so storage is added a batch at a time
+    std::unordered_map<NameId, NameId> nameRemap;
+    std::unordered_map<ComponentSignature, std::vector<uint32_t>> positionsBySignature;
+    newIds.reserve(copiedIds.size());
+    m_EntityList.reserve(m_EntityList.size() + copiedIds.size());
+    for (uint32_t i = 0; i < copiedIds.size(); i++)
+    {
+        const uint32_t sourceId = copiedIds[i];
+        const uint32_t id = CreateEntityId();
+        newIds.push_back(id);
+        idMap[sourceId] = id;
+
+        auto [nameIt, bNewName] = nameRemap.try_emplace(source.GetEntityNameId(sourceId), INVALID_NAME_ID);
+        if (bNewName)
+        {
+            nameIt->second = m_NameTable.Intern(source.m_NameTable.GetString(nameIt->first));
+        }
+        SetEntityName(id, nameIt->second);
+
+        positionsBySignature[source.m_EntityComponents[GetEntityIndex(sourceId)]].push_back(i);
+    }
+
+    std::vector<uint32_t> groupIds;
+    for (const auto& [signature, positions] : positionsBySignature)
+    {
+        groupIds.clear();
+        for (uint32_t position : positions)
+        {
+            groupIds.push_back(newIds[position]);
+        }
+
+        // Tags only live in the signature
+        ComponentSignature dataComponents;
+        for (ComponentId componentId = 0; componentId < MAX_COMPONENTS; componentId++)
+        {
+            const ComponentTypeInfo& info = TPS_Private::ComponentRegistry::GetComponentTypeFromId(componentId);
+            if (signature.test(componentId) && !info.bTag)
+            {
+                dataComponents.set(componentId);
+                if (m_ArchetypeStorage)
+                {
+                    m_ArchetypeStorage->RegisterType(componentId, info.ops);
+                }
+            }
+        }
+
+        // Archetype rows are left unconstructed, pool components are default constructed and replaced
+        if (m_ArchetypeStorage)
+        {
+            m_ArchetypeStorage->AddEntities(groupIds, dataComponents);
+        }
+        for (ComponentId componentId = 0; componentId < MAX_COMPONENTS; componentId++)
+        {
+            if (!dataComponents.test(componentId))
+            {
+                continue;
+            }
+
+            const ComponentTypeInfo& info = TPS_Private::ComponentRegistry::GetComponentTypeFromId(componentId);
+            std::byte* poolComponents = nullptr;
+            if (!m_ArchetypeStorage)
+            {
+                poolComponents = static_cast<std::byte*>(GetOrCreateComponentPool(componentId, info.createPoolFunc)->AddDefaultComponents(groupIds));
+            }
+            for (uint32_t i = 0; i < positions.size(); i++)
+            {
+                const void* sourceComponent = source.GetComponentMemory(copiedIds[positions[i]], componentId);
+                void* component = nullptr;
+                if (poolComponents)
+                {
+                    component = poolComponents + i * info.ops.size;
+                    info.ops.destroy(component, 1);
+                }
+                else
+                {
+                    component = m_ArchetypeStorage->GetComponentMemory(groupIds[i], componentId);
+                }
+                info.ops.copyConstruct(component, sourceComponent, 1);
+            }
+        }
+
+        for (uint32_t id : groupIds)
+        {
+            m_EntityComponents[GetEntityIndex(id)] = signature;
+        }
+        OnEntitiesAdded(groupIds, signature);
+    }
+
+    // Parents still hold source IDs, the copies were stamped changed when they were added
+    const ComponentId hierarchyId = HierarchyComponent::GetId();
+    for (uint32_t id : newIds)
+    {
+        if (m_EntityComponents[GetEntityIndex(id)].test(hierarchyId))
+        {
+            HierarchyComponent* hierarchy = static_cast<HierarchyComponent*>(GetComponentMemory(id, hierarchyId));
+            auto parentIt = idMap.find(hierarchy->Parent);
+            hierarchy->Parent = parentIt != idMap.end() ? parentIt->second : INVALID_ENTITY_ID;
+        }
+    }
+
+    TPS_CORE_TRACE("Entities copied! From: [{0}] To: [{1}] Count: [{2}]", source.m_SceneName, m_SceneName, newIds.size());
+    return newIds;
+}
+
+void Tempus::Scene::SetEntityName(uint32_t id, NameId nameId)
+{
+    if (nameId >= m_EntitiesByName.size())
+    {
+        m_EntitiesByName.resize(nameId + 1);
+    }
+    const uint32_t index = GetEntityIndex(id);
+    m_EntityNameIds[index] = nameId;
+    m_EntityNamePositions[index] = static_cast<uint32_t>(m_EntitiesByName[nameId].size());
+    m_EntitiesByName[nameId].push_back(id);
+    m_EntityListChangeVersion = GetChangeVersion();
+}
+
+void Tempus::Scene::DestroyEntity(uint32_t id)
+{
+    const uint32_t index = GetEntityIndex(id);
     m_EntityCount--;
 
-    m_Entities.erase(id);
-    m_EntityNames.erase(id);
+    // Swap and pop to keep the alive entity list packed
+    const uint32_t listIndex = m_EntityListIndex[index];
+    const uint32_t lastEntity = m_EntityList.back();
+    m_EntityList[listIndex] = lastEntity;
+    m_EntityListIndex[GetEntityIndex(lastEntity)] = listIndex;
+    m_EntityList.pop_back();
+    m_EntityListIndex[index] = InvalidIndex;
+    m_bOrderedEntityListDirty = true;
 
-    // Remove all components from all pools for this entity
+    // Swap and pop out of the name index the same way
+    std::vector<uint32_t>& namedEntities = m_EntitiesByName[m_EntityNameIds[index]];
+    const uint32_t namePosition = m_EntityNamePositions[index];
+    namedEntities[namePosition] = namedEntities.back();
+    m_EntityNamePositions[GetEntityIndex(namedEntities[namePosition])] = namePosition;
+    namedEntities.pop_back();
+    m_EntityNameIds[index] = INVALID_NAME_ID;
+
+    const ComponentSignature oldSignature = m_EntityComponents[index];
+
+    // Remove the entity's components, only the pools it has a component in are touched
+    if (m_ArchetypeStorage)
+    {
+        m_ArchetypeStorage->RemoveEntity(id);
+    }
     for (auto& [componentId, pool] : m_ComponentPools)
     {
-        pool->RemoveComponent(id);
+        if (oldSignature.test(componentId))
+        {
+            pool->RemoveComponent(id);
+        }
     }
 
-    m_EntityComponents[id].reset();
-    
-    TPS_CORE_TRACE("Entity Removed! ID: [{0}]", id);
+    m_EntityComponents[index].reset();
+    OnEntitySignatureChanged(id, oldSignature);
+
+    // Invalidate every outstanding ID for this slot before it can be reused
+    m_EntityGenerations[index] = (m_EntityGenerations[index] + 1) & ENTITY_GENERATION_MASK;
+    m_FreeEntityIndices.push_back(index);
+}
+
+bool Tempus::Scene::SetParent(uint32_t childId, uint32_t parentId)
+{
+    if (!HasEntity(childId))
+    {
+        TPS_CORE_ERROR("Cannot set parent of entity [{0}]. Does not exist!", childId);
+        return false;
+    }
+
+    if (parentId != INVALID_ENTITY_ID)
+    {
+        if (!HasEntity(parentId))
+        {
+            TPS_CORE_ERROR("Cannot parent entity [{0}] to entity [{1}]. Parent does not exist!", childId, parentId);
+            return false;
+        }
+
+        // Walking up from the new parent must not reach the child, bounded in case of cycles written directly
+        uint32_t ancestor = parentId;
+        for (uint32_t depth = 0; ancestor != INVALID_ENTITY_ID && depth <= m_EntityCount; depth++, ancestor = GetParent(ancestor))
+        {
+            if (ancestor == childId)
+            {
+                TPS_CORE_ERROR("Cannot parent entity [{0}] to entity [{1}], it would create a cycle!", childId, parentId);
+                return false;
+            }
+        }
+    }
+
+    if (HierarchyComponent* hierarchy = GetComponent<HierarchyComponent>(childId))
+    {
+        if (hierarchy->Parent != parentId)
+        {
+            hierarchy->Parent = parentId;
+            MarkComponentChanged<HierarchyComponent>(childId);
+        }
+        return true;
+    }
+
+    return AddComponent<HierarchyComponent>(childId, parentId) != nullptr;
+}
+
+uint32_t Tempus::Scene::GetParent(uint32_t id)
+{
+    if (!HasComponent<HierarchyComponent>(id))
+    {
+        return INVALID_ENTITY_ID;
+    }
+    return GetComponent<HierarchyComponent>(id)->Parent;
 }
 
-std::string Tempus::Scene::GetEntityName(uint32_t id)
+std::string_view Tempus::Scene::GetEntityName(uint32_t id) const
 {
-    if (m_EntityNames.contains(id))
+    if (HasEntity(id))
     {
-        return m_EntityNames[id];
+        return m_NameTable.GetString(m_EntityNameIds[GetEntityIndex(id)]);
     }
 
     TPS_CORE_ERROR("Entity with ID [{0}] does not exist!", id);
-    return {};
+    return std::string_view("");
+}
+
+Tempus::NameId Tempus::Scene::GetEntityNameId(uint32_t id) const
+{
+    return HasEntity(id) ? m_EntityNameIds[GetEntityIndex(id)] : INVALID_NAME_ID;
+}
+
+std::span<const uint32_t> Tempus::Scene::FindEntitiesByName(std::string_view name) const
+{
+    const NameId nameId = m_NameTable.Find(name);
+    if (nameId == INVALID_NAME_ID)
+    {
+        return {};
+    }
+    return m_EntitiesByName[nameId];
+}
+
+std::vector<std::string_view> Tempus::Scene::GetEntityNames() const
+{
+    std::vector<std::string_view> names;
+    names.reserve(m_EntityList.size());
+    for (uint32_t id : GetEntityIDs())
+    {
+        names.push_back(GetEntityName(id));
+    }
+    return names;
 }
 
-bool Tempus::Scene::HasEntity(uint32_t id) const
+std::vector<uint32_t> Tempus::Scene::GetEntityIDs() const
 {
-    return m_Entities.contains(id);
+    std::vector<uint32_t> ids;
+    GetEntityIDs(ids);
+    return ids;
+}
+
+void Tempus::Scene::GetEntityIDs(std::vector<uint32_t>& outIds) const
+{
+    std::lock_guard lock(m_OrderedEntityListMutex);
+    if (m_bOrderedEntityListDirty)
+    {
+        // Walking the slots yields index order without sorting, every page below m_NextEntityIndex exists
+        m_OrderedEntityList.clear();
+        m_OrderedEntityList.reserve(m_EntityList.size());
+        for (uint32_t index = 0; index < m_NextEntityIndex; index++)
+        {
+            const uint32_t listIndex = m_EntityListIndex[index];
+            if (listIndex != InvalidIndex)
+            {
+                m_OrderedEntityList.push_back(m_EntityList[listIndex]);
+            }
+        }
+        m_bOrderedEntityListDirty = false;
+    }
+    outIds.assign(m_OrderedEntityList.begin(), m_OrderedEntityList.end());
 }
 
 bool Tempus::Scene::HasEntity(Entity e) const
 {
-    return m_Entities.contains(e.GetId());
+    return HasEntity(e.GetId());
+}
+
+Tempus::SceneCommandBuffer& Tempus::Scene::GetCommandBuffer()
+{
+    if (t_CachedCommandBuffer.sceneSerial == m_SceneSerial)
+    {
+        return *t_CachedCommandBuffer.buffer;
+    }
+
+    std::lock_guard lock(m_CommandBufferMutex);
+
+    const std::thread::id threadId = std::this_thread::get_id();
+    auto it = std::ranges::find_if(m_CommandBuffers, [threadId](const auto& pair) { return pair.first == threadId; });
+    if (it == m_CommandBuffers.end())
+    {
+        m_CommandBuffers.emplace_back(threadId, std::make_unique<SceneCommandBuffer>());
+        it = std::prev(m_CommandBuffers.end());
+    }
+
+    t_CachedCommandBuffer = { m_SceneSerial, it->second.get() };
+    return *it->second;
+}
+
+void Tempus::Scene::PlaybackCommandBuffers()
+{
+    std::vector<SceneCommandBuffer*> buffers;
+    {
+        std::lock_guard lock(m_CommandBufferMutex);
+        for (auto& [threadId, buffer] : m_CommandBuffers)
+        {
+            if (!buffer->IsEmpty())
+            {
+                buffers.push_back(buffer.get());
+            }
+        }
+    }
+
+    if (buffers.empty())
+    {
+        return;
+    }
+
+    // Entity creation first so later commands can resolve their pending entities
+    for (SceneCommandBuffer* buffer : buffers)
+    {
+        buffer->m_ResolvedEntities.reserve(buffer->m_AddEntities.size());
+        for (std::string& name : buffer->m_AddEntities)
+        {
+            buffer->m_ResolvedEntities.push_back(AddEntity(std::move(name)).GetId());
+        }
+    }
+
+    // Component removals before additions so a remove and re-add of the same type replaces the component
+    std::vector<const SceneCommandBuffer::RemoveComponentCommand*> removals;
+    std::vector<SceneCommandBuffer::AddComponentCommand*> additions;
+    for (SceneCommandBuffer* buffer : buffers)
+    {
+        for (const SceneCommandBuffer::RemoveComponentCommand& command : buffer->m_RemoveComponents)
+        {
+            removals.push_back(&command);
+        }
+        for (SceneCommandBuffer::AddComponentCommand& command : buffer->m_AddComponents)
+        {
+            if (command.entity.bPending)
+            {
+                command.entity = { buffer->m_ResolvedEntities[command.entity.id], false };
+            }
+            additions.push_back(&command);
+        }
+    }
+
+    // Group by component type, stable so commands of the same type keep their recording order
+    std::ranges::stable_sort(removals, {}, &SceneCommandBuffer::RemoveComponentCommand::componentId);
+    for (size_t begin = 0; begin < removals.size();)
+    {
+        const ComponentId componentId = removals[begin]->componentId;
+        size_t end = begin + 1;
+        while (end < removals.size() && removals[end]->componentId == componentId)
+        {
+            end++;
+        }
+        RemoveComponentBatch(componentId, std::span(removals).subspan(begin, end - begin));
+        begin = end;
+    }
+
+    std::ranges::stable_sort(additions, {}, &SceneCommandBuffer::AddComponentCommand::componentId);
+    for (size_t begin = 0; begin < additions.size();)
+    {
+        const ComponentId componentId = additions[begin]->componentId;
+        size_t end = begin + 1;
+        while (end < additions.size() && additions[end]->componentId == componentId)
+        {
+            end++;
+        }
+        additions[begin]->applyBatch(*this, std::span(additions).subspan(begin, end - begin));
+        begin = end;
+    }
+
+    for (SceneCommandBuffer* buffer : buffers)
+    {
+        for (uint32_t id : buffer->m_RemoveEntities)
+        {
+            RemoveEntity(id);
+        }
+        buffer->Clear();
+    }
+
+    FlushComponentObservers();
+}
+
+void Tempus::Scene::RemoveComponentBatch(ComponentId componentId, std::span<const SceneCommandBuffer::RemoveComponentCommand* const> commands)
+{
+    // Tags have no pool, removing one only clears its signature bit
+    IComponentPool* pool = nullptr;
+    if (!m_ArchetypeStorage)
+    {
+        auto it = m_ComponentPools.find(componentId);
+        if (it != m_ComponentPools.end())
+        {
+            pool = it->second.get();
+        }
+    }
+
+    for (const SceneCommandBuffer::RemoveComponentCommand* command : commands)
+    {
+        const uint32_t id = command->id;
+        if (!HasEntity(id) || !m_EntityComponents[GetEntityIndex(id)].test(componentId))
+        {
+            TPS_CORE_ERROR("Cannot remove deferred component [{1}] from entity [{0}], component not found!", id, componentId);
+            continue;
+        }
+
+        if (m_ArchetypeStorage)
+        {
+            m_ArchetypeStorage->RemoveComponent(id, componentId);
+        }
+        else if (pool)
+        {
+            pool->RemoveComponent(id);
+        }
+
+        const ComponentSignature oldSignature = m_EntityComponents[GetEntityIndex(id)];
+        m_EntityComponents[GetEntityIndex(id)].reset(componentId);
+        OnEntitySignatureChanged(id, oldSignature);
+    }
+}
+
+size_t Tempus::Scene::GetComponentMemoryUsage() const
+{
+    size_t bytes = m_ArchetypeStorage ? m_ArchetypeStorage->GetMemoryUsage() : 0;
+    for (const auto& [componentId, pool] : m_ComponentPools)
+    {
+        bytes += pool->GetMemoryUsage();
+    }
+    for (const auto& [signature, cache] : m_ViewCaches)
+    {
+        bytes += cache->GetMemoryUsage();
+    }
+    return bytes;
+}
+
+Tempus::IComponentPool* Tempus::Scene::GetOrCreateComponentPool(ComponentId componentId, std::unique_ptr<IComponentPool> (*createPool)())
+{
+    std::unique_ptr<IComponentPool>& poolSlot = m_ComponentPools[componentId];
+    if (!poolSlot)
+    {
+        poolSlot = createPool();
+        poolSlot->SetChangeVersionSource(&m_ChangeVersion);
+    }
+    return poolSlot.get();
+}
+
+void* Tempus::Scene::GetComponentMemory(uint32_t id, ComponentId componentId)
+{
+    if (!HasEntity(id) || !m_EntityComponents[GetEntityIndex(id)].test(componentId))
+    {
+        return nullptr;
+    }
+    if (m_ArchetypeStorage)
+    {
+        return m_ArchetypeStorage->GetComponentMemory(id, componentId);
+    }
+    auto it = m_ComponentPools.find(componentId);
+    return it != m_ComponentPools.end() ? it->second->GetComponentMemory(id) : nullptr;
+}
+
+Tempus::SceneViewCache& Tempus::Scene::GetOrCreateViewCache(const ComponentSignature& signature)
+{
+    {
+        std::shared_lock lock(m_ViewCacheMutex);
+        auto it = m_ViewCaches.find(signature);
+        if (it != m_ViewCaches.end())
+        {
+            return *it->second;
+        }
+    }
+
+    // Another system may have created the cache between the two locks
+    std::unique_lock lock(m_ViewCacheMutex);
+    auto it = m_ViewCaches.find(signature);
+    if (it != m_ViewCaches.end())
+    {
+        return *it->second;
+    }
+
+    // First request for this signature, populate from the current entities
+    auto cache = std::make_unique<SceneViewCache>(signature);
+    for (uint32_t id : m_EntityList)
+    {
+        if (cache->Matches(m_EntityComponents[GetEntityIndex(id)]))
+        {
+            cache->AddEntity(id);
+        }
+    }
+
+    // Follow storage order so iterating the new view walks component memory sequentially
+    std::vector<uint32_t> storageOrder;
+    cache->Reorder(GetStorageOrder(signature, storageOrder));
+
+    TPS_CORE_TRACE("Scene view cache created! Signature: [{0}] Entities: [{1}]", signature.to_string(), cache->GetSize());
+    auto [newIt, inserted] = m_ViewCaches.emplace(signature, std::move(cache));
+    return *newIt->second;
+}
+
+void Tempus::Scene::OnEntitySignatureChanged(uint32_t id, const ComponentSignature& oldSignature)
+{
+    m_EntityListChangeVersion = GetChangeVersion();
+
+    const ComponentSignature& newSignature = m_EntityComponents[GetEntityIndex(id)];
+    for (auto& [signature, cache] : m_ViewCaches)
+    {
+        cache->OnSignatureChanged(id, oldSignature, newSignature);
+    }
+
+    const ComponentSignature observedChanges = (oldSignature ^ newSignature) & m_ObservedComponents;
+    if (observedChanges.none())
+    {
+        return;
+    }
+
+    for (ComponentId componentId = 0; componentId < MAX_COMPONENTS; componentId++)
+    {
+        if (observedChanges.test(componentId))
+        {
+            m_ComponentObservers[componentId].pendingChanges.push_back({ id, newSignature.test(componentId) });
+        }
+    }
+    m_PendingObservedComponents |= observedChanges;
+}
+
+std::span<const uint32_t> Tempus::Scene::GetStorageOrder(const ComponentSignature& components, std::vector<uint32_t>& outScratch) const
+{
+    if (m_ArchetypeStorage)
+    {
+        outScratch.clear();
+        m_ArchetypeStorage->ForEachArchetype(components, [&outScratch](Archetype& archetype)
+        {
+            for (uint32_t chunk = 0; chunk < archetype.GetChunkCount(); chunk++)
+            {
+                const uint32_t* entities = archetype.GetEntities(chunk);
+                outScratch.insert(outScratch.end(), entities, entities + archetype.GetChunk(chunk).count);
+            }
+        });
+        return outScratch;
+    }
+
+    const IComponentPool* smallestPool = nullptr;
+    for (const auto& [componentId, pool] : m_ComponentPools)
+    {
+        if (components.test(componentId) && (!smallestPool || pool->GetSize() < smallestPool->GetSize()))
+        {
+            smallestPool = pool.get();
+        }
+    }
+    return smallestPool ? smallestPool->GetEntityIds() : std::span<const uint32_t>();
+}
+
+void Tempus::Scene::OnComponentStorageReordered(ComponentId componentId)
+{
+    ComponentSignature component;
+    component.set(componentId);
+
+    std::vector<uint32_t> storageOrder;
+    std::span<const uint32_t> order;
+    for (auto& [signature, cache] : m_ViewCaches)
+    {
+        if (signature.test(componentId))
+        {
+            if (order.empty())
+            {
+                order = GetStorageOrder(component, storageOrder);
+            }
+            cache->Reorder(order);
+        }
+    }
+}
+
+void Tempus::Scene::UpdateIncrementalSorts()
+{
+    if (m_SortingComponents.none())
+    {
+        return;
+    }
+
+    for (auto& [componentId, pool] : m_ComponentPools)
+    {
+        if (!m_SortingComponents.test(componentId))
+        {
+            continue;
+        }
+
+        // A pool stops sorting on its own when one of its components is removed
+        if (!pool->IsSorting())
+        {
+            m_SortingComponents.reset(componentId);
+            continue;
+        }
+
+        if (pool->ContinueSort(m_SortMovesPerUpdate[componentId]))
+        {
+            m_SortingComponents.reset(componentId);
+            OnComponentStorageReordered(componentId);
+        }
+    }
+}
+
+uint32_t Tempus::Scene::AddComponentObserver(ComponentId componentId, bool bOnAdded, ComponentObserverFunc func)
+{
+    if (m_bFlushingObservers)
+    {
+        TPS_CORE_ERROR("Cannot add a component observer while observers are being notified!");
+        return 0;
+    }
+
+    ComponentObservers& observers = m_ComponentObservers[componentId];
+    const uint32_t observerId = m_NextObserverId++;
+    (bOnAdded ? observers.onAdded : observers.onRemoved).push_back({ observerId, std::move(func) });
+    m_ObservedComponents.set(componentId);
+    return observerId;
+}
+
+void Tempus::Scene::RemoveComponentObserver(uint32_t observerId)
+{
+    if (m_bFlushingObservers)
+    {
+        TPS_CORE_ERROR("Cannot remove component observer [{0}] while observers are being notified!", observerId);
+        return;
+    }
+
+    for (ComponentId componentId = 0; componentId < MAX_COMPONENTS; componentId++)
+    {
+        ComponentObservers& observers = m_ComponentObservers[componentId];
+        const size_t erased = std::erase_if(observers.onAdded, [observerId](const ComponentObserver& observer) { return observer.id == observerId; })
+            + std::erase_if(observers.onRemoved, [observerId](const ComponentObserver& observer) { return observer.id == observerId; });
+        if (erased == 0)
+        {
+            continue;
+        }
+
+        if (observers.onAdded.empty() && observers.onRemoved.empty())
+        {
+            m_ObservedComponents.reset(componentId);
+            m_PendingObservedComponents.reset(componentId);
+            observers.pendingChanges.clear();
+        }
+        return;
+    }
+
+    TPS_CORE_WARN("Component observer [{0}] does not exist!", observerId);
+}
+
+void Tempus::Scene::FlushComponentObservers()
+{
+    // Changes made by observers during a flush are picked up by the flush's next pass
+    if (m_bFlushingObservers)
+    {
+        return;
+    }
+    m_bFlushingObservers = true;
+
+    std::vector<ObservedChange> changes;
+    std::vector<uint32_t> addedEntities;
+    std::vector<uint32_t> removedEntities;
+    std::unordered_map<uint32_t, std::pair<bool, bool>> netChanges;
+
+    for (uint32_t pass = 0; m_PendingObservedComponents.any(); pass++)
+    {
+        if (pass == MaxObserverFlushPasses)
+        {
+            TPS_CORE_WARN("Component observers still making changes after {0} passes, remaining changes are delivered next flush", pass);
+            break;
+        }
+
+        const ComponentSignature pendingComponents = m_PendingObservedComponents;
+        m_PendingObservedComponents.reset();
+
+        for (ComponentId componentId = 0; componentId < MAX_COMPONENTS; componentId++)
+        {
+            if (!pendingComponents.test(componentId))
+            {
+                continue;
+            }
+
+            ComponentObservers& observers = m_ComponentObservers[componentId];
+            changes.clear();
+            changes.swap(observers.pendingChanges);
+
+            addedEntities.clear();
+            removedEntities.clear();
+
+            const bool bMixed = std::ranges::any_of(changes, [&changes](const ObservedChange& change) { return change.bAdded != changes.front().bAdded; });
+            if (!bMixed)
+            {
+                // A component can only be added to or removed from an entity once without the opposite change in between
+                for (const ObservedChange& change : changes)
+                {
+                    (change.bAdded ? addedEntities : removedEntities).push_back(change.entityId);
+                }
+            }
+            else
+            {
+                // Changes to one entity alternate, so the first says whether it had the component before the phase
+                // and the last whether it has it now
+                netChanges.clear();
+                for (const ObservedChange& change : changes)
+                {
+                    auto it = netChanges.try_emplace(change.entityId, change.bAdded, change.bAdded).first;
+                    it->second.second = change.bAdded;
+                }
+                for (const ObservedChange& change : changes)
+                {
+                    auto it = netChanges.find(change.entityId);
+                    if (it == netChanges.end())
+                    {
+                        continue;
+                    }
+
+                    const auto [bFirstAdded, bLastAdded] = it->second;
+                    if (!bFirstAdded)
+                    {
+                        removedEntities.push_back(change.entityId);
+                    }
+                    if (bLastAdded)
+                    {
+                        addedEntities.push_back(change.entityId);
+                    }
+                    netChanges.erase(it);
+                }
+            }
+
+            if (!removedEntities.empty())
+            {
+                for (const ComponentObserver& observer : observers.onRemoved)
+                {
+                    observer.func(this, removedEntities);
+                }
+            }
+            if (!addedEntities.empty())
+            {
+                for (const ComponentObserver& observer : observers.onAdded)
+                {
+                    observer.func(this, addedEntities);
+                }
+            }
+        }
+    }
+
+    m_bFlushingObservers = false;
 }
@@ -3,103 +3,185 @@
 #pragma once
 
 #include "Core.h"
-#include <queue>
+#include "ComponentPool.h"
+#include "NameTable.h"
+#include "PagedArray.h"
+#include "Prefab.h"
+#include "ArchetypeStorage.h"
+#include "SceneView.h"
+#include "SceneCommandBuffer.h"
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <bitset>
+#include <functional>
 #include <map>
 #include <set>
 #include <string>
+#include <string_view>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
+#include <thread>
+#include <tuple>
+#include <limits>
+#include <unordered_map>
 #include "Log.h"
 #include "Systems/System.h"
+#include "Systems/SystemScheduler.h"
 #include "Utils/TempusUtils.h"
 
+namespace TPS_Private
+{
+    // Whether T is listed in EngineComponentTypes. Defined in Components/ComponentTypeTable.h, which every source file
+    // that adds components to a scene must include.
+    template<Tempus::ValidComponent T>
+    consteval bool IsListedComponentType();
+}
+
 namespace Tempus
 {
     using ComponentSignature = std::bitset<MAX_COMPONENTS>;
 
-    // Base class for type-erased component pools
-    class IComponentPool
+    // How a scene lays out its component data in memory
+    enum class SceneStorageMode : uint8_t
     {
-    public:
-        virtual ~IComponentPool() = default;
-        virtual void RemoveComponent(uint32_t entityId) = 0;
+        // One sparse set pool per component type
+        ComponentPools,
+        // Entities grouped by component signature into SoA chunks
+        Archetypes
     };
 
-    // Templated component pool that stores components of a specific type
-    template<ValidComponent T>
-    class ComponentPool : public IComponentPool
+    // Display name for logs and editor windows
+    constexpr const char* GetStorageModeName(SceneStorageMode storageMode)
+    {
+        return storageMode == SceneStorageMode::Archetypes ? "Archetypes" : "Component Pools";
+    }
+
+    class Scene;
+    class TransformSystem;
+
+    // Receives the entities a component type was added to or removed from since the last delivery
+    using ComponentObserverFunc = std::function<void(Scene* scene, std::span<const uint32_t> entityIds)>;
+
+    class TEMPUS_API Scene : public IUpdateable
     {
     public:
-        ComponentPool()
-        {
-            // Initialize all optionals as empty
-            m_ComponentArray.fill(std::nullopt);
-        }
 
-        template<typename... Args>
-        T* AddComponent(uint32_t entityId, Args&&... args)
+        Scene(std::string sceneName, SceneStorageMode storageMode = SceneStorageMode::ComponentPools);
+        ~Scene() = default;
+        
+        class Entity AddEntity(std::string_view name);
+        void RemoveEntity(uint32_t id);
+
+        // Creates count entities sharing one name, each given a copy of every component passed in.
+        // IDs are reserved in bulk, each component type is appended to its storage as one contiguous range,
+        // view caches and observers are updated once per batch and a single line is logged.
+        // Returns the new IDs in creation order, or nothing if the scene can't hold that many more entities.
+        template<ValidComponent... Ts>
+        std::vector<uint32_t> SpawnBatch(uint32_t count, std::string_view name, const Ts&... components)
         {
-            // By this point the Scene class should have already checked for the component existence, checking again for safety
-            if (!m_ComponentArray[entityId].has_value())
+            TPS_STATIC_ASSERT(AreComponentsUnique<Ts...>(), "SpawnBatch component types must be unique");
+            TPS_STATIC_ASSERT((TPS_Private::IsListedComponentType<Ts>() && ...), "Component types must be listed in EngineComponentTypes, see Components/ComponentTypeTable.h");
+
+            std::vector<uint32_t> ids = CreateEntityBatch(count, name);
+            if (ids.empty())
             {
-                m_ComponentArray[entityId].emplace(std::forward<Args>(args)...);
-                return &m_ComponentArray[entityId].value();
+                return ids;
             }
-            TPS_ERROR("Component already exists for entity [{0}]!", entityId);
-            return nullptr;
-        }
 
-        void RemoveComponent(uint32_t entityId) override
-        {
-            if (entityId < MAX_ENTITIES)
+            if (m_ArchetypeStorage)
             {
-                m_ComponentArray[entityId].reset();
+                m_ArchetypeStorage->AddEntities(std::span<const uint32_t>(ids), components...);
             }
-        }
-
-        T* GetComponent(uint32_t entityId)
-        {
-            if (entityId < MAX_ENTITIES && m_ComponentArray[entityId].has_value())
+            else
             {
-                return &m_ComponentArray[entityId].value();
+                (AddComponentsToPool(ids, components), ...);
             }
-            return nullptr;
+
+            ComponentSignature signature;
+            (signature.set(Ts::GetId()), ...);
+            OnEntityBatchCreated(ids, signature, name);
+            return ids;
         }
 
-        bool HasComponent(uint32_t entityId) const
+        // Creates count instances of the prefab named after it in a single SpawnBatch()
+        template<ValidComponent... Ts>
+        std::vector<uint32_t> Instantiate(const Prefab<Ts...>& prefab, uint32_t count = 1)
         {
-            return entityId < MAX_ENTITIES && m_ComponentArray[entityId].has_value();
+            return std::apply([this, &prefab, count](const Ts&... prototypes)
+            {
+                return SpawnBatch(count, prefab.GetName(), prototypes...);
+            }, prefab.GetPrototypes());
         }
 
-    private:
-
-        // @TODO This is poor for memory usage, this will be converted to a more efficient structure later
-        std::array<std::optional<T>, MAX_ENTITIES> m_ComponentArray;
-    };
-    
-    class TEMPUS_API Scene : public IUpdateable
-    {
-    public:
+        // Removes every entity in the span, IDs that don't exist are skipped. Logs a single line.
+        void DespawnBatch(std::span<const uint32_t> ids);
+        void DespawnBatch(std::span<const class Entity> entities);
 
-        Scene(std::string sceneName);
-        ~Scene() = default;
-        
-        class Entity AddEntity(std::string name);
-        void RemoveEntity(uint32_t id);
+        // Sorted by entity index so editor listings keep a stable order. The order is rebuilt only after entities were
+        // added or removed, other calls copy it.
+        std::vector<uint32_t> GetEntityIDs() const;
+        // Same as above, reusing the vector's storage so per frame listings don't allocate
+        void GetEntityIDs(std::vector<uint32_t>& outIds) const;
 
-        std::vector<uint32_t> GetEntityIDs() { return std::vector(m_Entities.begin(), m_Entities.end()); }
-        std::string GetEntityName(uint32_t id);
+        // Names are interned, the view's data is null terminated and stays valid for the lifetime of the scene
+        std::string_view GetEntityName(uint32_t id) const;
+        NameId GetEntityNameId(uint32_t id) const;
+        // Every entity with exactly this name, in no particular order. Valid until an entity is added or removed.
+        std::span<const uint32_t> FindEntitiesByName(std::string_view name) const;
+        const NameTable& GetNameTable() const { return m_NameTable; }
         uint32_t GetEntityCount() const { return m_EntityCount; }
-        bool HasEntity(uint32_t id) const;
         bool HasEntity(Entity e) const;
+
+        // O(1), IDs of removed entities are rejected even after their slot has been reused
+        bool HasEntity(uint32_t id) const
+        {
+            const uint32_t index = GetEntityIndex(id);
+            return index < m_NextEntityIndex && m_EntityListIndex[index] != InvalidIndex && m_EntityGenerations[index] == GetEntityGeneration(id);
+        }
         const std::string& GetName() const { return m_SceneName; }
         double GetSceneTime() const { return m_SceneTime; }
+        // Unique for the lifetime of the program, unlike the scene's address
+        uint64_t GetSceneSerial() const { return m_SceneSerial; }
+
+        // Components are stamped with the current change version when they are added or marked changed
+        uint32_t GetChangeVersion() const { return m_ChangeVersion.load(std::memory_order_relaxed); }
+
+        // Returns the current change version and moves on to the next, so every write made before the call has a
+        // version <= the returned value and every write after it a greater one. Incremental consumers call it each
+        // time they run and pass the value from their previous run to View<Ts...>().Changed<T>():
+        //
+        // const uint32_t lastVersion = m_LastVersion;
+        // m_LastVersion = scene->AdvanceChangeVersion();
+        // scene->View<TransformComponent>().Changed<TransformComponent>(lastVersion).Each(...);
+        uint32_t AdvanceChangeVersion() { return m_ChangeVersion.fetch_add(1, std::memory_order_relaxed); }
+        // Change version at which an entity was last created, destroyed, renamed or had its signature changed
+        uint32_t GetEntityListChangeVersion() const { return m_EntityListChangeVersion; }
+        SceneStorageMode GetStorageMode() const { return m_StorageMode; }
+
+        // Independent copy of the scene with the same entity IDs, names, components and change versions, used to keep
+        // the edited state of a scene around during a play session. Entity data and view caches are copied as whole
+        // arrays and every pool or archetype chunk in bulk, so the cost is a few memcpys per component type rather
+        // than one AddComponent() per entity. The clone gets the core systems of a new scene, which rebuild their
+        // derived state on its first update. Deferred commands that haven't been played back aren't copied.
+        std::unique_ptr<Scene> Clone() const;
         
+        // Copies entities of another scene into this one under new IDs, keeping their names, components and tags.
+        // Entities sharing a signature are created and stored as one batch, so copying a loaded chunk of a world costs
+        // about as much as spawning it. Every copied source ID is added to idMap with its new ID and HierarchyComponent
+        // parents are looked up in it, so hierarchies survive as long as parents are copied before their children,
+        // in this call or an earlier one with the same map. Parents missing from the map leave the copy a root.
+        // Source IDs that don't exist are skipped. Returns the new IDs in the order of sourceIds.
+        std::vector<uint32_t> CopyEntities(Scene& source, std::span<const uint32_t> sourceIds, std::unordered_map<uint32_t, uint32_t>& idMap);
+
         template<ValidComponent T, typename ...Args>
         T* AddComponent(uint32_t id, Args&&... arguments)
         {
-            if (!m_Entities.contains(id))
+            TPS_STATIC_ASSERT(TPS_Private::IsListedComponentType<T>(), "Component types must be listed in EngineComponentTypes, see Components/ComponentTypeTable.h");
+
+            if (!HasEntity(id))
             {
                 TPS_ERROR("Entity of ID [{0}] does not exist!", id);
                 return nullptr;
@@ -108,69 +190,113 @@ namespace Tempus
             ComponentId componentId = T::GetId();
 
             // Check if the entity already has the component
-            if (m_EntityComponents[id].test(componentId))
+            if (m_EntityComponents[GetEntityIndex(id)].test(componentId))
             {
                 TPS_ERROR("{1} already exists for entity [{0}]!", id, TempusUtils::GetClassDebugName<T>());
                 return nullptr;
             }
             
-            // Create pool if it doesn't exist
-            if (!m_ComponentPools.contains(componentId))
+            T* component = nullptr;
+            if constexpr (TagComponent<T>)
             {
-                m_ComponentPools[componentId] = std::make_unique<ComponentPool<T>>();
+                component = &GetTagInstance<T>();
+            }
+            else if (m_ArchetypeStorage)
+            {
+                component = m_ArchetypeStorage->AddComponent<T>(id, std::forward<Args>(arguments)...);
+            }
+            else
+            {
+                component = GetOrCreateComponentPool<T>()->AddComponent(id, std::forward<Args>(arguments)...);
             }
-
-            // Add component to the pool
-            auto* pool = static_cast<ComponentPool<T>*>(m_ComponentPools[componentId].get());
-            T* component = pool->AddComponent(id, std::forward<Args>(arguments)...);
             
             // Update signature
-            m_EntityComponents[id].set(componentId);
+            const ComponentSignature oldSignature = m_EntityComponents[GetEntityIndex(id)];
+            m_EntityComponents[GetEntityIndex(id)].set(componentId);
+            OnEntitySignatureChanged(id, oldSignature);
             
-            TPS_TRACE("{2} [{0}] added to entity [{1}]", componentId, m_EntityNames[id], TempusUtils::GetClassDebugName<T>());
+            TPS_TRACE("{2} [{0}] added to entity [{1}]", componentId, GetEntityName(id), TempusUtils::GetClassDebugName<T>());
             return component;
         }
         
-        std::vector<std::string> GetEntityNames() const
-        {
-            std::vector<std::string> names;
-            for (const auto& pair: m_EntityNames)
-            {
-                names.push_back(pair.second);
-            }
-            return names;
-        }
+        // In GetEntityIDs() order
+        std::vector<std::string_view> GetEntityNames() const;
 
         template<ValidComponent T>
         T* GetComponent(uint32_t id)
         {
-            if (!m_Entities.contains(id))
+            if (!HasEntity(id))
             {
                 TPS_ERROR("Entity of ID [{0}] does not exist!", id);
                 return nullptr;
             }
-            
-            ComponentId componentId = T::GetId();
-            
-            if (!m_ComponentPools.contains(componentId))
+
+            if constexpr (TagComponent<T>)
             {
-                return nullptr;
+                return HasComponent<T>(id) ? &GetTagInstance<T>() : nullptr;
             }
+            else
+            {
+                if (m_ArchetypeStorage)
+                {
+                    return m_ArchetypeStorage->GetComponent<T>(id);
+                }
 
-            auto* pool = static_cast<ComponentPool<T>*>(m_ComponentPools[componentId].get());
-            return pool->GetComponent(id);
+                ComponentId componentId = T::GetId();
+
+                if (!m_ComponentPools.contains(componentId))
+                {
+                    return nullptr;
+                }
+
+                auto* pool = static_cast<ComponentPool<T>*>(m_ComponentPools[componentId].get());
+                return pool->GetComponent(id);
+            }
+        }
+
+        // Same as GetComponent() but also marks the component as changed, use whenever the component will be written
+        template<ValidComponent T>
+        T* GetMutableComponent(uint32_t id)
+        {
+            T* component = GetComponent<T>(id);
+            if (component)
+            {
+                MarkComponentChanged<T>(id);
+            }
+            return component;
+        }
+
+        template<ValidComponent T>
+        void MarkComponentChanged(uint32_t id)
+        {
+            // Tags have no data to change
+            if constexpr (!TagComponent<T>)
+            {
+                if (m_ArchetypeStorage)
+                {
+                    m_ArchetypeStorage->MarkChanged(id, T::GetId());
+                }
+                else if (ComponentPool<T>* pool = GetComponentPool<T>())
+                {
+                    pool->MarkChanged(id);
+                }
+            }
         }
 
         template<ValidComponent T>
         bool HasComponent(uint32_t id)
         {
-            return m_EntityComponents[id].test(T::GetId());
+            return HasEntity(id) && m_EntityComponents[GetEntityIndex(id)].test(T::GetId());
         }
 
+        // Type-erased component access, nullptr for tags or if the entity doesn't have the component.
+        // Writes through it must be followed by a MarkComponentChanged() like any other.
+        void* GetComponentMemory(uint32_t id, ComponentId componentId);
+
         template<ValidComponent T>
         void RemoveComponent(uint32_t id)
         {
-            if (!m_Entities.contains(id))
+            if (!HasEntity(id))
             {
                 TPS_ERROR("Entity of ID [{0}] does not exist!", id);
                 return;
@@ -178,27 +304,250 @@ namespace Tempus
             
             if (!HasComponent<T>(id))
             {
-                TPS_ERROR("Cannot remove {1} from Entity [{0}], component not found!", m_EntityNames[id], TempusUtils::GetClassDebugName<T>());
+                TPS_ERROR("Cannot remove {1} from Entity [{0}], component not found!", GetEntityName(id), TempusUtils::GetClassDebugName<T>());
                 return;
             }
             
             ComponentId componentId = T::GetId();
-            
-            if (m_ComponentPools.contains(componentId))
+
+            const ComponentSignature oldSignature = m_EntityComponents[GetEntityIndex(id)];
+
+            // Tags only live in the signature
+            if constexpr (!TagComponent<T>)
             {
-                auto* pool = static_cast<ComponentPool<T>*>(m_ComponentPools[componentId].get());
-                pool->RemoveComponent(id);
-                m_EntityComponents[id].reset(componentId);
-                
-                TPS_TRACE("{2} [{0}] removed from entity [{1}]", componentId, m_EntityNames[id], TempusUtils::GetClassDebugName<T>());
+                if (m_ArchetypeStorage)
+                {
+                    m_ArchetypeStorage->RemoveComponent(id, componentId);
+                }
+                else if (ComponentPool<T>* pool = GetComponentPool<T>())
+                {
+                    pool->RemoveComponent(id);
+                }
+                else
+                {
+                    return;
+                }
             }
+
+            m_EntityComponents[GetEntityIndex(id)].reset(componentId);
+            OnEntitySignatureChanged(id, oldSignature);
+            
+            TPS_TRACE("{2} [{0}] removed from entity [{1}]", componentId, GetEntityName(id), TempusUtils::GetClassDebugName<T>());
         }
         
         ComponentId GetComponentCount(uint32_t id) const
         {
-            return static_cast<ComponentId>(m_EntityComponents[id].count());
+            if (!HasEntity(id))
+            {
+                TPS_ERROR("Entity of ID [{0}] does not exist!", id);
+                return 0;
+            }
+
+            return static_cast<ComponentId>(m_EntityComponents[GetEntityIndex(id)].count());
+        }
+
+        // Invokes func(entityId, Ts&...) for every entity that has all of the given components.
+        // Adding or removing components while iterating is not allowed.
+        template<ValidComponent... Ts, typename Func>
+        void ForEach(Func&& func)
+        {
+            // Tags have no storage to drive iteration from, the cached view tracks them through the signature instead
+            if constexpr ((TagComponent<Ts> || ...))
+            {
+                View<Ts...>().Each(std::forward<Func>(func));
+            }
+            else
+            {
+                ComponentSignature required;
+                (required.set(Ts::GetId()), ...);
+
+                if (m_ArchetypeStorage)
+                {
+                    m_ArchetypeStorage->ForEachArchetype(required, [&func](Archetype& archetype)
+                    {
+                        for (uint32_t chunk = 0; chunk < archetype.GetChunkCount(); chunk++)
+                        {
+                            const uint32_t count = archetype.GetChunk(chunk).count;
+                            const uint32_t* entities = archetype.GetEntities(chunk);
+                            std::tuple<Ts*...> columns(static_cast<Ts*>(archetype.GetColumn(chunk, Ts::GetId()))...);
+                            for (uint32_t row = 0; row < count; row++)
+                            {
+                                func(entities[row], std::get<Ts*>(columns)[row]...);
+                            }
+                        }
+                    });
+                    return;
+                }
+
+                // Drive iteration from the smallest pool and look up the remaining components
+                IComponentPool* smallestPool = nullptr;
+                for (ComponentId componentId : { Ts::GetId()... })
+                {
+                    auto it = m_ComponentPools.find(componentId);
+                    if (it == m_ComponentPools.end())
+                    {
+                        return;
+                    }
+                    if (!smallestPool || it->second->GetSize() < smallestPool->GetSize())
+                    {
+                        smallestPool = it->second.get();
+                    }
+                }
+
+                std::tuple<ComponentPool<Ts>*...> pools(GetComponentPool<Ts>()...);
+                for (uint32_t entityId : smallestPool->GetEntityIds())
+                {
+                    if ((m_EntityComponents[GetEntityIndex(entityId)] & required) == required)
+                    {
+                        func(entityId, *std::get<ComponentPool<Ts>*>(pools)->GetComponent(entityId)...);
+                    }
+                }
+            }
+        }
+
+        // Cached view over every entity that has all of the given components.
+        // The matching entity list is built on first use and then kept up to date on every add/remove,
+        // so iterating costs O(matching entities) rather than O(total entities).
+        template<ValidComponent... Ts>
+        SceneView<Ts...> View()
+        {
+            ComponentSignature signature;
+            (signature.set(Ts::GetId()), ...);
+            return SceneView<Ts...>(&GetOrCreateViewCache(signature), m_ArchetypeStorage.get(), GetComponentPool<Ts>()...);
+        }
+
+        // Reorders T's storage into ascending keyFunc(const T&) order, so iterating it after churn from spawning and
+        // removing walks memory sequentially again. Views containing T are reordered to match, e.g. sorting
+        // StaticMeshComponent by mesh handle groups draws by mesh, or TransformComponent by
+        // TempusUtils::GetMortonCode() of its position lays transforms out in spatial order.
+        // In archetype mode each archetype containing T is sorted on its own.
+        template<ValidComponent T, typename KeyFunc>
+        void SortPool(KeyFunc&& keyFunc)
+        {
+            TPS_STATIC_ASSERT(!TagComponent<T>, "Tags have no storage to sort");
+
+            if (m_ArchetypeStorage)
+            {
+                m_ArchetypeStorage->Sort<T>(keyFunc);
+            }
+            else if (ComponentPool<T>* pool = GetComponentPool<T>())
+            {
+                pool->Sort(keyFunc);
+            }
+            else
+            {
+                return;
+            }
+
+            m_SortingComponents.reset(T::GetId());
+            OnComponentStorageReordered(T::GetId());
+        }
+
+        // Same order as SortPool(), amortized over scene updates by moving at most maxMovesPerUpdate components
+        // per update. Views containing T switch to the sorted order once the sort has finished.
+        // Removing a T before then cancels the sort. Archetype storage is sorted immediately.
+        template<ValidComponent T, typename KeyFunc>
+        void SortPoolIncremental(KeyFunc&& keyFunc, uint32_t maxMovesPerUpdate)
+        {
+            TPS_STATIC_ASSERT(!TagComponent<T>, "Tags have no storage to sort");
+
+            ComponentPool<T>* pool = GetComponentPool<T>();
+            if (m_ArchetypeStorage || !pool)
+            {
+                SortPool<T>(std::forward<KeyFunc>(keyFunc));
+                return;
+            }
+
+            pool->BeginSort(keyFunc);
+            m_SortingComponents.set(T::GetId());
+            m_SortMovesPerUpdate[T::GetId()] = std::max(maxMovesPerUpdate, 1u);
+        }
+
+        // Whether an incremental sort of T is still in progress
+        template<ValidComponent T>
+        bool IsSortingPool() const
+        {
+            return m_SortingComponents.test(T::GetId());
+        }
+
+        // Direct access to the packed storage of a component type.
+        // Returns nullptr if no component of that type was ever added, if the scene uses archetype storage or if T is a tag.
+        template<ValidComponent T>
+        ComponentPool<T>* GetComponentPool()
+        {
+            if constexpr (TagComponent<T>)
+            {
+                return nullptr;
+            }
+            else
+            {
+                auto it = m_ComponentPools.find(T::GetId());
+                if (it == m_ComponentPools.end())
+                {
+                    return nullptr;
+                }
+                return static_cast<ComponentPool<T>*>(it->second.get());
+            }
         }
 
+        // Registers a system to be updated every frame. Systems are initialized when added.
+        template<typename T, typename... Args>
+        T* AddSystem(Args&&... arguments)
+        {
+            TPS_STATIC_ASSERT(std::derived_from<T, System>, "AddSystem requires a class derived from System");
+            auto system = std::make_unique<T>(std::forward<Args>(arguments)...);
+            T* systemPtr = system.get();
+            m_SystemScheduler.AddSystem(std::move(system), TempusUtils::GetClassDebugName<T>());
+            systemPtr->OnInit(this);
+            return systemPtr;
+        }
+
+        SystemScheduler& GetSystemScheduler() { return m_SystemScheduler; }
+        // Core system computing world matrices, always present
+        TransformSystem* GetTransformSystem() const { return m_TransformSystem; }
+
+        // Parents the child's transform to the parent's world transform, INVALID_ENTITY_ID detaches it.
+        // Adds a HierarchyComponent to the child if needed. Fails if the parent is the child or one of its descendants.
+        bool SetParent(uint32_t childId, uint32_t parentId);
+        // INVALID_ENTITY_ID if the entity has no parent
+        uint32_t GetParent(uint32_t id);
+
+        // Registers an observer that receives every entity T was added to, batched per structural change phase.
+        // Batches are delivered by FlushComponentObservers(), which the scene calls at the start of each update for
+        // changes made directly and again after command buffer playback. Within a batch an add followed by a remove
+        // of the same entity cancels out, and removal batches are delivered before addition batches.
+        // Returns an ID for RemoveComponentObserver().
+        template<ValidComponent T>
+        uint32_t OnComponentAdded(ComponentObserverFunc func)
+        {
+            return AddComponentObserver(T::GetId(), true, std::move(func));
+        }
+
+        // Registers an observer that receives every entity T was removed from, including removed entities.
+        // The component is already gone when the batch is delivered, so observers must keep any data they need.
+        template<ValidComponent T>
+        uint32_t OnComponentRemoved(ComponentObserverFunc func)
+        {
+            return AddComponentObserver(T::GetId(), false, std::move(func));
+        }
+
+        // Observers must not be added or removed from inside an observer callback
+        void RemoveComponentObserver(uint32_t observerId);
+
+        // Delivers pending component added and removed batches.
+        // Structural changes made by observers are delivered in the same flush.
+        void FlushComponentObservers();
+
+        // Command buffer owned by the calling thread, for structural changes made while the scene is being iterated.
+        // Recorded commands are applied by PlaybackCommandBuffers(), which the scene calls once its systems have updated.
+        SceneCommandBuffer& GetCommandBuffer();
+
+        // Applies and clears every thread's command buffer. Must not run while systems or views are iterating the scene.
+        void PlaybackCommandBuffers();
+
+        // Total heap memory used by component storage in bytes
+        size_t GetComponentMemoryUsage() const;
+
         // Deleting copy and move operations since Scene owns unique resources
         Scene(const Scene&) = delete;
         Scene& operator=(const Scene&) = delete;
@@ -208,27 +557,231 @@ namespace Tempus
     private:
 
         friend class SceneManager;
+        friend class SceneCommandBuffer;
+        friend class SceneSerializer;
+        friend class SceneSnapshot;
 
         void ResetSceneTime() { m_SceneTime = 0.0; }
 
         bool IsUpdating() const override { return true; }
         void OnUpdate(float DeltaTime) override;
+
+        SceneViewCache& GetOrCreateViewCache(const ComponentSignature& signature);
+        // Must be called after every change to an entity's signature, with the signature it had before the change
+        void OnEntitySignatureChanged(uint32_t id, const ComponentSignature& oldSignature);
+        // Entities in the order their components are stored: the smallest pool of the given components, or every
+        // archetype containing all of them. outScratch holds the list when it has to be gathered.
+        std::span<const uint32_t> GetStorageOrder(const ComponentSignature& components, std::vector<uint32_t>& outScratch) const;
+        // Brings every view cache containing the component into the order of its storage
+        void OnComponentStorageReordered(ComponentId componentId);
+        // Advances incremental pool sorts by one step each
+        void UpdateIncrementalSorts();
+
+        // Creates the pool on first use
+        template<ValidComponent T>
+        ComponentPool<T>* GetOrCreateComponentPool()
+        {
+            std::unique_ptr<IComponentPool>& poolSlot = m_ComponentPools[T::GetId()];
+            if (!poolSlot)
+            {
+                poolSlot = std::make_unique<ComponentPool<T>>();
+                poolSlot->SetChangeVersionSource(&m_ChangeVersion);
+            }
+            return static_cast<ComponentPool<T>*>(poolSlot.get());
+        }
+
+        // Type-erased GetOrCreateComponentPool(), createPool makes the pool if it doesn't exist yet
+        IComponentPool* GetOrCreateComponentPool(ComponentId componentId, std::unique_ptr<IComponentPool> (*createPool)());
+        // SpawnBatch() pool path, tags have no pool
+        template<ValidComponent T>
+        void AddComponentsToPool(std::span<const uint32_t> ids, const T& prototype)
+        {
+            if constexpr (!TagComponent<T>)
+            {
+                GetOrCreateComponentPool<T>()->AddComponents(ids, prototype);
+            }
+        }
+
+        template<ValidComponent... Ts>
+        static constexpr bool AreComponentsUnique()
+        {
+            const ComponentId ids[] = { Ts::GetId()..., 0 };
+            for (size_t i = 0; i < sizeof...(Ts); i++)
+            {
+                for (size_t j = i + 1; j < sizeof...(Ts); j++)
+                {
+                    if (ids[i] == ids[j])
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        // Takes a free slot, or the next unused one, and registers the entity as alive without a name or components
+        uint32_t CreateEntityId();
+        // Every ID of a SpawnBatch(), named but without components yet. Empty if the scene has too few slots left.
+        std::vector<uint32_t> CreateEntityBatch(uint32_t count, std::string_view name);
+        // Signature, view cache and observer updates for a batch of new entities that all received the same components
+        void OnEntityBatchCreated(std::span<const uint32_t> ids, const ComponentSignature& signature, std::string_view name);
+        // View cache and observer updates for new entities whose signature is already set
+        void OnEntitiesAdded(std::span<const uint32_t> ids, const ComponentSignature& signature);
+        // Recreates entities with the exact IDs, names and signatures they were saved with, so IDs stored in
+        // components stay valid. Only allowed in a scene that never had an entity, slots between the restored
+        // entities are left free. Component storage is left to the caller. Returns false if an ID is invalid or repeated.
+        bool RestoreEntities(std::span<const uint32_t> ids, std::span<const NameId> nameIds, std::span<const ComponentSignature> signatures);
+        void SetEntityName(uint32_t id, NameId nameId);
+        // RemoveEntity() without the validity check or log line
+        void DestroyEntity(uint32_t id);
+
+        uint32_t AddComponentObserver(ComponentId componentId, bool bOnAdded, ComponentObserverFunc func);
+
+        // Playback of a batch of deferred additions of one component type, the pool is looked up once for the whole batch
+        template<ValidComponent T>
+        void AddComponentBatch(std::span<SceneCommandBuffer::AddComponentCommand* const> commands)
+        {
+            TPS_STATIC_ASSERT(TPS_Private::IsListedComponentType<T>(), "Component types must be listed in EngineComponentTypes, see Components/ComponentTypeTable.h");
+
+            const ComponentId componentId = T::GetId();
+
+            ComponentPool<T>* pool = nullptr;
+            if constexpr (!TagComponent<T>)
+            {
+                if (!m_ArchetypeStorage)
+                {
+                    pool = GetOrCreateComponentPool<T>();
+                    pool->Reserve(pool->GetSize() + static_cast<uint32_t>(commands.size()));
+                }
+            }
+
+            for (SceneCommandBuffer::AddComponentCommand* command : commands)
+            {
+                const uint32_t id = command->entity.id;
+                if (!HasEntity(id))
+                {
+                    TPS_CORE_ERROR("Cannot add deferred {1} to entity [{0}], entity does not exist!", id, TempusUtils::GetClassDebugName<T>());
+                    continue;
+                }
+
+                ComponentSignature& signature = m_EntityComponents[GetEntityIndex(id)];
+                if (signature.test(componentId))
+                {
+                    TPS_CORE_ERROR("{1} already exists for entity [{0}]!", id, TempusUtils::GetClassDebugName<T>());
+                    continue;
+                }
+
+                if constexpr (!TagComponent<T>)
+                {
+                    T& component = *static_cast<T*>(command->payload);
+                    if (m_ArchetypeStorage)
+                    {
+                        m_ArchetypeStorage->AddComponent<T>(id, std::move(component));
+                    }
+                    else
+                    {
+                        pool->AddComponent(id, std::move(component));
+                    }
+                }
+
+                const ComponentSignature oldSignature = signature;
+                signature.set(componentId);
+                OnEntitySignatureChanged(id, oldSignature);
+            }
+        }
+
+        // Playback of a batch of deferred removals that all share one component type
+        void RemoveComponentBatch(ComponentId componentId, std::span<const SceneCommandBuffer::RemoveComponentCommand* const> commands);
         
-        std::queue<uint32_t> m_AvailableEntityIds;
-        std::array<ComponentSignature, MAX_ENTITIES> m_EntityComponents;
-        std::map<uint32_t, std::string> m_EntityNames;
-        std::set<uint32_t> m_Entities;
+        static constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+        // Per slot data, indexed by entity index. Pages are allocated as the slot count grows.
+        PagedArray<ComponentSignature> m_EntityComponents;
+        PagedArray<uint32_t> m_EntityGenerations;
+        // Position of the slot's entity in m_EntityList, InvalidIndex while the slot is free
+        PagedArray<uint32_t> m_EntityListIndex{ InvalidIndex };
+        // Packed IDs of every alive entity
+        std::vector<uint32_t> m_EntityList;
+        // m_EntityList by entity index for GetEntityIDs(), rebuilt on the first call after m_EntityList changed
+        mutable std::vector<uint32_t> m_OrderedEntityList;
+        mutable bool m_bOrderedEntityListDirty = true;
+        mutable std::mutex m_OrderedEntityListMutex;
+        // Freed slots are reused most recently freed first, while their data is still warm in cache
+        std::vector<uint32_t> m_FreeEntityIndices;
+        // Slots at or above this index have never been used
+        uint32_t m_NextEntityIndex = 0;
+        // Interned name of each slot's entity, and its position in that name's m_EntitiesByName list
+        PagedArray<NameId> m_EntityNameIds{ INVALID_NAME_ID };
+        PagedArray<uint32_t> m_EntityNamePositions;
+        NameTable m_NameTable;
+        // Alive entities of every interned name, indexed by name ID
+        std::vector<std::vector<uint32_t>> m_EntitiesByName;
         uint32_t m_EntityCount = 0;
 
-        // Component pools indexed by component ID
+        SceneStorageMode m_StorageMode = SceneStorageMode::ComponentPools;
+        // Component pools indexed by component ID, unused in archetype mode
         std::map<ComponentId, std::unique_ptr<IComponentPool>> m_ComponentPools;
+        // Only created in archetype mode
+        std::unique_ptr<ArchetypeStorage> m_ArchetypeStorage;
+        // View caches keyed by the signature they match, created on demand by View<Ts...>()
+        std::unordered_map<ComponentSignature, std::unique_ptr<SceneViewCache>> m_ViewCaches;
+        // Systems running in parallel can ask for a view at the same time, structural changes never run alongside them
+        std::shared_mutex m_ViewCacheMutex;
+        // Pools with an incremental sort in progress and how many components each moves per update
+        ComponentSignature m_SortingComponents;
+        std::array<uint32_t, MAX_COMPONENTS> m_SortMovesPerUpdate = {};
+
+        SystemScheduler m_SystemScheduler;
+        TransformSystem* m_TransformSystem = nullptr;
 
-        std::vector<std::unique_ptr<System>> m_Systems;
+        // One command buffer per thread that has asked for one, in creation order so playback order is stable
+        std::vector<std::pair<std::thread::id, std::unique_ptr<SceneCommandBuffer>>> m_CommandBuffers;
+        std::mutex m_CommandBufferMutex;
+        // Unique for the lifetime of the program, lets threads cache their buffer without risking a stale scene address
+        uint64_t m_SceneSerial = 0;
+
+        // Starts at 1 so a consumer that has never run can pass 0 to see everything
+        std::atomic<uint32_t> m_ChangeVersion = 1;
+        uint32_t m_EntityListChangeVersion = 0;
+
+        struct ComponentObserver
+        {
+            uint32_t id = 0;
+            ComponentObserverFunc func;
+        };
+
+        struct ObservedChange
+        {
+            uint32_t entityId = INVALID_ENTITY_ID;
+            bool bAdded = false;
+        };
+
+        struct ComponentObservers
+        {
+            std::vector<ComponentObserver> onAdded;
+            std::vector<ComponentObserver> onRemoved;
+            // Signature changes since the last flush in the order they happened
+            std::vector<ObservedChange> pendingChanges;
+        };
+
+        // Indexed by component ID
+        std::array<ComponentObservers, MAX_COMPONENTS> m_ComponentObservers;
+        // Component types with at least one observer, only their changes are recorded
+        ComponentSignature m_ObservedComponents;
+        // Component types with pending changes
+        ComponentSignature m_PendingObservedComponents;
+        uint32_t m_NextObserverId = 1;
+        bool m_bFlushingObservers = false;
         
         std::string m_SceneName;
 
         double m_SceneTime = 0.0;
         
     };
-    
+
+    template<ValidComponent T>
+    void SceneCommandBuffer::ApplyAddComponentBatch(Scene& scene, std::span<AddComponentCommand* const> commands)
+    {
+        scene.AddComponentBatch<T>(commands);
+    }
 }
@@ -0,0 +1,1254 @@
+// Copyright Levi Spevakow (C) 2025
+
+#include "SceneBenchmark.h"
+
+#include "Application.h"
+#include "AsyncSceneLoad.h"
+#include "SceneHistory.h"
+#include "SceneSerializer.h"
+#include "TransformKernelBenchmark.h"
+#include "WorldPartition.h"
+#include "Entity/Entity.h"
+#include "Components/ComponentTypeTable.h"
+#include "Components/EditorTagComponents.h"
+#include "Components/HierarchyComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/TransformComponent.h"
+#include "Components/WorldCellComponent.h"
+#include "Components/WorldTransformComponent.h"
+#include "Jobs/JobSystem.h"
+#include "Systems/TransformSystem.h"
+#include "Utils/TempusUtils.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <glm/glm.hpp>
+#include <memory>
+#include <limits>
+#include <map>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+
+namespace
+{
+    double ElapsedMs(std::chrono::high_resolution_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    // The transform system composes matrices with the SIMD kernels, which differ from glm by a few ulps
+    bool MatricesMatch(const std::vector<glm::mat4>& a, const std::vector<glm::mat4>& b)
+    {
+        if (a.size() != b.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); i++)
+        {
+            for (uint32_t column = 0; column < 4; column++)
+            {
+                for (uint32_t row = 0; row < 4; row++)
+                {
+                    if (std::abs(a[i][column][row] - b[i][column][row]) > Tempus::TransformKernelBenchmark::Tolerance * std::max(1.0f, std::abs(b[i][column][row])))
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    // The component pool before sparse sets, one optional per entity slot whether or not the entity has the component.
+    // Sized to the benchmarked entity count rather than the old fixed MAX_ENTITIES, and heap allocated to fit 100k slots.
+    template<typename T>
+    class OptionalComponentPool
+    {
+    public:
+
+        explicit OptionalComponentPool(uint32_t capacity) : m_ComponentArray(capacity) {}
+
+        T* AddComponent(uint32_t entityIndex, const T& component)
+        {
+            if (m_ComponentArray[entityIndex].has_value())
+            {
+                return nullptr;
+            }
+            return &m_ComponentArray[entityIndex].emplace(component);
+        }
+
+        void RemoveComponent(uint32_t entityIndex) { m_ComponentArray[entityIndex].reset(); }
+
+        T* GetComponent(uint32_t entityIndex) { return m_ComponentArray[entityIndex].has_value() ? &m_ComponentArray[entityIndex].value() : nullptr; }
+
+        template<typename Func>
+        void Each(Func&& func)
+        {
+            for (std::optional<T>& component : m_ComponentArray)
+            {
+                if (component.has_value())
+                {
+                    func(component.value());
+                }
+            }
+        }
+
+        size_t GetMemoryUsage() const { return m_ComponentArray.capacity() * sizeof(std::optional<T>); }
+
+    private:
+
+        std::vector<std::optional<T>> m_ComponentArray;
+    };
+
+    constexpr float SortBenchmarkCellSize = 16.0f;
+
+    uint64_t GetTransformSortKey(const Tempus::TransformComponent& transform)
+    {
+        return Tempus::TempusUtils::GetMortonCode(transform.Position, SortBenchmarkCellSize);
+    }
+
+    Tempus::SharedDataHandle GetMeshSortKey(const Tempus::StaticMeshComponent& mesh)
+    {
+        return mesh.GetMesh().GetHandle();
+    }
+
+    // Spawns entities with random positions and meshes, then each round respawns a random quarter of them and
+    // swaps the mesh of another quarter, leaving storage and view order shuffled the way a running game would.
+    // Deterministic for a given seed, including the entity IDs handed out.
+    void BuildChurnedScene(Tempus::Scene& scene, uint32_t entityCount, uint32_t churnRounds, uint32_t seed)
+    {
+        using namespace Tempus;
+
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<float> coordinate(-1000.0f, 1000.0f);
+
+        std::vector<StaticMeshComponent> meshes;
+        for (uint32_t i = 0; i < 32; i++)
+        {
+            meshes.emplace_back("Sort Benchmark Mesh " + std::to_string(i), "Sort Benchmark Texture");
+        }
+        auto randomMesh = [&meshes, &generator]() { return meshes[generator() % meshes.size()]; };
+
+        auto randomize = [&](std::span<const uint32_t> ids)
+        {
+            for (uint32_t id : ids)
+            {
+                scene.GetComponent<TransformComponent>(id)->Position = glm::vec3(coordinate(generator), coordinate(generator), coordinate(generator));
+                *scene.GetComponent<StaticMeshComponent>(id) = randomMesh();
+            }
+        };
+
+        // Views are created up front, the way systems and the renderer use them from the first frame, so they follow the churn
+        scene.View<TransformComponent, StaticMeshComponent>();
+        scene.View<StaticMeshComponent>();
+
+        std::vector<uint32_t> alive = scene.SpawnBatch(entityCount, "Entity", TransformComponent(), StaticMeshComponent());
+        randomize(alive);
+
+        const uint32_t churnCount = entityCount / 4;
+        for (uint32_t round = 0; round < churnRounds; round++)
+        {
+            std::shuffle(alive.begin(), alive.end(), generator);
+            scene.DespawnBatch(std::span<const uint32_t>(alive).last(churnCount));
+            alive.resize(alive.size() - churnCount);
+
+            const std::vector<uint32_t> spawned = scene.SpawnBatch(churnCount, "Entity", TransformComponent(), StaticMeshComponent());
+            randomize(spawned);
+            alive.insert(alive.end(), spawned.begin(), spawned.end());
+
+            std::shuffle(alive.begin(), alive.end(), generator);
+            for (uint32_t i = 0; i < churnCount; i++)
+            {
+                scene.RemoveComponent<StaticMeshComponent>(alive[i]);
+                scene.AddComponent<StaticMeshComponent>(alive[i], randomMesh());
+            }
+        }
+    }
+
+    // Average time of a pass over View<TransformComponent, StaticMeshComponent>() reading both components.
+    // The checksum is a sum of integers so it doesn't depend on iteration order.
+    double TimeMeshViewIteration(Tempus::Scene& scene, uint64_t& outChecksum)
+    {
+        using namespace Tempus;
+
+        constexpr uint32_t PassCount = 10;
+        uint64_t checksum = 0;
+        const auto start = std::chrono::high_resolution_clock::now();
+        for (uint32_t pass = 0; pass < PassCount; pass++)
+        {
+            scene.View<TransformComponent, StaticMeshComponent>().Each([&checksum](uint32_t entityId, TransformComponent& transform, StaticMeshComponent& mesh)
+            {
+                checksum += std::bit_cast<uint32_t>(transform.Position.x) + mesh.GetMesh().GetHandle();
+            });
+        }
+        outChecksum = checksum / PassCount;
+        return ElapsedMs(start) / PassCount;
+    }
+
+    // Whether consecutive entities of the view never decrease in key
+    template<Tempus::ValidComponent T, typename KeyFunc>
+    bool IsViewSorted(Tempus::Scene& scene, KeyFunc&& keyFunc)
+    {
+        auto view = scene.View<T>();
+        std::span<const uint32_t> ids = view.GetEntityIds();
+        for (size_t i = 1; i < ids.size(); i++)
+        {
+            if (keyFunc(view.template Get<T>(ids[i])) < keyFunc(view.template Get<T>(ids[i - 1])))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Whether every saved entity of the original exists in the loaded scene with the same name and components,
+    // and nothing else does. WorldTransformComponent isn't saved and is left out of the comparison.
+    // bKeepsUnsaved expects entities tagged EditorNoSerializeTag to exist in both, as they do in restored snapshots.
+    bool LoadedSceneMatches(Tempus::Scene& original, Tempus::Scene& loaded, bool bKeepsUnsaved = false)
+    {
+        using namespace Tempus;
+
+        uint32_t savedCount = 0;
+        for (uint32_t id : original.GetEntityIDs())
+        {
+            if (original.HasComponent<EditorNoSerializeTag>(id) && !bKeepsUnsaved)
+            {
+                if (loaded.HasEntity(id))
+                {
+                    return false;
+                }
+                continue;
+            }
+            savedCount++;
+
+            if (!loaded.HasEntity(id) || loaded.GetEntityName(id) != original.GetEntityName(id))
+            {
+                return false;
+            }
+
+            const TransformComponent* transform = original.GetComponent<TransformComponent>(id);
+            const TransformComponent* loadedTransform = loaded.GetComponent<TransformComponent>(id);
+            if (!transform != !loadedTransform || (transform && std::memcmp(transform, loadedTransform, sizeof(TransformComponent)) != 0))
+            {
+                return false;
+            }
+
+            const StaticMeshComponent* mesh = original.GetComponent<StaticMeshComponent>(id);
+            const StaticMeshComponent* loadedMesh = loaded.GetComponent<StaticMeshComponent>(id);
+            if (!mesh != !loadedMesh || (mesh && !(mesh->GetMesh() == loadedMesh->GetMesh())))
+            {
+                return false;
+            }
+
+            if (original.GetParent(id) != loaded.GetParent(id))
+            {
+                return false;
+            }
+        }
+        return loaded.GetEntityCount() == savedCount;
+    }
+
+    // Churned scene with hierarchies and a few editor only entities, the way a scene looks while being edited
+    std::unique_ptr<Tempus::Scene> BuildEditorScene(const std::string& name, Tempus::SceneStorageMode storageMode, uint32_t entityCount)
+    {
+        using namespace Tempus;
+
+        auto scene = std::make_unique<Scene>(name, storageMode);
+        BuildChurnedScene(*scene, entityCount, 1, 1234);
+        const std::vector<uint32_t> ids = scene->GetEntityIDs();
+        for (size_t i = 1; i < ids.size(); i += 64)
+        {
+            scene->SetParent(ids[i], ids[i - 1]);
+        }
+        for (size_t i = 0; i < ids.size(); i += 1024)
+        {
+            scene->AddComponent<EditorNoSerializeTag>(ids[i]);
+        }
+        scene->FlushComponentObservers();
+        return scene;
+    }
+
+    // Adds a copy of the source entity's T to the target entity if it has one
+    template<Tempus::ValidComponent T>
+    void CopyComponent(Tempus::Scene& source, uint32_t sourceId, Tempus::Scene& target, uint32_t targetId)
+    {
+        if (const T* component = source.GetComponent<T>(sourceId))
+        {
+            target.AddComponent<T>(targetId, *component);
+        }
+    }
+}
+
+std::vector<Tempus::SceneBenchmark::Result> Tempus::SceneBenchmark::Run(const std::vector<uint32_t>& entityCounts)
+{
+    std::vector<Result> results;
+
+    for (SceneStorageMode storageMode : { SceneStorageMode::ComponentPools, SceneStorageMode::Archetypes })
+    {
+        for (uint32_t entityCount : entityCounts)
+        {
+            Result result;
+            result.storageMode = storageMode;
+            result.entityCount = entityCount;
+
+            auto start = std::chrono::high_resolution_clock::now();
+            auto scene = std::make_unique<Scene>("Benchmark Scene", storageMode);
+            for (uint32_t i = 0; i < entityCount; i++)
+            {
+                Entity entity = scene->AddEntity("Entity");
+                const float f = static_cast<float>(i);
+                entity.AddComponent<TransformComponent>(glm::vec3(f, f * 0.5f, -f));
+                entity.AddComponent<StaticMeshComponent>();
+            }
+            result.createMs = ElapsedMs(start);
+            result.nsPerEntity = entityCount > 0 ? result.createMs * 1'000'000.0 / entityCount : 0.0;
+
+            // Accumulated so the loop can't be optimized away
+            float positionSum = 0.0f;
+            start = std::chrono::high_resolution_clock::now();
+            scene->View<TransformComponent, StaticMeshComponent>().Each([&positionSum](uint32_t entityId, TransformComponent& transform, StaticMeshComponent& mesh)
+            {
+                positionSum += transform.Position.x;
+            });
+            result.iterateMs = ElapsedMs(start);
+
+            result.componentMemoryBytes = scene->GetComponentMemoryUsage();
+
+            start = std::chrono::high_resolution_clock::now();
+            scene.reset();
+            result.destroyMs = ElapsedMs(start);
+
+            TPS_CORE_INFO("Scene benchmark | {0} | {1} entities | Create: {2:.2f} ms ({3:.0f} ns/entity) | Iterate: {4:.3f} ms | Destroy: {5:.2f} ms | Components: {6:.2f} MB | Checksum: {7}",
+                GetStorageModeName(storageMode), entityCount, result.createMs, result.nsPerEntity, result.iterateMs, result.destroyMs,
+                static_cast<double>(result.componentMemoryBytes) / (1024.0 * 1024.0), positionSum);
+            results.push_back(result);
+        }
+    }
+
+    return results;
+}
+
+std::vector<Tempus::SceneBenchmark::ComponentPoolResult> Tempus::SceneBenchmark::RunComponentPool(const std::vector<uint32_t>& entityCounts, float componentPercent)
+{
+    std::vector<ComponentPoolResult> results;
+
+    for (uint32_t entityCount : entityCounts)
+    {
+        ComponentPoolResult result;
+        result.entityCount = entityCount;
+
+        // Every entity slot is a plain index, a random subset of them holds the component and is added and removed in random order
+        std::mt19937 generator(entityCount);
+        std::vector<uint32_t> entityIds(entityCount);
+        for (uint32_t i = 0; i < entityCount; i++)
+        {
+            entityIds[i] = MakeEntityId(i, 0);
+        }
+        std::shuffle(entityIds.begin(), entityIds.end(), generator);
+        result.componentCount = std::min(entityCount, static_cast<uint32_t>(static_cast<float>(entityCount) * componentPercent / 100.0f));
+        std::vector<uint32_t> componentIds(entityIds.begin(), entityIds.begin() + result.componentCount);
+        std::vector<uint32_t> removeOrder = componentIds;
+        std::shuffle(removeOrder.begin(), removeOrder.end(), generator);
+        std::sort(entityIds.begin(), entityIds.end());
+
+        std::uniform_real_distribution<float> coordinate(-1000.0f, 1000.0f);
+        std::vector<TransformComponent> transforms;
+        transforms.reserve(result.componentCount);
+        for (uint32_t i = 0; i < result.componentCount; i++)
+        {
+            transforms.emplace_back(glm::vec3(coordinate(generator), coordinate(generator), coordinate(generator)));
+        }
+
+        // Sums of positions so no pass can be optimized away, the same in both pools
+        double optionalGetSum = 0.0;
+        double sparseGetSum = 0.0;
+        double optionalIterateSum = 0.0;
+        double sparseIterateSum = 0.0;
+        bool bPoolsMatch = true;
+
+        // Small pools are measured over more rounds so every count runs about as long
+        const uint32_t roundCount = std::max(1u, 1'000'000u / std::max(1u, entityCount));
+        for (uint32_t round = 0; round < roundCount; round++)
+        {
+            // The optional pool allocates every slot up front, which is part of what adding to it costs
+            auto start = std::chrono::high_resolution_clock::now();
+            OptionalComponentPool<TransformComponent> optionalPool(entityCount);
+            for (uint32_t i = 0; i < result.componentCount; i++)
+            {
+                optionalPool.AddComponent(GetEntityIndex(componentIds[i]), transforms[i]);
+            }
+            result.optionalAddMs += ElapsedMs(start);
+
+            ComponentPool<TransformComponent> sparsePool;
+            start = std::chrono::high_resolution_clock::now();
+            for (uint32_t i = 0; i < result.componentCount; i++)
+            {
+                sparsePool.AddComponent(componentIds[i], transforms[i]);
+            }
+            result.sparseAddMs += ElapsedMs(start);
+
+            start = std::chrono::high_resolution_clock::now();
+            for (uint32_t entityId : entityIds)
+            {
+                if (const TransformComponent* transform = optionalPool.GetComponent(GetEntityIndex(entityId)))
+                {
+                    optionalGetSum += transform->Position.x;
+                }
+            }
+            result.optionalGetMs += ElapsedMs(start);
+
+            start = std::chrono::high_resolution_clock::now();
+            for (uint32_t entityId : entityIds)
+            {
+                if (const TransformComponent* transform = sparsePool.GetComponent(entityId))
+                {
+                    sparseGetSum += transform->Position.x;
+                }
+            }
+            result.sparseGetMs += ElapsedMs(start);
+
+            start = std::chrono::high_resolution_clock::now();
+            optionalPool.Each([&optionalIterateSum](const TransformComponent& transform)
+            {
+                optionalIterateSum += transform.Position.y;
+            });
+            result.optionalIterateMs += ElapsedMs(start);
+
+            start = std::chrono::high_resolution_clock::now();
+            for (const TransformComponent& transform : sparsePool.GetComponents())
+            {
+                sparseIterateSum += transform.Position.y;
+            }
+            result.sparseIterateMs += ElapsedMs(start);
+
+            result.optionalMemoryBytes = optionalPool.GetMemoryUsage();
+            result.sparseMemoryBytes = sparsePool.GetMemoryUsage();
+
+            start = std::chrono::high_resolution_clock::now();
+            for (uint32_t entityId : removeOrder)
+            {
+                optionalPool.RemoveComponent(GetEntityIndex(entityId));
+            }
+            result.optionalRemoveMs += ElapsedMs(start);
+
+            start = std::chrono::high_resolution_clock::now();
+            for (uint32_t entityId : removeOrder)
+            {
+                sparsePool.RemoveComponent(entityId);
+            }
+            result.sparseRemoveMs += ElapsedMs(start);
+
+            bPoolsMatch = bPoolsMatch && sparsePool.GetSize() == 0;
+        }
+
+        result.optionalAddMs /= roundCount;
+        result.sparseAddMs /= roundCount;
+        result.optionalGetMs /= roundCount;
+        result.sparseGetMs /= roundCount;
+        result.optionalIterateMs /= roundCount;
+        result.sparseIterateMs /= roundCount;
+        result.optionalRemoveMs /= roundCount;
+        result.sparseRemoveMs /= roundCount;
+        // Both pools visit the same components, only in a different order
+        result.bPoolsMatch = bPoolsMatch && optionalGetSum == sparseGetSum
+            && std::abs(optionalIterateSum - sparseIterateSum) <= 1e-6 * std::max(1.0, std::abs(optionalIterateSum));
+
+        TPS_CORE_INFO("Component pool benchmark | {0} entities, {1} components | Add: {2:.3f} ms optional, {3:.3f} ms sparse | Get: {4:.3f} ms, {5:.3f} ms | Iterate: {6:.3f} ms, {7:.3f} ms | Remove: {8:.3f} ms, {9:.3f} ms | Memory: {10:.1f} KB, {11:.1f} KB | {12}",
+            entityCount, result.componentCount, result.optionalAddMs, result.sparseAddMs, result.optionalGetMs, result.sparseGetMs, result.optionalIterateMs,
+            result.sparseIterateMs, result.optionalRemoveMs, result.sparseRemoveMs, result.optionalMemoryBytes / 1024.0, result.sparseMemoryBytes / 1024.0,
+            result.bPoolsMatch ? "Pools match" : "POOLS DIFFER");
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+std::vector<Tempus::SceneBenchmark::ChangeTrackingResult> Tempus::SceneBenchmark::RunChangeTracking(uint32_t entityCount, float movingPercent, uint32_t frameCount)
+{
+    std::vector<ChangeTrackingResult> results;
+    const uint32_t movingCount = std::min(entityCount, static_cast<uint32_t>(static_cast<float>(entityCount) * movingPercent / 100.0f));
+
+    for (SceneStorageMode storageMode : { SceneStorageMode::ComponentPools, SceneStorageMode::Archetypes })
+    {
+        ChangeTrackingResult result;
+        result.storageMode = storageMode;
+        result.entityCount = entityCount;
+        result.movingCount = movingCount;
+
+        Scene scene("Change Tracking Benchmark Scene", storageMode);
+        std::vector<uint32_t> entityIds;
+        entityIds.reserve(entityCount);
+        for (uint32_t i = 0; i < entityCount; i++)
+        {
+            Entity entity = scene.AddEntity("Entity");
+            const float f = static_cast<float>(i);
+            entity.AddComponent<TransformComponent>(glm::vec3(f, f * 0.5f, -f), glm::vec3(f * 0.1f, f * 0.2f, f * 0.3f));
+            entity.AddComponent<StaticMeshComponent>();
+            entityIds.push_back(entity.GetId());
+        }
+
+        // Indexed by entity index so both approaches can write to the same slot regardless of visiting order
+        std::vector<glm::mat4> fullMatrices(entityCount);
+        std::vector<glm::mat4> incrementalMatrices(entityCount);
+        auto view = scene.View<TransformComponent, StaticMeshComponent>();
+
+        double fullMs = 0.0;
+        double incrementalMs = 0.0;
+        uint32_t lastVersion = 0;
+
+        for (uint32_t frame = 0; frame < frameCount; frame++)
+        {
+            // A different spread of entities moves every frame
+            const uint32_t stride = movingCount > 0 ? entityCount / movingCount : 1;
+            for (uint32_t i = 0; i < movingCount; i++)
+            {
+                const uint32_t entityId = entityIds[(i * stride + frame) % entityCount];
+                scene.GetMutableComponent<TransformComponent>(entityId)->Position.z += 1.0f;
+            }
+
+            auto start = std::chrono::high_resolution_clock::now();
+            view.Each([&fullMatrices](uint32_t entityId, TransformComponent& transform, StaticMeshComponent& mesh)
+            {
+                fullMatrices[GetEntityIndex(entityId)] = transform.GetLocalMatrix();
+            });
+            fullMs += ElapsedMs(start);
+
+            start = std::chrono::high_resolution_clock::now();
+            const uint32_t sinceVersion = lastVersion;
+            lastVersion = scene.AdvanceChangeVersion();
+            view.Changed<TransformComponent>(sinceVersion).Each([&incrementalMatrices](uint32_t entityId, TransformComponent& transform, StaticMeshComponent& mesh)
+            {
+                incrementalMatrices[GetEntityIndex(entityId)] = transform.GetLocalMatrix();
+            });
+            incrementalMs += ElapsedMs(start);
+        }
+
+        result.fullRebuildMs = frameCount > 0 ? fullMs / frameCount : 0.0;
+        result.incrementalMs = frameCount > 0 ? incrementalMs / frameCount : 0.0;
+        result.speedup = result.incrementalMs > 0.0 ? result.fullRebuildMs / result.incrementalMs : 0.0;
+        result.bMatchesFullRebuild = fullMatrices == incrementalMatrices;
+
+        TPS_CORE_INFO("Change tracking benchmark | {0} | {1} entities, {2} moving | Full: {3:.3f} ms/frame | Changed: {4:.3f} ms/frame ({5:.1f}x) | {6}",
+            GetStorageModeName(storageMode), entityCount, movingCount, result.fullRebuildMs, result.incrementalMs, result.speedup,
+            result.bMatchesFullRebuild ? "Results match" : "RESULTS DIFFER");
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+std::vector<Tempus::SceneBenchmark::WorldMatrixCacheResult> Tempus::SceneBenchmark::RunWorldMatrixCache(uint32_t entityCount, uint32_t frameCount)
+{
+    std::vector<WorldMatrixCacheResult> results;
+
+    for (SceneStorageMode storageMode : { SceneStorageMode::ComponentPools, SceneStorageMode::Archetypes })
+    {
+        WorldMatrixCacheResult result;
+        result.storageMode = storageMode;
+        result.entityCount = entityCount;
+
+        Scene scene("World Matrix Cache Benchmark Scene", storageMode);
+        for (uint32_t i = 0; i < entityCount; i++)
+        {
+            Entity entity = scene.AddEntity("Entity");
+            const float f = static_cast<float>(i);
+            entity.AddComponent<TransformComponent>(glm::vec3(f, f * 0.5f, -f), glm::vec3(f * 0.1f, f * 0.2f, f * 0.3f));
+            entity.AddComponent<StaticMeshComponent>();
+        }
+
+        // The first update adds and fills every world transform, which is a load cost rather than a per frame one
+        TransformSystem* transformSystem = scene.GetTransformSystem();
+        scene.FlushComponentObservers();
+        transformSystem->OnUpdate(0.0f);
+
+        // Indexed by entity index so both approaches can write to the same slot regardless of visiting order
+        std::vector<glm::mat4> recomputedMatrices(entityCount);
+        std::vector<glm::mat4> cachedMatrices(entityCount);
+        auto transformView = scene.View<TransformComponent, StaticMeshComponent>();
+        auto worldView = scene.View<WorldTransformComponent, StaticMeshComponent>();
+
+        double recomputeMs = 0.0;
+        double cachedMs = 0.0;
+        uint32_t lastVersion = 0;
+
+        for (uint32_t frame = 0; frame < frameCount; frame++)
+        {
+            auto start = std::chrono::high_resolution_clock::now();
+            transformView.Each([&recomputedMatrices](uint32_t entityId, TransformComponent& transform, StaticMeshComponent& mesh)
+            {
+                recomputedMatrices[GetEntityIndex(entityId)] = transform.GetLocalMatrix();
+            });
+            recomputeMs += ElapsedMs(start);
+
+            start = std::chrono::high_resolution_clock::now();
+            scene.FlushComponentObservers();
+            transformSystem->OnUpdate(0.0f);
+            const uint32_t sinceVersion = lastVersion;
+            lastVersion = scene.AdvanceChangeVersion();
+            worldView.Changed<WorldTransformComponent>(sinceVersion).Each([&cachedMatrices](uint32_t entityId, WorldTransformComponent& worldTransform, StaticMeshComponent& mesh)
+            {
+                cachedMatrices[GetEntityIndex(entityId)] = worldTransform.World;
+            });
+            cachedMs += ElapsedMs(start);
+        }
+
+        result.recomputeMs = frameCount > 0 ? recomputeMs / frameCount : 0.0;
+        result.cachedMs = frameCount > 0 ? cachedMs / frameCount : 0.0;
+        result.speedup = result.cachedMs > 0.0 ? result.recomputeMs / result.cachedMs : 0.0;
+        result.bMatchesRecompute = MatricesMatch(cachedMatrices, recomputedMatrices);
+
+        TPS_CORE_INFO("World matrix cache benchmark | {0} | {1} static entities | Recompute: {2:.3f} ms/frame | Cached: {3:.3f} ms/frame ({4:.1f}x) | {5}",
+            GetStorageModeName(storageMode), entityCount, result.recomputeMs, result.cachedMs, result.speedup,
+            result.bMatchesRecompute ? "Results match" : "RESULTS DIFFER");
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+std::vector<Tempus::SceneBenchmark::SpawnResult> Tempus::SceneBenchmark::RunSpawn(uint32_t entityCount)
+{
+    std::vector<SpawnResult> results;
+
+    for (SceneStorageMode storageMode : { SceneStorageMode::ComponentPools, SceneStorageMode::Archetypes })
+    {
+        SpawnResult result;
+        result.storageMode = storageMode;
+        result.entityCount = entityCount;
+
+        Scene individualScene("Individual Spawn Benchmark Scene", storageMode);
+        auto start = std::chrono::high_resolution_clock::now();
+        for (uint32_t i = 0; i < entityCount; i++)
+        {
+            Entity entity = individualScene.AddEntity("Entity");
+            entity.AddComponent<TransformComponent>();
+        }
+        result.individualSpawnMs = ElapsedMs(start);
+
+        Scene batchScene("Batch Spawn Benchmark Scene", storageMode);
+        start = std::chrono::high_resolution_clock::now();
+        const std::vector<uint32_t> ids = batchScene.SpawnBatch(entityCount, "Entity", TransformComponent());
+        result.batchSpawnMs = ElapsedMs(start);
+
+        result.entitiesPerSecond = result.batchSpawnMs > 0.0 ? entityCount * 1000.0 / result.batchSpawnMs : 0.0;
+        result.speedup = result.batchSpawnMs > 0.0 ? result.individualSpawnMs / result.batchSpawnMs : 0.0;
+        result.bMatchesIndividual = batchScene.GetEntityCount() == individualScene.GetEntityCount()
+            && batchScene.View<TransformComponent>().GetEntityIds().size() == individualScene.View<TransformComponent>().GetEntityIds().size();
+
+        start = std::chrono::high_resolution_clock::now();
+        batchScene.DespawnBatch(ids);
+        result.batchDespawnMs = ElapsedMs(start);
+
+        TPS_CORE_INFO("Spawn benchmark | {0} | {1} entities | Individual: {2:.2f} ms | Batch: {3:.2f} ms ({4:.1f}M entities/s, {5:.1f}x) | Batch despawn: {6:.2f} ms | {7}",
+            GetStorageModeName(storageMode), entityCount, result.individualSpawnMs, result.batchSpawnMs, result.entitiesPerSecond / 1'000'000.0,
+            result.speedup, result.batchDespawnMs, result.bMatchesIndividual ? "Results match" : "RESULTS DIFFER");
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+std::vector<Tempus::SceneBenchmark::SortResult> Tempus::SceneBenchmark::RunSort(uint32_t entityCount, uint32_t churnRounds, uint32_t movesPerUpdate)
+{
+    std::vector<SortResult> results;
+    constexpr uint32_t Seed = 1234;
+
+    for (SceneStorageMode storageMode : { SceneStorageMode::ComponentPools, SceneStorageMode::Archetypes })
+    {
+        SortResult result;
+        result.storageMode = storageMode;
+        result.entityCount = entityCount;
+
+        Scene scene("Sort Benchmark Scene", storageMode);
+        BuildChurnedScene(scene, entityCount, churnRounds, Seed);
+
+        auto countMeshSwitches = [&scene]()
+        {
+            uint32_t switches = 0;
+            SharedDataHandle previous = INVALID_SHARED_DATA_HANDLE;
+            scene.View<StaticMeshComponent>().Each([&switches, &previous](uint32_t entityId, StaticMeshComponent& mesh)
+            {
+                switches += mesh.GetMesh().GetHandle() != previous ? 1 : 0;
+                previous = mesh.GetMesh().GetHandle();
+            });
+            return switches;
+        };
+
+        uint64_t churnedChecksum = 0;
+        result.churnedIterateMs = TimeMeshViewIteration(scene, churnedChecksum);
+        result.churnedMeshSwitches = countMeshSwitches();
+
+        // The mesh view follows the most recently sorted component, so transforms are sorted last
+        scene.SortPool<StaticMeshComponent>(&GetMeshSortKey);
+        result.sortedMeshSwitches = countMeshSwitches();
+        bool bSorted = IsViewSorted<StaticMeshComponent>(scene, &GetMeshSortKey);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        scene.SortPool<TransformComponent>(&GetTransformSortKey);
+        result.sortMs = ElapsedMs(start);
+        bSorted = bSorted && IsViewSorted<TransformComponent>(scene, &GetTransformSortKey);
+
+        uint64_t sortedChecksum = 0;
+        result.sortedIterateMs = TimeMeshViewIteration(scene, sortedChecksum);
+        result.speedup = result.sortedIterateMs > 0.0 ? result.churnedIterateMs / result.sortedIterateMs : 0.0;
+        bSorted = bSorted && sortedChecksum == churnedChecksum;
+
+        // Incremental sort of an identically churned scene has to end with the same transform order
+        if (storageMode == SceneStorageMode::ComponentPools)
+        {
+            Scene incrementalScene("Incremental Sort Benchmark Scene", storageMode);
+            BuildChurnedScene(incrementalScene, entityCount, churnRounds, Seed);
+
+            result.movesPerUpdate = movesPerUpdate;
+            ComponentPool<TransformComponent>* pool = incrementalScene.GetComponentPool<TransformComponent>();
+            pool->BeginSort(&GetTransformSortKey);
+            bool bFinished = false;
+            while (!bFinished)
+            {
+                start = std::chrono::high_resolution_clock::now();
+                bFinished = pool->ContinueSort(movesPerUpdate);
+                result.incrementalMaxUpdateMs = std::max(result.incrementalMaxUpdateMs, ElapsedMs(start));
+                result.incrementalUpdates++;
+            }
+
+            const std::span<const uint32_t> fullOrder = scene.GetComponentPool<TransformComponent>()->GetEntityIds();
+            const std::span<const uint32_t> incrementalOrder = pool->GetEntityIds();
+            bSorted = bSorted && std::equal(fullOrder.begin(), fullOrder.end(), incrementalOrder.begin(), incrementalOrder.end());
+        }
+        result.bSortedCorrectly = bSorted;
+
+        TPS_CORE_INFO("Sort benchmark | {0} | {1} entities | Churned: {2:.3f} ms | Sorted: {3:.3f} ms ({4:.2f}x) | Sort: {5:.2f} ms | Mesh switches: {6} -> {7} | Incremental: {8} updates of {9}, max {10:.3f} ms | {11}",
+            GetStorageModeName(storageMode), entityCount, result.churnedIterateMs, result.sortedIterateMs, result.speedup, result.sortMs,
+            result.churnedMeshSwitches, result.sortedMeshSwitches, result.incrementalUpdates, result.movesPerUpdate, result.incrementalMaxUpdateMs,
+            result.bSortedCorrectly ? "Sorted correctly" : "SORT FAILED");
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+std::vector<Tempus::SceneBenchmark::SerializeResult> Tempus::SceneBenchmark::RunSerialize(uint32_t entityCount)
+{
+    std::vector<SerializeResult> results;
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / (std::string("TempusSerializeBenchmark") + SceneSerializer::FileExtension);
+
+    for (SceneStorageMode storageMode : { SceneStorageMode::ComponentPools, SceneStorageMode::Archetypes })
+    {
+        SerializeResult result;
+        result.storageMode = storageMode;
+        result.entityCount = entityCount;
+
+        // Churned so the file has to reproduce free slots and shuffled storage, with some parented and some unsaved entities
+        Scene scene("Serialize Benchmark Scene", storageMode);
+        BuildChurnedScene(scene, entityCount, 1, 1234);
+        const std::vector<uint32_t> ids = scene.GetEntityIDs();
+        for (size_t i = 1; i < ids.size(); i += 64)
+        {
+            scene.SetParent(ids[i], ids[i - 1]);
+        }
+        for (size_t i = 0; i < ids.size(); i += 1024)
+        {
+            scene.AddComponent<EditorNoSerializeTag>(ids[i]);
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        const bool bSaved = SceneSerializer::Save(scene, path);
+        result.saveMs = ElapsedMs(start);
+
+        std::error_code error;
+        result.fileBytes = bSaved ? static_cast<size_t>(std::filesystem::file_size(path, error)) : 0;
+
+        start = std::chrono::high_resolution_clock::now();
+        std::unique_ptr<Scene> loadedScene = bSaved ? SceneSerializer::Load(path) : nullptr;
+        result.loadMs = ElapsedMs(start);
+
+        if (loadedScene)
+        {
+            start = std::chrono::high_resolution_clock::now();
+            loadedScene->FlushComponentObservers();
+            result.derivedDataMs = ElapsedMs(start);
+
+            result.bMatchesSaved = loadedScene->GetStorageMode() == storageMode && LoadedSceneMatches(scene, *loadedScene)
+                && loadedScene->View<WorldTransformComponent>().GetEntityIds().size() == loadedScene->View<TransformComponent>().GetEntityIds().size();
+        }
+        std::filesystem::remove(path, error);
+
+        TPS_CORE_INFO("Serialize benchmark | {0} | {1} entities | Save: {2:.2f} ms | Load: {3:.2f} ms | World transforms: {4:.2f} ms | File: {5:.1f} MB | {6}",
+            GetStorageModeName(storageMode), entityCount, result.saveMs, result.loadMs, result.derivedDataMs, result.fileBytes / (1024.0 * 1024.0),
+            result.bMatchesSaved ? "Scenes match" : "SCENES DIFFER");
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+std::vector<Tempus::SceneBenchmark::UndoResult> Tempus::SceneBenchmark::RunUndo(uint32_t entityCount, uint32_t editCount)
+{
+    std::vector<UndoResult> results;
+
+    for (SceneStorageMode storageMode : { SceneStorageMode::ComponentPools, SceneStorageMode::Archetypes })
+    {
+        UndoResult result;
+        result.storageMode = storageMode;
+        result.entityCount = entityCount;
+        result.editCount = editCount;
+
+        // Built twice from the same seed, the second copy is what undoing every edit must return to
+        std::unique_ptr<Scene> scene = BuildEditorScene("Undo Benchmark Scene", storageMode, entityCount);
+        std::unique_ptr<Scene> originalScene = BuildEditorScene("Undo Benchmark Scene", storageMode, entityCount);
+
+        SceneHistory history;
+        history.SetMemoryBudget(std::numeric_limits<size_t>::max());
+        history.Record(*scene);
+        result.baselineMs = history.GetStepStats(0).captureMs;
+        result.baselineBytes = history.GetRetainedBytes();
+
+        // Single entity edits the way the inspector makes them, then one despawn
+        std::mt19937 generator(42);
+        const std::vector<uint32_t> ids = scene->GetEntityIDs();
+        for (uint32_t edit = 0; edit < editCount; edit++)
+        {
+            const uint32_t id = ids[generator() % ids.size()];
+            if (TransformComponent* transform = scene->GetMutableComponent<TransformComponent>(id))
+            {
+                transform->Position += glm::vec3(1.0f, 2.0f, 3.0f);
+            }
+            else
+            {
+                scene->AddComponent<TransformComponent>(id);
+            }
+            history.Record(*scene);
+        }
+        scene->RemoveEntity(ids[ids.size() / 2]);
+        history.Record(*scene);
+
+        const uint32_t stepCount = history.GetStepCount();
+        for (uint32_t step = 1; step < stepCount; step++)
+        {
+            result.editMs += history.GetStepStats(step).captureMs;
+            result.editBytes += history.GetStepStats(step).retainedBytes;
+        }
+        result.editMs /= std::max(stepCount - 1, 1u);
+        result.editBytes /= std::max(stepCount - 1, 1u);
+        result.retainedBytes = history.GetRetainedBytes();
+
+        auto start = std::chrono::high_resolution_clock::now();
+        while (std::unique_ptr<Scene> restoredScene = history.Undo(scene.get()))
+        {
+            scene = std::move(restoredScene);
+        }
+        result.undoMs = ElapsedMs(start) / std::max(stepCount - 1, 1u);
+
+        result.bUndoMatches = history.GetCurrentStep() == 0 && LoadedSceneMatches(*originalScene, *scene, true);
+
+        TPS_CORE_INFO("Undo benchmark | {0} | {1} entities | First step: {2:.2f} ms, {3:.1f} MB | Per edit: {4:.3f} ms, {5:.1f} KB | Undo: {6:.2f} ms | Retained: {7:.1f} MB | {8}",
+            GetStorageModeName(storageMode), entityCount, result.baselineMs, result.baselineBytes / (1024.0 * 1024.0), result.editMs, result.editBytes / 1024.0,
+            result.undoMs, result.retainedBytes / (1024.0 * 1024.0), result.bUndoMatches ? "Scenes match" : "SCENES DIFFER");
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+std::vector<Tempus::SceneBenchmark::CloneResult> Tempus::SceneBenchmark::RunClone(uint32_t entityCount)
+{
+    std::vector<CloneResult> results;
+
+    for (SceneStorageMode storageMode : { SceneStorageMode::ComponentPools, SceneStorageMode::Archetypes })
+    {
+        CloneResult result;
+        result.storageMode = storageMode;
+        result.entityCount = entityCount;
+
+        // Built twice from the same seed, the second copy is what the scene must still match after the play session
+        std::unique_ptr<Scene> editScene = BuildEditorScene("Clone Benchmark Scene", storageMode, entityCount);
+        std::unique_ptr<Scene> originalScene = BuildEditorScene("Clone Benchmark Scene", storageMode, entityCount);
+        // Observer delivery and the transform system, what a frame's update does to these scenes
+        auto update = [](Scene& scene)
+        {
+            scene.FlushComponentObservers();
+            scene.GetTransformSystem()->OnUpdate(0.0f);
+        };
+        update(*editScene);
+        update(*originalScene);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        {
+            Scene copiedScene("Clone Benchmark Scene", storageMode);
+            for (uint32_t id : editScene->GetEntityIDs())
+            {
+                const uint32_t copiedId = copiedScene.AddEntity(editScene->GetEntityName(id)).GetId();
+                CopyComponent<TransformComponent>(*editScene, id, copiedScene, copiedId);
+                CopyComponent<StaticMeshComponent>(*editScene, id, copiedScene, copiedId);
+                CopyComponent<WorldTransformComponent>(*editScene, id, copiedScene, copiedId);
+                CopyComponent<HierarchyComponent>(*editScene, id, copiedScene, copiedId);
+                if (editScene->HasComponent<EditorNoSerializeTag>(id))
+                {
+                    copiedScene.AddComponent<EditorNoSerializeTag>(copiedId);
+                }
+            }
+            result.perEntityCopyMs = ElapsedMs(start);
+        }
+
+        // Like SceneManager::BeginPlay() the clone becomes the active scene and the edited one is set aside
+        start = std::chrono::high_resolution_clock::now();
+        std::unique_ptr<Scene> activeScene = editScene->Clone();
+        result.cloneMs = ElapsedMs(start);
+        result.speedup = result.cloneMs > 0.0 ? result.perEntityCopyMs / result.cloneMs : 0.0;
+
+        result.bCloneMatches = LoadedSceneMatches(*editScene, *activeScene, true) && activeScene->GetChangeVersion() == editScene->GetChangeVersion()
+            && activeScene->View<TransformComponent, StaticMeshComponent>().GetSize() == editScene->View<TransformComponent, StaticMeshComponent>().GetSize();
+
+        start = std::chrono::high_resolution_clock::now();
+        update(*activeScene);
+        result.firstUpdateMs = ElapsedMs(start);
+
+        // Play the clone for a bit, moving and despawning entities
+        const std::vector<uint32_t> ids = activeScene->GetEntityIDs();
+        for (size_t i = 0; i < ids.size(); i += 16)
+        {
+            if (TransformComponent* transform = activeScene->GetMutableComponent<TransformComponent>(ids[i]))
+            {
+                transform->Position.z += 10.0f;
+            }
+        }
+        activeScene->DespawnBatch(std::span<const uint32_t>(ids).first(ids.size() / 8));
+        update(*activeScene);
+
+        // The way SceneManager::EndPlay() restores, the played scene is freed and the edited one moved back in
+        start = std::chrono::high_resolution_clock::now();
+        activeScene = std::move(editScene);
+        result.restoreMs = ElapsedMs(start);
+
+        result.bCloneMatches = result.bCloneMatches && LoadedSceneMatches(*originalScene, *activeScene, true);
+
+        TPS_CORE_INFO("Clone benchmark | {0} | {1} entities | Clone: {2:.2f} ms | Per entity copy: {3:.2f} ms ({4:.1f}x) | First update: {5:.2f} ms | Restore: {6:.2f} ms | {7}",
+            GetStorageModeName(storageMode), entityCount, result.cloneMs, result.perEntityCopyMs, result.speedup, result.firstUpdateMs, result.restoreMs,
+            result.bCloneMatches ? "Scenes match" : "SCENES DIFFER");
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+std::vector<Tempus::SceneBenchmark::AsyncLoadResult> Tempus::SceneBenchmark::RunAsyncLoad(uint32_t entityCount)
+{
+    std::vector<AsyncLoadResult> results;
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / (std::string("TempusAsyncLoadBenchmark") + SceneSerializer::FileExtension);
+    JobSystem* jobSystem = GApp ? JOB_SYSTEM : nullptr;
+
+    // What a frame does with the active scene: observer delivery and the transform system, then reading what gets drawn
+    auto frame = [](Scene& scene, uint64_t& checksum)
+    {
+        const auto start = std::chrono::high_resolution_clock::now();
+        scene.FlushComponentObservers();
+        scene.GetTransformSystem()->OnUpdate(0.0f);
+        scene.View<WorldTransformComponent, StaticMeshComponent>().Each([&checksum](uint32_t entityId, WorldTransformComponent& world, StaticMeshComponent& mesh)
+        {
+            checksum += std::bit_cast<uint32_t>(world.World[3][0]) + mesh.GetMesh().GetHandle();
+        });
+        return ElapsedMs(start);
+    };
+    auto loadMatches = [](Scene& savedScene, Scene& loadedScene)
+    {
+        return LoadedSceneMatches(savedScene, loadedScene)
+            && loadedScene.View<WorldTransformComponent>().GetEntityIds().size() == loadedScene.View<TransformComponent>().GetEntityIds().size();
+    };
+
+    for (SceneStorageMode storageMode : { SceneStorageMode::ComponentPools, SceneStorageMode::Archetypes })
+    {
+        AsyncLoadResult result;
+        result.storageMode = storageMode;
+        result.entityCount = entityCount;
+
+        std::unique_ptr<Scene> savedScene = BuildEditorScene("Async Load Benchmark Scene", storageMode, entityCount);
+        const bool bSaved = SceneSerializer::Save(*savedScene, path);
+
+        std::unique_ptr<Scene> activeScene = BuildEditorScene("Async Load Benchmark Running Scene", storageMode, entityCount);
+        uint64_t checksum = 0;
+        frame(*activeScene, checksum);
+
+        constexpr uint32_t BaselineFrameCount = 10;
+        for (uint32_t i = 0; i < BaselineFrameCount; i++)
+        {
+            result.baselineFrameMs += frame(*activeScene, checksum);
+        }
+        result.baselineFrameMs /= BaselineFrameCount;
+
+        // LoadScene() from the editor: the load, freeing the replaced scene and the first update all land on one frame
+        auto start = std::chrono::high_resolution_clock::now();
+        std::unique_ptr<Scene> syncScene = bSaved ? SceneSerializer::Load(path) : nullptr;
+        if (syncScene)
+        {
+            activeScene = std::move(syncScene);
+            frame(*activeScene, checksum);
+        }
+        result.syncHitchMs = ElapsedMs(start);
+        bool bMatches = bSaved && loadMatches(*savedScene, *activeScene);
+
+        // The synchronously loaded scene keeps running while the same file loads in the background
+        // The worker also builds the frame's view cache, like SceneManager does for the renderer's views
+        std::shared_ptr<AsyncSceneLoad> load = bSaved ? AsyncSceneLoad::Start(path, jobSystem, [](Scene& scene) { scene.View<WorldTransformComponent, StaticMeshComponent>().GetSize(); }) : nullptr;
+        while (load && !load->IsFinished())
+        {
+            const double frameMs = frame(*activeScene, checksum);
+            result.loadingFrameCount++;
+            result.loadingFrameAvgMs += frameMs;
+            result.loadingFrameMaxMs = std::max(result.loadingFrameMaxMs, frameMs);
+        }
+        result.loadingFrameAvgMs = result.loadingFrameCount > 0 ? result.loadingFrameAvgMs / result.loadingFrameCount : 0.0;
+        result.loadMs = load ? load->GetLoadMs() : 0.0;
+
+        // SceneManager's swap: the loaded scene becomes active and the replaced one is freed by a background job
+        start = std::chrono::high_resolution_clock::now();
+        std::unique_ptr<Scene> loadedScene = load ? load->TakeScene() : nullptr;
+        if (loadedScene)
+        {
+            std::shared_ptr<Scene> previousScene = std::move(activeScene);
+            activeScene = std::move(loadedScene);
+            if (jobSystem)
+            {
+                jobSystem->RunBackground([previousScene = std::move(previousScene)]() {});
+            }
+            previousScene.reset();
+            frame(*activeScene, checksum);
+        }
+        result.swapFrameMs = ElapsedMs(start);
+        bMatches = bMatches && load && loadMatches(*savedScene, *activeScene);
+        result.bLoadMatches = bMatches;
+
+        std::error_code error;
+        std::filesystem::remove(path, error);
+
+        TPS_CORE_INFO("Async load benchmark | {0} | {1} entities | Baseline frame: {2:.2f} ms | Sync load hitch: {3:.2f} ms | Frames while loading: {4}, avg {5:.2f} ms, max {6:.2f} ms | Swap frame: {7:.2f} ms | Background load: {8:.2f} ms | {9}",
+            GetStorageModeName(storageMode), entityCount, result.baselineFrameMs, result.syncHitchMs, result.loadingFrameCount, result.loadingFrameAvgMs,
+            result.loadingFrameMaxMs, result.swapFrameMs, result.loadMs, result.bLoadMatches ? "Scenes match" : "SCENES DIFFER");
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+std::vector<Tempus::SceneBenchmark::WorldStreamingResult> Tempus::SceneBenchmark::RunWorldStreaming(uint32_t entityCount)
+{
+    std::vector<WorldStreamingResult> results;
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "TempusWorldStreamingBenchmark";
+    JobSystem* jobSystem = GApp ? JOB_SYSTEM : nullptr;
+
+    // The churned scene spans 2000 units, spread out to a world of 20 by 20 cells
+    constexpr float WorldScale = 10.0f;
+    constexpr float WorldExtent = 1000.0f * WorldScale;
+    constexpr float CellSize = 1000.0f;
+    WorldPartitionSettings settings;
+    settings.loadRadius = 2500.0f;
+    settings.unloadRadius = 3500.0f;
+
+    auto frame = [](Scene& scene, uint64_t& checksum)
+    {
+        const auto start = std::chrono::high_resolution_clock::now();
+        scene.FlushComponentObservers();
+        scene.GetTransformSystem()->OnUpdate(0.0f);
+        scene.View<WorldTransformComponent, StaticMeshComponent>().Each([&checksum](uint32_t entityId, WorldTransformComponent& world, StaticMeshComponent& mesh)
+        {
+            checksum += std::bit_cast<uint32_t>(world.World[3][0]) + mesh.GetMesh().GetHandle();
+        });
+        return ElapsedMs(start);
+    };
+    uint64_t checksum = 0;
+
+    // Streams until every cell has settled for the focus
+    auto settle = [&frame, &checksum, jobSystem](WorldPartition& partition, Scene& scene, const glm::vec3& focus)
+    {
+        for (uint32_t i = 0; i < 100'000; i++)
+        {
+            partition.Update(scene, focus, jobSystem);
+            frame(scene, checksum);
+            if (!partition.IsStreaming())
+            {
+                return;
+            }
+            std::this_thread::yield();
+        }
+    };
+
+    using CellKey = std::pair<int32_t, int32_t>;
+    struct CellContents
+    {
+        uint32_t count = 0;
+        glm::dvec3 positionSum = glm::dvec3(0.0);
+    };
+    auto getCellDistance = [](const CellKey& cell, const glm::vec3& focus)
+    {
+        const float minX = static_cast<float>(cell.first) * CellSize;
+        const float minY = static_cast<float>(cell.second) * CellSize;
+        const float dx = std::max({ minX - focus.x, 0.0f, focus.x - (minX + CellSize) });
+        const float dy = std::max({ minY - focus.y, 0.0f, focus.y - (minY + CellSize) });
+        return std::sqrt(dx * dx + dy * dy);
+    };
+
+    for (SceneStorageMode storageMode : { SceneStorageMode::ComponentPools, SceneStorageMode::Archetypes })
+    {
+        WorldStreamingResult result;
+        result.storageMode = storageMode;
+        result.entityCount = entityCount;
+
+        std::unique_ptr<Scene> world = BuildEditorScene("World Streaming Benchmark World", storageMode, entityCount);
+        for (auto [id, transform] : world->View<TransformComponent>())
+        {
+            transform.Position.x *= WorldScale;
+            transform.Position.y *= WorldScale;
+        }
+        frame(*world, checksum);
+
+        constexpr uint32_t BaselineFrameCount = 10;
+        for (uint32_t i = 0; i < BaselineFrameCount; i++)
+        {
+            result.residentWorldFrameMs += frame(*world, checksum);
+        }
+        result.residentWorldFrameMs /= BaselineFrameCount;
+
+        // What every cell should hold, entities belong to the cell of their root unless it is editor only
+        std::map<CellKey, CellContents> worldCells;
+        for (auto [id, transform, worldTransform] : world->View<TransformComponent, WorldTransformComponent>())
+        {
+            if (world->HasComponent<EditorNoSerializeTag>(id))
+            {
+                continue;
+            }
+            uint32_t root = id;
+            bool bEditorOnlyAncestor = false;
+            while (world->HasComponent<TransformComponent>(world->GetParent(root)))
+            {
+                root = world->GetParent(root);
+                bEditorOnlyAncestor = bEditorOnlyAncestor || world->HasComponent<EditorNoSerializeTag>(root);
+            }
+            if (bEditorOnlyAncestor)
+            {
+                continue;
+            }
+            const glm::vec3& rootPosition = world->GetComponent<TransformComponent>(root)->Position;
+            CellContents& contents = worldCells[{ static_cast<int32_t>(std::floor(rootPosition.x / CellSize)), static_cast<int32_t>(std::floor(rootPosition.y / CellSize)) }];
+            contents.count++;
+            contents.positionSum += glm::dvec3(worldTransform.GetPosition());
+        }
+
+        std::error_code error;
+        std::filesystem::remove_all(directory, error);
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<uint32_t> partitionedIds;
+        const bool bPartitioned = WorldPartition::BuildCells(*world, directory, CellSize, partitionedIds);
+        result.partitionMs = ElapsedMs(start);
+        for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(directory, error))
+        {
+            result.cellFileBytes += entry.file_size(error);
+        }
+        world.reset();
+
+        // The focus crosses the world corner to corner, streaming into a scene that starts out empty
+        std::unique_ptr<Scene> scene = std::make_unique<Scene>("World Streaming Benchmark Scene", storageMode);
+        scene->View<WorldTransformComponent, StaticMeshComponent>();
+        WorldPartition partition(settings);
+        bool bMatches = bPartitioned && partition.Open(directory);
+        result.cellCount = partition.GetStats().cellCount;
+
+        // Frames are paced to 60 Hz, so cells have as much time to load as they would while flying a camera across the world
+        constexpr uint32_t CrossingFrameCount = 600;
+        constexpr std::chrono::microseconds FrameInterval(16'667);
+        const glm::vec3 from(-0.95f * WorldExtent, -0.95f * WorldExtent, 0.0f);
+        const glm::vec3 to = -from;
+        for (uint32_t i = 0; bMatches && i <= CrossingFrameCount; i++)
+        {
+            const glm::vec3 focus = glm::mix(from, to, static_cast<float>(i) / CrossingFrameCount);
+            const auto frameStart = std::chrono::high_resolution_clock::now();
+            partition.Update(*scene, focus, jobSystem);
+            const double streamingMs = ElapsedMs(frameStart);
+            frame(*scene, checksum);
+            const double frameMs = ElapsedMs(frameStart);
+
+            result.frameCount++;
+            result.frameAvgMs += frameMs;
+            result.frameMaxMs = std::max(result.frameMaxMs, frameMs);
+            result.streamingAvgMs += streamingMs;
+            result.streamingMaxMs = std::max(result.streamingMaxMs, streamingMs);
+
+            const WorldPartition::Stats& stats = partition.GetStats();
+            result.peakResidentCells = std::max(result.peakResidentCells, stats.residentCells);
+            result.peakResidentEntities = std::max(result.peakResidentEntities, stats.residentEntities);
+            result.peakBandwidthMBps = std::max(result.peakBandwidthMBps, stats.bandwidthBytesPerSecond / (1024.0 * 1024.0));
+            std::this_thread::sleep_until(frameStart + FrameInterval);
+        }
+        result.frameAvgMs = result.frameCount > 0 ? result.frameAvgMs / result.frameCount : 0.0;
+        result.streamingAvgMs = result.frameCount > 0 ? result.streamingAvgMs / result.frameCount : 0.0;
+
+        // Once settled at the far corner every cell in range must hold exactly its part of the world
+        settle(partition, *scene, to);
+        result.cellsLoaded = partition.GetStats().cellsLoaded;
+        result.cellsUnloaded = partition.GetStats().cellsUnloaded;
+        result.bytesLoaded = partition.GetStats().bytesLoaded;
+
+        std::map<CellKey, CellContents> streamedCells;
+        for (auto [id, cell, worldTransform] : scene->View<WorldCellComponent, WorldTransformComponent>())
+        {
+            CellContents& contents = streamedCells[{ cell.X, cell.Y }];
+            contents.count++;
+            contents.positionSum += glm::dvec3(worldTransform.GetPosition());
+        }
+        for (const auto& [cell, contents] : streamedCells)
+        {
+            auto it = worldCells.find(cell);
+            bMatches = bMatches && it != worldCells.end() && it->second.count == contents.count
+                && glm::length(it->second.positionSum - contents.positionSum) <= 0.01 * contents.count;
+        }
+        for (const auto& [cell, contents] : worldCells)
+        {
+            bMatches = bMatches && (streamedCells.contains(cell) || getCellDistance(cell, to) > settings.loadRadius);
+        }
+        result.bStreamingMatches = bMatches;
+        scene.reset();
+
+        // Settles on either side of a cell boundary in turn, just under half the hysteresis band away from it.
+        // The first round loads what is in range of both sides, after that any load or unload is thrash.
+        auto countThrash = [&](const WorldPartitionSettings& thrashSettings)
+        {
+            Scene thrashScene("World Streaming Benchmark Thrash Scene", storageMode);
+            WorldPartition thrashPartition(thrashSettings);
+            if (!bPartitioned || !thrashPartition.Open(directory))
+            {
+                return 0u;
+            }
+
+            const float swing = 0.5f * (settings.unloadRadius - settings.loadRadius) - 10.0f;
+            auto swingAcross = [&]()
+            {
+                for (uint32_t i = 0; i < 8; i++)
+                {
+                    settle(thrashPartition, thrashScene, glm::vec3((i & 1) ? swing : -swing, 0.0f, 0.0f));
+                }
+            };
+            swingAcross();
+            const uint32_t settledCount = thrashPartition.GetStats().cellsLoaded + thrashPartition.GetStats().cellsUnloaded;
+            swingAcross();
+            return thrashPartition.GetStats().cellsLoaded + thrashPartition.GetStats().cellsUnloaded - settledCount;
+        };
+        result.thrashCount = countThrash(settings);
+        WorldPartitionSettings noHysteresis = settings;
+        noHysteresis.unloadRadius = noHysteresis.loadRadius;
+        result.thrashCountWithoutHysteresis = countThrash(noHysteresis);
+
+        std::filesystem::remove_all(directory, error);
+
+        TPS_CORE_INFO("World streaming benchmark | {0} | {1} entities in {2} cells | Partition: {3:.2f} ms, {4} KB | Whole world resident frame: {5:.2f} ms | Streaming frames: {6}, avg {7:.2f} ms, max {8:.2f} ms | Stream update avg {9:.2f} ms, max {10:.2f} ms | Peak resident: {11} cells, {12} entities | Cells loaded {13}, unloaded {14}, {15} KB, peak {16:.2f} MB/s | Boundary thrash: {17} with hysteresis, {18} without | {19}",
+            GetStorageModeName(storageMode), entityCount, result.cellCount, result.partitionMs, result.cellFileBytes / 1024, result.residentWorldFrameMs,
+            result.frameCount, result.frameAvgMs, result.frameMaxMs, result.streamingAvgMs, result.streamingMaxMs, result.peakResidentCells, result.peakResidentEntities,
+            result.cellsLoaded, result.cellsUnloaded, result.bytesLoaded / 1024, result.peakBandwidthMBps, result.thrashCount, result.thrashCountWithoutHysteresis,
+            result.bStreamingMatches ? "Cells match" : "CELLS DIFFER");
+        results.push_back(result);
+    }
+
+    return results;
+}
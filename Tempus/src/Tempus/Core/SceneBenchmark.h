@@ -0,0 +1,256 @@
+// Copyright Levi Spevakow (C) 2025
+
+#pragma once
+
+#include "Core.h"
+#include "Scene.h"
+#include <vector>
+
+namespace Tempus
+{
+    // Measures entity creation, iteration and teardown at increasing scene sizes in both storage modes.
+    // Every run builds its own temporary scene so the active scene is left untouched.
+    class TEMPUS_API SceneBenchmark
+    {
+    public:
+
+        struct Result
+        {
+            SceneStorageMode storageMode = SceneStorageMode::ComponentPools;
+            uint32_t entityCount = 0;
+            // Creating every entity and adding a transform and static mesh to each
+            double createMs = 0.0;
+            double nsPerEntity = 0.0;
+            // One pass over View<TransformComponent, StaticMeshComponent>()
+            double iterateMs = 0.0;
+            // Destroying the scene and everything in it
+            double destroyMs = 0.0;
+            size_t componentMemoryBytes = 0;
+        };
+
+        struct ComponentPoolResult
+        {
+            uint32_t entityCount = 0;
+            // Entities holding the component, spread over the whole entity range
+            uint32_t componentCount = 0;
+            // Each pass averaged over several rounds, for the sparse set ComponentPool and for the pool it replaced,
+            // which kept a std::optional slot for every entity whether or not the entity had the component
+            double optionalAddMs = 0.0;
+            double sparseAddMs = 0.0;
+            // Looking up every entity, including the ones without the component
+            double optionalGetMs = 0.0;
+            double sparseGetMs = 0.0;
+            double optionalIterateMs = 0.0;
+            double sparseIterateMs = 0.0;
+            double optionalRemoveMs = 0.0;
+            double sparseRemoveMs = 0.0;
+            size_t optionalMemoryBytes = 0;
+            size_t sparseMemoryBytes = 0;
+            // Whether both pools returned the same components
+            bool bPoolsMatch = false;
+        };
+
+        struct ChangeTrackingResult
+        {
+            SceneStorageMode storageMode = SceneStorageMode::ComponentPools;
+            uint32_t entityCount = 0;
+            uint32_t movingCount = 0;
+            // Average per frame time to build a model matrix for every transform
+            double fullRebuildMs = 0.0;
+            // Average per frame time to rebuild only transforms visited by a Changed<TransformComponent> view
+            double incrementalMs = 0.0;
+            double speedup = 0.0;
+            // Whether both approaches ended up with identical matrices
+            bool bMatchesFullRebuild = false;
+        };
+
+        struct WorldMatrixCacheResult
+        {
+            SceneStorageMode storageMode = SceneStorageMode::ComponentPools;
+            uint32_t entityCount = 0;
+            // Average per frame time to compute every model matrix from its TransformComponent
+            double recomputeMs = 0.0;
+            // Average per frame time to update the transform system and read changed WorldTransformComponents
+            double cachedMs = 0.0;
+            double speedup = 0.0;
+            // Whether both approaches ended up with the same matrices, within TransformKernelBenchmark::Tolerance
+            bool bMatchesRecompute = false;
+        };
+
+        struct SpawnResult
+        {
+            SceneStorageMode storageMode = SceneStorageMode::ComponentPools;
+            uint32_t entityCount = 0;
+            // Creating every entity with AddEntity() and AddComponent<TransformComponent>() one at a time
+            double individualSpawnMs = 0.0;
+            // Creating the same entities with a single SpawnBatch()
+            double batchSpawnMs = 0.0;
+            double entitiesPerSecond = 0.0;
+            double speedup = 0.0;
+            // Removing every batch spawned entity with a single DespawnBatch()
+            double batchDespawnMs = 0.0;
+            // Whether both scenes ended up with the same entity and transform counts
+            bool bMatchesIndividual = false;
+        };
+
+        struct SortResult
+        {
+            SceneStorageMode storageMode = SceneStorageMode::ComponentPools;
+            uint32_t entityCount = 0;
+            // Average pass over View<TransformComponent>() after rounds of despawning and respawning random entities
+            double churnedIterateMs = 0.0;
+            // The same pass after SortPool<TransformComponent>() by Morton code
+            double sortedIterateMs = 0.0;
+            double speedup = 0.0;
+            double sortMs = 0.0;
+            // Consecutive View<StaticMeshComponent>() entities using different meshes, before and after sorting by mesh
+            uint32_t churnedMeshSwitches = 0;
+            uint32_t sortedMeshSwitches = 0;
+            // Incremental sort of the transform pool at the given budget, not used in archetype mode
+            uint32_t movesPerUpdate = 0;
+            uint32_t incrementalUpdates = 0;
+            double incrementalMaxUpdateMs = 0.0;
+            // Whether the views came out in key order with every component intact, and the incremental sort matched
+            bool bSortedCorrectly = false;
+        };
+
+        struct SerializeResult
+        {
+            SceneStorageMode storageMode = SceneStorageMode::ComponentPools;
+            uint32_t entityCount = 0;
+            double saveMs = 0.0;
+            // SceneSerializer::Load(), from mapping the file to a scene with every component restored
+            double loadMs = 0.0;
+            // The first observer flush after loading, which rebuilds the unsaved world transforms
+            double derivedDataMs = 0.0;
+            size_t fileBytes = 0;
+            // Whether the loaded scene has the same entity IDs, names and components, without the unsaved entities
+            bool bMatchesSaved = false;
+        };
+
+        struct UndoResult
+        {
+            SceneStorageMode storageMode = SceneStorageMode::ComponentPools;
+            uint32_t entityCount = 0;
+            uint32_t editCount = 0;
+            // Recording the first undo step, which copies every page
+            double baselineMs = 0.0;
+            size_t baselineBytes = 0;
+            // Average time and memory of recording a step after a single entity edit
+            double editMs = 0.0;
+            size_t editBytes = 0;
+            // Average Undo() back to the first step
+            double undoMs = 0.0;
+            // Memory held by the whole history
+            size_t retainedBytes = 0;
+            // Whether undoing every edit restored the original entities and components
+            bool bUndoMatches = false;
+        };
+
+        struct CloneResult
+        {
+            SceneStorageMode storageMode = SceneStorageMode::ComponentPools;
+            uint32_t entityCount = 0;
+            // Scene::Clone()
+            double cloneMs = 0.0;
+            // The same copy made one AddEntity() and AddComponent() at a time
+            double perEntityCopyMs = 0.0;
+            double speedup = 0.0;
+            // First update of the clone, which rebuilds the transform system's derived state
+            double firstUpdateMs = 0.0;
+            // Ending the play session, swapping the edited scene back in and freeing the played one
+            double restoreMs = 0.0;
+            // Whether the clone matched the scene and playing it left the scene untouched
+            bool bCloneMatches = false;
+        };
+
+        struct AsyncLoadResult
+        {
+            SceneStorageMode storageMode = SceneStorageMode::ComponentPools;
+            uint32_t entityCount = 0;
+            // Average frame of the running scene before any load
+            double baselineFrameMs = 0.0;
+            // Frame that loads the scene on the main thread like LoadScene(), freeing the replaced scene and updating the loaded one
+            double syncHitchMs = 0.0;
+            // Frames of the running scene while the scene loads in the background
+            uint32_t loadingFrameCount = 0;
+            double loadingFrameAvgMs = 0.0;
+            double loadingFrameMaxMs = 0.0;
+            // Frame that swaps the loaded scene in the way SceneManager does and updates it
+            double swapFrameMs = 0.0;
+            // Time the worker spent loading the scene and building its world transforms and view caches
+            double loadMs = 0.0;
+            // Whether both loads match the saved scene with every world transform built
+            bool bLoadMatches = false;
+        };
+
+        struct WorldStreamingResult
+        {
+            SceneStorageMode storageMode = SceneStorageMode::ComponentPools;
+            uint32_t entityCount = 0;
+            uint32_t cellCount = 0;
+            // BuildCells() writing every cell file
+            double partitionMs = 0.0;
+            uint64_t cellFileBytes = 0;
+            // Average frame with the whole world resident in one scene
+            double residentWorldFrameMs = 0.0;
+            // Frames of the focus crossing the world, including the partition's update
+            uint32_t frameCount = 0;
+            double frameAvgMs = 0.0;
+            double frameMaxMs = 0.0;
+            // Main thread time of WorldPartition::Update()
+            double streamingAvgMs = 0.0;
+            double streamingMaxMs = 0.0;
+            uint32_t peakResidentCells = 0;
+            uint32_t peakResidentEntities = 0;
+            uint32_t cellsLoaded = 0;
+            uint32_t cellsUnloaded = 0;
+            uint64_t bytesLoaded = 0;
+            double peakBandwidthMBps = 0.0;
+            // Cells loaded or unloaded while the focus moves back and forth within the hysteresis band,
+            // and the same with the unload radius equal to the load radius
+            uint32_t thrashCount = 0;
+            uint32_t thrashCountWithoutHysteresis = 0;
+            // Whether the cells resident at the end hold exactly their part of the world with the original world positions
+            bool bStreamingMatches = false;
+        };
+
+        // Runs every entity count in both storage modes
+        static std::vector<Result> Run(const std::vector<uint32_t>& entityCounts = { 10'000, 100'000, 250'000 });
+
+        // Compares the sparse set ComponentPool against a std::optional slot per entity at every entity count,
+        // with componentPercent of the entities holding a TransformComponent
+        static std::vector<ComponentPoolResult> RunComponentPool(const std::vector<uint32_t>& entityCounts = { 1'000, 10'000, 100'000 }, float componentPercent = 25.0f);
+
+        // Simulates frames where a percentage of transforms move, comparing full and change tracked matrix rebuilds
+        static std::vector<ChangeTrackingResult> RunChangeTracking(uint32_t entityCount = 100'000, float movingPercent = 1.0f, uint32_t frameCount = 100);
+
+        // Simulates frames of a static scene, comparing per frame matrix recomputation against the cached world transforms
+        static std::vector<WorldMatrixCacheResult> RunWorldMatrixCache(uint32_t entityCount = 50'000, uint32_t frameCount = 100);
+
+        // Compares spawning entities one at a time against SpawnBatch(), then times DespawnBatch() on the batch
+        static std::vector<SpawnResult> RunSpawn(uint32_t entityCount = 1'000'000);
+
+        // Churns a scene with random despawns and respawns, then compares iteration before and after SortPool()
+        static std::vector<SortResult> RunSort(uint32_t entityCount = 250'000, uint32_t churnRounds = 4, uint32_t movesPerUpdate = 10'000);
+
+        // Saves a churned scene to a temporary scene file and loads it back
+        static std::vector<SerializeResult> RunSerialize(uint32_t entityCount = 1'000'000);
+
+        // Records an undo step after each of a series of single entity edits, then undoes them all
+        static std::vector<UndoResult> RunUndo(uint32_t entityCount = 1'000'000, uint32_t editCount = 32);
+
+        // Clones a churned scene for a play session and compares it against copying it entity by entity
+        static std::vector<CloneResult> RunClone(uint32_t entityCount = 100'000);
+
+        // Saves a churned scene and loads it back while frames of a scene of the same size keep running, comparing the hitch
+        // of loading on the main thread against an AsyncSceneLoad swapped in at the start of a frame. Without job system
+        // workers the background load runs inline before the first frame.
+        static std::vector<AsyncLoadResult> RunAsyncLoad(uint32_t entityCount = 1'000'000);
+
+        // Partitions a churned scene spread over a large world into cells and streams them into an empty scene while a
+        // focus crosses the world, comparing frames against keeping the whole world resident. Also counts the cells
+        // reloaded while the focus moves back and forth along a cell boundary, with and without hysteresis.
+        static std::vector<WorldStreamingResult> RunWorldStreaming(uint32_t entityCount = 1'000'000);
+    };
+}
@@ -0,0 +1,78 @@
+// Copyright Levi Spevakow (C) 2025
+
+#include "SceneCommandBuffer.h"
+
+#include <algorithm>
+
+Tempus::SceneCommandBuffer::~SceneCommandBuffer()
+{
+    Clear();
+}
+
+Tempus::SceneCommandBuffer::PendingEntity Tempus::SceneCommandBuffer::AddEntity(std::string name)
+{
+    PendingEntity entity;
+    entity.index = static_cast<uint32_t>(m_AddEntities.size());
+    m_AddEntities.push_back(std::move(name));
+    return entity;
+}
+
+void Tempus::SceneCommandBuffer::RemoveEntity(uint32_t id)
+{
+    m_RemoveEntities.push_back(id);
+}
+
+uint32_t Tempus::SceneCommandBuffer::GetCommandCount() const
+{
+    return static_cast<uint32_t>(m_AddEntities.size() + m_RemoveEntities.size() + m_AddComponents.size() + m_RemoveComponents.size());
+}
+
+void Tempus::SceneCommandBuffer::Clear()
+{
+    // Payloads are destroyed whether or not they were moved into the scene
+    for (AddComponentCommand& command : m_AddComponents)
+    {
+        if (command.destroy)
+        {
+            command.destroy(command.payload);
+        }
+    }
+
+    m_AddEntities.clear();
+    m_RemoveEntities.clear();
+    m_AddComponents.clear();
+    m_RemoveComponents.clear();
+    m_ResolvedEntities.clear();
+
+    m_CurrentBlock = 0;
+    m_BlockOffset = 0;
+}
+
+void* Tempus::SceneCommandBuffer::Allocate(size_t size, size_t alignment)
+{
+    while (m_CurrentBlock < m_ArenaBlocks.size())
+    {
+        ArenaBlock& block = m_ArenaBlocks[m_CurrentBlock];
+        const uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+        const uintptr_t aligned = (base + m_BlockOffset + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+
+        if (aligned + size <= base + block.size)
+        {
+            m_BlockOffset = aligned + size - base;
+            return reinterpret_cast<void*>(aligned);
+        }
+
+        m_CurrentBlock++;
+        m_BlockOffset = 0;
+    }
+
+    // Out of blocks, padding the size guarantees the allocation fits whatever the block's alignment
+    ArenaBlock block;
+    block.size = std::max(ArenaBlockSize, size + alignment);
+    block.data = std::make_unique<std::byte[]>(block.size);
+    m_ArenaBlocks.push_back(std::move(block));
+    m_CurrentBlock = static_cast<uint32_t>(m_ArenaBlocks.size()) - 1;
+    m_BlockOffset = 0;
+
+    return Allocate(size, alignment);
+}
@@ -0,0 +1,143 @@
+// Copyright Levi Spevakow (C) 2025
+
+#pragma once
+
+#include "Core.h"
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Tempus
+{
+    class Scene;
+
+    // Records structural changes to a scene so they can be applied later at a safe sync point.
+    // Component data is constructed into an arena owned by the buffer, whose blocks are reused between
+    // playbacks, so recording only allocates while the arena is still growing.
+    // A buffer must only be recorded into by one thread at a time, Scene::GetCommandBuffer() hands out one per thread.
+    //
+    // Playback applies commands by kind rather than in recording order:
+    // entity creations, then component removals, then component additions, then entity removals.
+    // Component commands are grouped by component type so each pool is looked up once per batch.
+    class TEMPUS_API SceneCommandBuffer
+    {
+    public:
+
+        // Handle to an entity this buffer will create, usable by later commands in the same buffer
+        struct PendingEntity
+        {
+            uint32_t index = 0;
+        };
+
+        SceneCommandBuffer() = default;
+        ~SceneCommandBuffer();
+
+        PendingEntity AddEntity(std::string name);
+        void RemoveEntity(uint32_t id);
+
+        template<ValidComponent T, typename... Args>
+        void AddComponent(uint32_t id, Args&&... arguments)
+        {
+            RecordAddComponent<T>(EntityRef{ id, false }, std::forward<Args>(arguments)...);
+        }
+
+        template<ValidComponent T, typename... Args>
+        void AddComponent(PendingEntity entity, Args&&... arguments)
+        {
+            RecordAddComponent<T>(EntityRef{ entity.index, true }, std::forward<Args>(arguments)...);
+        }
+
+        template<ValidComponent T>
+        void RemoveComponent(uint32_t id)
+        {
+            m_RemoveComponents.push_back({ id, T::GetId() });
+        }
+
+        bool IsEmpty() const { return GetCommandCount() == 0; }
+        uint32_t GetCommandCount() const;
+
+        // Discards every recorded command. Arena memory is kept for reuse.
+        void Clear();
+
+        SceneCommandBuffer(const SceneCommandBuffer&) = delete;
+        SceneCommandBuffer& operator=(const SceneCommandBuffer&) = delete;
+
+    private:
+
+        friend class Scene;
+
+        // Size of a single arena block, larger components get a dedicated block
+        static constexpr size_t ArenaBlockSize = 64 * 1024;
+
+        struct EntityRef
+        {
+            // Entity ID, or the index of a pending entity until playback resolves it
+            uint32_t id = INVALID_ENTITY_ID;
+            bool bPending = false;
+        };
+
+        struct AddComponentCommand
+        {
+            using ApplyBatchFunc = void(*)(Scene& scene, std::span<AddComponentCommand* const> commands);
+            using DestroyFunc = void(*)(void* payload);
+
+            EntityRef entity;
+            ComponentId componentId = 0;
+            // Component constructed in the arena, moved into the scene on playback
+            void* payload = nullptr;
+            // Applies a batch of commands that all add this command's component type
+            ApplyBatchFunc applyBatch = nullptr;
+            // nullptr for trivially destructible components
+            DestroyFunc destroy = nullptr;
+        };
+
+        struct RemoveComponentCommand
+        {
+            uint32_t id = INVALID_ENTITY_ID;
+            ComponentId componentId = 0;
+        };
+
+        struct ArenaBlock
+        {
+            std::unique_ptr<std::byte[]> data;
+            size_t size = 0;
+        };
+
+        template<ValidComponent T, typename... Args>
+        void RecordAddComponent(EntityRef entity, Args&&... arguments)
+        {
+            AddComponentCommand command;
+            command.entity = entity;
+            command.componentId = T::GetId();
+            command.payload = new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(arguments)...);
+            command.applyBatch = &ApplyAddComponentBatch<T>;
+            if constexpr (!std::is_trivially_destructible_v<T>)
+            {
+                command.destroy = [](void* payload) { static_cast<T*>(payload)->~T(); };
+            }
+            m_AddComponents.push_back(command);
+        }
+
+        // Defined in Scene.h once Scene is complete
+        template<ValidComponent T>
+        static void ApplyAddComponentBatch(Scene& scene, std::span<AddComponentCommand* const> commands);
+
+        // Bump allocates from the current arena block, moving on to the next block when it is full
+        void* Allocate(size_t size, size_t alignment);
+
+        std::vector<std::string> m_AddEntities;
+        std::vector<uint32_t> m_RemoveEntities;
+        std::vector<AddComponentCommand> m_AddComponents;
+        std::vector<RemoveComponentCommand> m_RemoveComponents;
+        // IDs given to this buffer's pending entities during playback, indexed by PendingEntity::index
+        std::vector<uint32_t> m_ResolvedEntities;
+
+        std::vector<ArenaBlock> m_ArenaBlocks;
+        uint32_t m_CurrentBlock = 0;
+        size_t m_BlockOffset = 0;
+    };
+}
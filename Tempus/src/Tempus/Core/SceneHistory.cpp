@@ -0,0 +1,130 @@
+// Copyright Levi Spevakow (C) 2025
+
+#include "SceneHistory.h"
+#include "Log.h"
+#include "Utils/Profiling.h"
+#include <chrono>
+#include <unordered_set>
+
+bool Tempus::SceneHistory::Record(Scene& scene)
+{
+    TPS_SCOPED_TIMER();
+
+    if (scene.GetSceneSerial() != m_SceneSerial)
+    {
+        Clear();
+        m_SceneSerial = scene.GetSceneSerial();
+    }
+
+    const SceneSnapshot* previous = m_Steps.empty() ? nullptr : m_Steps[m_CurrentStep].snapshot.get();
+
+    // Pages changed after the current step was captured or restored have a newer version than m_SceneVersion
+    const uint32_t captureVersion = scene.AdvanceChangeVersion();
+    const uint32_t sinceVersion = previous ? m_SceneVersion : 0;
+    m_SceneVersion = captureVersion;
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    SceneSnapshot::CaptureStats captureStats;
+    std::unique_ptr<SceneSnapshot> snapshot = SceneSnapshot::Capture(scene, previous, sinceVersion, m_Names, m_NameRemap, captureStats);
+    const double captureMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+    // Every page of the current step matched and nothing was added, nothing to undo
+    if (previous && captureStats.newPages == 0)
+    {
+        uint32_t previousPageCount = 0;
+        previous->ForEachPage([&previousPageCount](const SnapshotPageRef&) { previousPageCount++; });
+        if (captureStats.sharedPages == previousPageCount)
+        {
+            return false;
+        }
+    }
+
+    while (CanRedo())
+    {
+        m_RetainedBytes -= m_Steps.back().stats.retainedBytes;
+        m_Steps.pop_back();
+    }
+
+    Step& step = m_Steps.emplace_back();
+    step.snapshot = std::move(snapshot);
+    step.stats.captureMs = captureMs;
+    step.stats.newPages = captureStats.newPages;
+    step.stats.sharedPages = captureStats.sharedPages;
+    step.stats.retainedBytes = captureStats.newBytes;
+    m_RetainedBytes += captureStats.newBytes;
+    m_CurrentStep = m_Steps.size() - 1;
+
+    EnforceBudget();
+
+    TPS_CORE_TRACE("Undo step recorded! Scene: [{0}] Pages: [{1} new, {2} shared] Retained: [{3} KB]", scene.GetName(), captureStats.newPages, captureStats.sharedPages, captureStats.newBytes / 1024);
+    return true;
+}
+
+std::unique_ptr<Tempus::Scene> Tempus::SceneHistory::Undo(Scene* liveScene)
+{
+    return CanUndo() ? RestoreStep(m_CurrentStep - 1, liveScene) : nullptr;
+}
+
+std::unique_ptr<Tempus::Scene> Tempus::SceneHistory::Redo(Scene* liveScene)
+{
+    return CanRedo() ? RestoreStep(m_CurrentStep + 1, liveScene) : nullptr;
+}
+
+std::unique_ptr<Tempus::Scene> Tempus::SceneHistory::RestoreStep(size_t step, Scene* liveScene)
+{
+    TPS_SCOPED_TIMER();
+
+    std::unique_ptr<Scene> scene = m_Steps[step].snapshot->Restore(m_Names, liveScene);
+    if (!scene)
+    {
+        return nullptr;
+    }
+
+    // The restored scene matches the step, so the next recording is compared against it
+    m_CurrentStep = step;
+    m_SceneSerial = scene->GetSceneSerial();
+    m_SceneVersion = scene->AdvanceChangeVersion();
+    m_NameRemap.clear();
+    return scene;
+}
+
+void Tempus::SceneHistory::Clear()
+{
+    m_Steps.clear();
+    m_CurrentStep = 0;
+    m_RetainedBytes = 0;
+    m_SceneSerial = 0;
+    m_SceneVersion = 0;
+    m_Names = NameTable();
+    m_NameRemap.clear();
+}
+
+void Tempus::SceneHistory::SetMemoryBudget(size_t bytes)
+{
+    m_MemoryBudget = bytes;
+    EnforceBudget();
+}
+
+void Tempus::SceneHistory::EnforceBudget()
+{
+    while (m_RetainedBytes > m_MemoryBudget && m_CurrentStep > 0)
+    {
+        // Pages the next step shares with the evicted one stay alive, so they're now retained by the next step
+        std::unordered_set<const SnapshotPage*> evictedPages;
+        m_Steps.front().snapshot->ForEachPage([&evictedPages](const SnapshotPageRef& page) { evictedPages.insert(page.get()); });
+
+        size_t inheritedBytes = 0;
+        m_Steps[1].snapshot->ForEachPage([&evictedPages, &inheritedBytes](const SnapshotPageRef& page)
+        {
+            if (evictedPages.erase(page.get()) > 0)
+            {
+                inheritedBytes += page->GetSize();
+            }
+        });
+
+        m_Steps[1].stats.retainedBytes += inheritedBytes;
+        m_RetainedBytes -= m_Steps.front().stats.retainedBytes - inheritedBytes;
+        m_Steps.pop_front();
+        m_CurrentStep--;
+    }
+}
@@ -0,0 +1,91 @@
+// Copyright Levi Spevakow (C) 2025
+
+#pragma once
+
+#include "Core.h"
+#include "NameTable.h"
+#include "SceneSnapshot.h"
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace Tempus
+{
+    // Default cap on the snapshot memory kept for undo
+    constexpr size_t DEFAULT_UNDO_MEMORY_BUDGET = 256ull * 1024 * 1024;
+
+    // Undo and redo for editor operations, backed by copy-on-write scene snapshots.
+    // Every recorded step is a SceneSnapshot sharing the pages it didn't change with the step before, so each step only
+    // retains the pages its operation touched. When the retained pages exceed the memory budget the oldest steps are
+    // evicted first. Undo and redo build a new scene from a step, the caller replaces the live scene with it.
+    class TEMPUS_API SceneHistory
+    {
+    public:
+
+        struct StepStats
+        {
+            // Time to capture the step's snapshot
+            double captureMs = 0.0;
+            uint32_t newPages = 0;
+            uint32_t sharedPages = 0;
+            // Memory the step keeps alive, pages it shares with the step before are counted there
+            size_t retainedBytes = 0;
+        };
+
+        SceneHistory() = default;
+
+        // Captures the scene as a new step after the current one, discarding any steps that could be redone.
+        // Nothing is recorded if the scene is unchanged since the current step. A scene other than the one the history
+        // was recorded from starts a new history with the scene as its first step.
+        // Returns true if a step was added.
+        bool Record(Scene& scene);
+
+        bool CanUndo() const { return m_CurrentStep > 0; }
+        bool CanRedo() const { return m_CurrentStep + 1 < m_Steps.size(); }
+
+        // Scene as of the previous or next step, nullptr if there is none. liveScene provides the editor only entities,
+        // the returned scene is the one the history continues from.
+        std::unique_ptr<Scene> Undo(Scene* liveScene);
+        std::unique_ptr<Scene> Redo(Scene* liveScene);
+
+        void Clear();
+
+        // Evicts steps right away if the history is over the new budget
+        void SetMemoryBudget(size_t bytes);
+        size_t GetMemoryBudget() const { return m_MemoryBudget; }
+        size_t GetRetainedBytes() const { return m_RetainedBytes; }
+
+        uint32_t GetStepCount() const { return static_cast<uint32_t>(m_Steps.size()); }
+        uint32_t GetCurrentStep() const { return static_cast<uint32_t>(m_CurrentStep); }
+        const StepStats& GetStepStats(uint32_t step) const { return m_Steps[step].stats; }
+
+        SceneHistory(const SceneHistory&) = delete;
+        SceneHistory& operator=(const SceneHistory&) = delete;
+
+    private:
+
+        struct Step
+        {
+            std::unique_ptr<SceneSnapshot> snapshot;
+            StepStats stats;
+        };
+
+        std::unique_ptr<Scene> RestoreStep(size_t step, Scene* liveScene);
+        // Drops the oldest steps until the history fits its budget, the current step is always kept
+        void EnforceBudget();
+
+        std::deque<Step> m_Steps;
+        size_t m_CurrentStep = 0;
+        size_t m_RetainedBytes = 0;
+        size_t m_MemoryBudget = DEFAULT_UNDO_MEMORY_BUDGET;
+
+        // Serial of the scene the steps were recorded from or last restored into
+        uint64_t m_SceneSerial = 0;
+        // Change version of that scene when the current step was captured or restored, 0 before the first step
+        uint32_t m_SceneVersion = 0;
+        // Entity names of every step, so steps outlive the scenes they were captured from
+        NameTable m_Names;
+        // Scene name ID -> m_Names ID for the scene of m_SceneSerial
+        std::vector<NameId> m_NameRemap;
+    };
+}
@@ -0,0 +1,603 @@
+// Copyright Levi Spevakow (C) 2025
+
+#include "SceneSerializer.h"
+#include "Application.h"
+#include "Log.h"
+#include "Components/ComponentTypeTable.h"
+#include "Jobs/JobSystem.h"
+#include "Utils/FileUtils.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    using namespace Tempus;
+
+    constexpr char FileMagic[4] = { 'T', 'P', 'S', 'C' };
+    // Every section starts on this boundary, so component data in the mapping is suitably aligned for any component
+    constexpr uint64_t SectionAlignment = 16;
+    // Elements restored per job when a block is split across workers
+    constexpr uint32_t RestoreGrainSize = 16 * 1024;
+    constexpr uint32_t InvalidPosition = std::numeric_limits<uint32_t>::max();
+
+    TPS_STATIC_ASSERT(MAX_COMPONENTS <= 32, "Scene files store component signatures as 32 bits");
+
+    struct FileHeader
+    {
+        char magic[4] = {};
+        uint32_t version = 0;
+        uint32_t entityCount = 0;
+        uint32_t blockCount = 0;
+        uint32_t stringCount = 0;
+        // String table index of the scene's name
+        uint32_t sceneName = 0;
+        uint32_t storageMode = 0;
+        uint32_t padding = 0;
+        // Entity IDs, followed by their name string indices and signatures, each section aligned
+        uint64_t entityIdsOffset = 0;
+        uint64_t entityNamesOffset = 0;
+        uint64_t entitySignaturesOffset = 0;
+        uint64_t blocksOffset = 0;
+        // stringCount + 1 offsets into the string data, the last one is the data's size
+        uint64_t stringOffsetsOffset = 0;
+        uint64_t stringDataOffset = 0;
+    };
+
+    enum class BlockEncoding : uint32_t
+    {
+        Raw,
+        // Written through the type's encoder as SerializedRecords
+        Encoded
+    };
+
+    struct BlockHeader
+    {
+        uint32_t componentId = 0;
+        uint32_t count = 0;
+        uint32_t elementSize = 0;
+        BlockEncoding encoding = BlockEncoding::Raw;
+        uint64_t entityIdsOffset = 0;
+        uint64_t dataOffset = 0;
+    };
+
+    TPS_STATIC_ASSERT(std::is_trivially_copyable_v<FileHeader> && std::is_trivially_copyable_v<BlockHeader>, "Scene file headers are written raw");
+
+    uint64_t AlignOffset(uint64_t offset, uint64_t alignment)
+    {
+        return (offset + alignment - 1) & ~(alignment - 1);
+    }
+
+    class FileWriter
+    {
+    public:
+
+        // Pads to the section alignment and returns the offset of the appended data
+        uint64_t Append(const void* data, size_t size)
+        {
+            const uint64_t offset = AlignOffset(m_Data.size(), SectionAlignment);
+            m_Data.resize(offset + size);
+            if (size > 0)
+            {
+                std::memcpy(m_Data.data() + offset, data, size);
+            }
+            return offset;
+        }
+
+        template<typename T>
+        uint64_t Append(const std::vector<T>& values)
+        {
+            return Append(values.data(), values.size() * sizeof(T));
+        }
+
+        void Overwrite(uint64_t offset, const void* data, size_t size)
+        {
+            std::memcpy(m_Data.data() + offset, data, size);
+        }
+
+        const std::vector<std::byte>& GetData() const { return m_Data; }
+
+    private:
+
+        std::vector<std::byte> m_Data;
+    };
+
+    // Bounds and alignment checked view of an array in the mapped file, nullptr if it doesn't fit
+    template<typename T>
+    const T* GetArray(std::span<const std::byte> bytes, uint64_t offset, uint64_t count)
+    {
+        if (offset > bytes.size() || count > (bytes.size() - offset) / sizeof(T) || offset % alignof(T) != 0)
+        {
+            return nullptr;
+        }
+        return reinterpret_cast<const T*>(bytes.data() + offset);
+    }
+
+    // Serial when the job system isn't running
+    template<typename Func>
+    void ParallelFor(JobSystem* jobSystem, uint32_t count, uint32_t grainSize, Func&& func)
+    {
+        if (jobSystem && count > grainSize)
+        {
+            jobSystem->ParallelFor(count, grainSize, func);
+        }
+        else if (count > 0)
+        {
+            func(0u, count);
+        }
+    }
+}
+
+bool Tempus::SceneSerializer::Save(Scene& scene, const std::filesystem::path& path)
+{
+    const ComponentId noSerializeTag = EditorNoSerializeTag::GetId();
+    auto isSaved = [&scene, noSerializeTag](uint32_t id)
+    {
+        return !scene.m_EntityComponents[GetEntityIndex(id)].test(noSerializeTag);
+    };
+
+    ComponentSignature savedComponents;
+    ComponentSignature tagComponents;
+    for (const ComponentTypeInfo& info : TPS_Private::ComponentRegistry::GetRegisteredComponents())
+    {
+        savedComponents.set(info.id, info.IsSerializable());
+        tagComponents.set(info.id, info.bTag);
+    }
+
+    // Archetype scenes list entities in storage order, so loading fills each archetype's rows in the same order
+    std::vector<uint32_t> entityIds;
+    if (scene.m_ArchetypeStorage)
+    {
+        entityIds.reserve(scene.m_EntityList.size());
+        scene.m_ArchetypeStorage->ForEachArchetype(ComponentSignature(), [&entityIds](Archetype& archetype)
+        {
+            for (uint32_t chunk = 0; chunk < archetype.GetChunkCount(); chunk++)
+            {
+                const uint32_t* entities = archetype.GetEntities(chunk);
+                entityIds.insert(entityIds.end(), entities, entities + archetype.GetChunk(chunk).count);
+            }
+        });
+        // Entities with nothing but tags aren't in any archetype
+        std::vector<uint32_t> unstoredIds = scene.GetEntityIDs();
+        std::erase_if(unstoredIds, [&scene, &tagComponents](uint32_t id) { return (scene.m_EntityComponents[GetEntityIndex(id)] & ~tagComponents).any(); });
+        entityIds.insert(entityIds.end(), unstoredIds.begin(), unstoredIds.end());
+    }
+    else
+    {
+        scene.GetEntityIDs(entityIds);
+    }
+    std::erase_if(entityIds, [&isSaved](uint32_t id) { return !isSaved(id); });
+
+    NameTable strings;
+    const NameId sceneName = strings.Intern(scene.GetName());
+
+    // Scene name IDs are mapped to file string indices once per distinct name
+    std::vector<NameId> nameRemap(scene.m_NameTable.GetCount(), INVALID_NAME_ID);
+    std::vector<uint32_t> entityNames(entityIds.size());
+    std::vector<uint32_t> entitySignatures(entityIds.size());
+    for (size_t i = 0; i < entityIds.size(); i++)
+    {
+        const uint32_t index = GetEntityIndex(entityIds[i]);
+        const NameId nameId = scene.m_EntityNameIds[index];
+        if (nameId < nameRemap.size())
+        {
+            if (nameRemap[nameId] == INVALID_NAME_ID)
+            {
+                nameRemap[nameId] = strings.Intern(scene.m_NameTable.GetString(nameId));
+            }
+            entityNames[i] = nameRemap[nameId];
+        }
+        else
+        {
+            entityNames[i] = strings.Intern("");
+        }
+        entitySignatures[i] = static_cast<uint32_t>((scene.m_EntityComponents[index] & savedComponents).to_ulong());
+    }
+
+    FileWriter writer;
+    FileHeader header;
+    writer.Append(&header, sizeof(header));
+
+    std::vector<BlockHeader> blocks;
+    std::vector<uint32_t> blockIds;
+    std::vector<std::byte> blockData;
+    for (const ComponentTypeInfo& info : TPS_Private::ComponentRegistry::GetRegisteredComponents())
+    {
+        if (!info.IsSerializable() || info.bTag)
+        {
+            continue;
+        }
+
+        blockIds.clear();
+        blockData.clear();
+
+        // Appends the saved entities of a contiguous storage range, skipped entities split it into runs
+        auto appendRange = [&](const uint32_t* ids, const std::byte* components, uint32_t count)
+        {
+            uint32_t runBegin = 0;
+            for (uint32_t i = 0; i <= count; i++)
+            {
+                if (i < count && isSaved(ids[i]))
+                {
+                    continue;
+                }
+
+                const uint32_t runCount = i - runBegin;
+                if (runCount > 0)
+                {
+                    const std::byte* runComponents = components + runBegin * info.ops.size;
+                    const size_t dataOffset = blockData.size();
+                    blockIds.insert(blockIds.end(), ids + runBegin, ids + i);
+                    blockData.resize(dataOffset + runCount * info.serializedSize);
+                    if (info.encodeFunc)
+                    {
+                        info.encodeFunc(runComponents, blockData.data() + dataOffset, runCount, strings);
+                    }
+                    else
+                    {
+                        std::memcpy(blockData.data() + dataOffset, runComponents, runCount * info.serializedSize);
+                    }
+                }
+                runBegin = i + 1;
+            }
+        };
+
+        if (scene.m_ArchetypeStorage)
+        {
+            ComponentSignature required;
+            required.set(info.id);
+            scene.m_ArchetypeStorage->ForEachArchetype(required, [&appendRange, &info](Archetype& archetype)
+            {
+                for (uint32_t chunk = 0; chunk < archetype.GetChunkCount(); chunk++)
+                {
+                    appendRange(archetype.GetEntities(chunk), static_cast<const std::byte*>(archetype.GetColumn(chunk, info.id)), archetype.GetChunk(chunk).count);
+                }
+            });
+        }
+        else if (auto it = scene.m_ComponentPools.find(info.id); it != scene.m_ComponentPools.end())
+        {
+            const IComponentPool& pool = *it->second;
+            appendRange(pool.GetEntityIds().data(), static_cast<const std::byte*>(pool.GetComponentData()), pool.GetSize());
+        }
+
+        if (blockIds.empty())
+        {
+            continue;
+        }
+
+        BlockHeader& block = blocks.emplace_back();
+        block.componentId = info.id;
+        block.count = static_cast<uint32_t>(blockIds.size());
+        block.elementSize = info.serializedSize;
+        block.encoding = info.encodeFunc ? BlockEncoding::Encoded : BlockEncoding::Raw;
+        block.entityIdsOffset = writer.Append(blockIds);
+        block.dataOffset = writer.Append(blockData);
+    }
+
+    // Encoders may add strings, so the table is written last
+    std::vector<uint32_t> stringOffsets;
+    std::vector<char> stringData;
+    stringOffsets.reserve(strings.GetCount() + 1);
+    for (NameId stringId = 0; stringId < strings.GetCount(); stringId++)
+    {
+        const std::string_view string = strings.GetString(stringId);
+        stringOffsets.push_back(static_cast<uint32_t>(stringData.size()));
+        stringData.insert(stringData.end(), string.begin(), string.end());
+        stringData.push_back('\0');
+    }
+    stringOffsets.push_back(static_cast<uint32_t>(stringData.size()));
+
+    std::memcpy(header.magic, FileMagic, sizeof(FileMagic));
+    header.version = FileVersion;
+    header.entityCount = static_cast<uint32_t>(entityIds.size());
+    header.blockCount = static_cast<uint32_t>(blocks.size());
+    header.stringCount = strings.GetCount();
+    header.sceneName = sceneName;
+    header.storageMode = static_cast<uint32_t>(scene.GetStorageMode());
+    header.entityIdsOffset = writer.Append(entityIds);
+    header.entityNamesOffset = writer.Append(entityNames);
+    header.entitySignaturesOffset = writer.Append(entitySignatures);
+    header.blocksOffset = writer.Append(blocks);
+    header.stringOffsetsOffset = writer.Append(stringOffsets);
+    header.stringDataOffset = writer.Append(stringData);
+    writer.Overwrite(0, &header, sizeof(header));
+
+    std::error_code error;
+    if (path.has_parent_path())
+    {
+        std::filesystem::create_directories(path.parent_path(), error);
+    }
+
+    std::filesystem::path tempPath = path;
+    tempPath += ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(writer.GetData().data()), static_cast<std::streamsize>(writer.GetData().size()));
+        if (!file)
+        {
+            TPS_CORE_ERROR("Failed to write scene [{0}] to {1}", scene.GetName(), tempPath.string());
+            file.close();
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(tempPath, path, error);
+    if (error)
+    {
+        TPS_CORE_ERROR("Failed to replace {0}: {1}", path.string(), error.message());
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+
+    TPS_CORE_INFO("Scene [{0}] saved to {1}. Entities: [{2}] Blocks: [{3}] Size: [{4} KB]", scene.GetName(), path.string(), entityIds.size(), blocks.size(), writer.GetData().size() / 1024);
+    return true;
+}
+
+std::unique_ptr<Tempus::Scene> Tempus::SceneSerializer::Load(const std::filesystem::path& path)
+{
+    MappedFile file;
+    if (!file.Open(path))
+    {
+        TPS_CORE_ERROR("Failed to open scene file {0}", path.string());
+        return nullptr;
+    }
+
+    const std::span<const std::byte> bytes = file.GetBytes();
+    auto reportCorrupt = [&path](const char* reason)
+    {
+        TPS_CORE_ERROR("Failed to load scene file {0}, {1}!", path.string(), reason);
+        return nullptr;
+    };
+
+    FileHeader header;
+    if (bytes.size() < sizeof(header))
+    {
+        return reportCorrupt("file is too small");
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (std::memcmp(header.magic, FileMagic, sizeof(FileMagic)) != 0)
+    {
+        return reportCorrupt("not a scene file");
+    }
+    if (header.version != FileVersion)
+    {
+        TPS_CORE_ERROR("Failed to load scene file {0}, version {1} is not supported (expected {2})", path.string(), header.version, FileVersion);
+        return nullptr;
+    }
+    if (header.storageMode > static_cast<uint32_t>(SceneStorageMode::Archetypes))
+    {
+        return reportCorrupt("unknown storage mode");
+    }
+
+    // String table, views point straight into the mapping
+    const uint32_t* stringOffsets = GetArray<uint32_t>(bytes, header.stringOffsetsOffset, static_cast<uint64_t>(header.stringCount) + 1);
+    const char* stringData = stringOffsets ? GetArray<char>(bytes, header.stringDataOffset, stringOffsets[header.stringCount]) : nullptr;
+    if (!stringData)
+    {
+        return reportCorrupt("string table out of bounds");
+    }
+    const uint32_t stringDataSize = stringOffsets[header.stringCount];
+    std::vector<std::string_view> strings(header.stringCount);
+    for (uint32_t i = 0; i < header.stringCount; i++)
+    {
+        if (stringOffsets[i] >= stringOffsets[i + 1] || stringOffsets[i + 1] > stringDataSize || stringData[stringOffsets[i + 1] - 1] != '\0')
+        {
+            return reportCorrupt("malformed string table");
+        }
+        strings[i] = std::string_view(stringData + stringOffsets[i], stringOffsets[i + 1] - stringOffsets[i] - 1);
+    }
+
+    const uint32_t entityCount = header.entityCount;
+    const uint32_t* entityIds = GetArray<uint32_t>(bytes, header.entityIdsOffset, entityCount);
+    const uint32_t* entityNames = GetArray<uint32_t>(bytes, header.entityNamesOffset, entityCount);
+    const uint32_t* entitySignatures = GetArray<uint32_t>(bytes, header.entitySignaturesOffset, entityCount);
+    const BlockHeader* blocks = GetArray<BlockHeader>(bytes, header.blocksOffset, header.blockCount);
+    if (!entityIds || !entityNames || !entitySignatures || !blocks || header.sceneName >= header.stringCount)
+    {
+        return reportCorrupt("section out of bounds");
+    }
+
+    // Blocks of types that no longer exist, are no longer serialized or changed size are dropped from the signatures
+    ComponentSignature loadedComponents;
+    std::vector<const BlockHeader*> loadedBlocks;
+    for (const ComponentTypeInfo& info : TPS_Private::ComponentRegistry::GetRegisteredComponents())
+    {
+        loadedComponents.set(info.id, info.IsSerializable() && info.bTag);
+    }
+    for (uint32_t blockIndex = 0; blockIndex < header.blockCount; blockIndex++)
+    {
+        const BlockHeader& block = blocks[blockIndex];
+        const ComponentTypeInfo& info = TPS_Private::ComponentRegistry::GetComponentTypeFromId(static_cast<ComponentId>(std::min<uint32_t>(block.componentId, MAX_COMPONENTS)));
+        const BlockEncoding expectedEncoding = info.encodeFunc ? BlockEncoding::Encoded : BlockEncoding::Raw;
+        if (!info.IsSerializable() || info.bTag || block.elementSize != info.serializedSize || block.encoding != expectedEncoding)
+        {
+            TPS_CORE_WARN("Skipping component block [{0}] in scene file {1}, its type no longer matches", block.componentId, path.string());
+            continue;
+        }
+        if (loadedComponents.test(info.id))
+        {
+            return reportCorrupt("duplicate component block");
+        }
+        if (!GetArray<uint32_t>(bytes, block.entityIdsOffset, block.count) || !GetArray<std::byte>(bytes, block.dataOffset, static_cast<uint64_t>(block.count) * block.elementSize)
+            || block.dataOffset % std::max<uint64_t>(info.ops.alignment, 1) != 0)
+        {
+            return reportCorrupt("component block out of bounds");
+        }
+        loadedComponents.set(info.id);
+        loadedBlocks.push_back(&block);
+    }
+
+    // Every entity with a loaded component must be listed exactly once in that component's block
+    std::vector<ComponentSignature> signatures(entityCount);
+    std::array<uint32_t, MAX_COMPONENTS> componentCounts = {};
+    std::vector<uint32_t> positionBySlot;
+    for (uint32_t i = 0; i < entityCount; i++)
+    {
+        if (entityNames[i] >= header.stringCount)
+        {
+            return reportCorrupt("entity name out of bounds");
+        }
+
+        signatures[i] = ComponentSignature(entitySignatures[i]) & loadedComponents;
+        for (ComponentId componentId = 0; componentId < MAX_COMPONENTS; componentId++)
+        {
+            componentCounts[componentId] += signatures[i].test(componentId);
+        }
+
+        const uint32_t index = GetEntityIndex(entityIds[i]);
+        if (index >= positionBySlot.size())
+        {
+            positionBySlot.resize(index + 1, InvalidPosition);
+        }
+        if (positionBySlot[index] != InvalidPosition)
+        {
+            return reportCorrupt("duplicate entity");
+        }
+        positionBySlot[index] = i;
+    }
+
+    std::vector<uint32_t> lastBlockSeen(entityCount, InvalidPosition);
+    for (uint32_t blockIndex = 0; blockIndex < loadedBlocks.size(); blockIndex++)
+    {
+        const BlockHeader& block = *loadedBlocks[blockIndex];
+        if (block.count != componentCounts[block.componentId])
+        {
+            return reportCorrupt("component block doesn't match the entities");
+        }
+
+        const uint32_t* blockIds = GetArray<uint32_t>(bytes, block.entityIdsOffset, block.count);
+        for (uint32_t i = 0; i < block.count; i++)
+        {
+            const uint32_t index = GetEntityIndex(blockIds[i]);
+            const uint32_t position = index < positionBySlot.size() ? positionBySlot[index] : InvalidPosition;
+            if (position == InvalidPosition || entityIds[position] != blockIds[i] || !signatures[position].test(block.componentId) || lastBlockSeen[position] == blockIndex)
+            {
+                return reportCorrupt("component block doesn't match the entities");
+            }
+            lastBlockSeen[position] = blockIndex;
+        }
+    }
+
+    auto scene = std::make_unique<Scene>(std::string(strings[header.sceneName]), static_cast<SceneStorageMode>(header.storageMode));
+
+    // Each distinct name is interned once
+    std::vector<NameId> nameRemap(header.stringCount, INVALID_NAME_ID);
+    std::vector<NameId> nameIds(entityCount);
+    for (uint32_t i = 0; i < entityCount; i++)
+    {
+        NameId& nameId = nameRemap[entityNames[i]];
+        if (nameId == INVALID_NAME_ID)
+        {
+            nameId = scene->m_NameTable.Intern(strings[entityNames[i]]);
+        }
+        nameIds[i] = nameId;
+    }
+
+    if (!scene->RestoreEntities(std::span<const uint32_t>(entityIds, entityCount), nameIds, signatures))
+    {
+        return reportCorrupt("invalid entity IDs");
+    }
+
+    // Structural changes are made up front on this thread, the jobs below only copy component data into place
+    ArchetypeStorage* archetypeStorage = scene->m_ArchetypeStorage.get();
+    std::vector<std::byte*> poolData(loadedBlocks.size(), nullptr);
+    if (archetypeStorage)
+    {
+        ComponentSignature dataComponents;
+        for (const BlockHeader* block : loadedBlocks)
+        {
+            const ComponentTypeInfo& info = TPS_Private::ComponentRegistry::GetComponentTypeFromId(static_cast<ComponentId>(block->componentId));
+            archetypeStorage->RegisterType(info.id, info.ops);
+            dataComponents.set(info.id);
+        }
+
+        // Entities were saved in storage order, so grouping them by signature recreates each archetype's row order
+        std::unordered_map<ComponentSignature, std::vector<uint32_t>> entitiesByArchetype;
+        for (uint32_t i = 0; i < entityCount; i++)
+        {
+            entitiesByArchetype[signatures[i] & dataComponents].push_back(entityIds[i]);
+        }
+        for (const auto& [signature, ids] : entitiesByArchetype)
+        {
+            archetypeStorage->AddEntities(ids, signature);
+        }
+    }
+    else
+    {
+        for (size_t blockIndex = 0; blockIndex < loadedBlocks.size(); blockIndex++)
+        {
+            const BlockHeader& block = *loadedBlocks[blockIndex];
+            const ComponentTypeInfo& info = TPS_Private::ComponentRegistry::GetComponentTypeFromId(static_cast<ComponentId>(block.componentId));
+            IComponentPool* pool = scene->GetOrCreateComponentPool(info.id, info.createPoolFunc);
+            const uint32_t* blockIds = GetArray<uint32_t>(bytes, block.entityIdsOffset, block.count);
+            poolData[blockIndex] = static_cast<std::byte*>(pool->AddDefaultComponents(std::span<const uint32_t>(blockIds, block.count)));
+        }
+    }
+
+    JobSystem* jobSystem = GApp ? JOB_SYSTEM : nullptr;
+    ParallelFor(jobSystem, static_cast<uint32_t>(loadedBlocks.size()), 1, [&](uint32_t blockBegin, uint32_t blockEnd)
+    {
+        for (uint32_t blockIndex = blockBegin; blockIndex < blockEnd; blockIndex++)
+        {
+            const BlockHeader& block = *loadedBlocks[blockIndex];
+            const ComponentTypeInfo& info = TPS_Private::ComponentRegistry::GetComponentTypeFromId(static_cast<ComponentId>(block.componentId));
+            const uint32_t* blockIds = GetArray<uint32_t>(bytes, block.entityIdsOffset, block.count);
+            const std::byte* blockData = bytes.data() + block.dataOffset;
+
+            // Copies a run of records into components that are contiguous in storage
+            auto restoreRun = [&info, &strings, blockData](uint32_t first, uint32_t count, std::byte* components, bool bConstructed)
+            {
+                const std::byte* records = blockData + static_cast<size_t>(first) * info.serializedSize;
+                if (!info.decodeFunc)
+                {
+                    std::memcpy(components, records, static_cast<size_t>(count) * info.serializedSize);
+                    return;
+                }
+                if (!bConstructed)
+                {
+                    info.ops.defaultConstruct(components, count);
+                }
+                info.decodeFunc(records, components, count, strings);
+            };
+
+            ParallelFor(jobSystem, block.count, RestoreGrainSize, [&](uint32_t begin, uint32_t end)
+            {
+                if (!archetypeStorage)
+                {
+                    restoreRun(begin, end - begin, poolData[blockIndex] + static_cast<size_t>(begin) * info.ops.size, true);
+                    return;
+                }
+
+                // Rows of one archetype chunk were saved next to each other, so each run only needs one location
+                // lookup and is extended by comparing against the chunk's entity column
+                for (uint32_t runBegin = begin; runBegin < end;)
+                {
+                    const ArchetypeStorage::EntityLocation& location = *archetypeStorage->GetLocation(blockIds[runBegin]);
+                    Archetype& archetype = *location.archetype;
+                    const uint32_t* chunkEntities = archetype.GetEntities(location.chunk);
+                    const uint32_t maxCount = std::min(end - runBegin, archetype.GetChunk(location.chunk).count - location.row);
+
+                    uint32_t runCount = 1;
+                    while (runCount < maxCount && chunkEntities[location.row + runCount] == blockIds[runBegin + runCount])
+                    {
+                        runCount++;
+                    }
+
+                    restoreRun(runBegin, runCount, static_cast<std::byte*>(archetype.GetComponent(location.chunk, location.row, info.id)), false);
+                    runBegin += runCount;
+                }
+            });
+        }
+    });
+
+    TPS_CORE_INFO("Scene [{0}] loaded from {1}. Entities: [{2}] Blocks: [{3}]", scene->GetName(), path.string(), entityCount, loadedBlocks.size());
+    return scene;
+}
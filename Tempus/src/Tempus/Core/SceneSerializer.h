@@ -0,0 +1,36 @@
+// Copyright Levi Spevakow (C) 2025
+
+#pragma once
+
+#include "Core.h"
+#include "Scene.h"
+#include <filesystem>
+#include <memory>
+
+namespace Tempus
+{
+    // Versioned binary scene files, laid out so loading is mostly bulk copies out of a memory mapping:
+    // - Header, then the saved entities as parallel arrays of IDs, name string indices and component signatures
+    // - One block per component type, holding the IDs of the entities that have it followed by their components in
+    //   storage order. Trivially copyable types are copied raw, types declaring a SerializedRecord go through its
+    //   encoder (see ComponentTypeInfo). Tags only exist in the signatures.
+    // - A string table of the scene name, the entity names and every string an encoder referenced
+    // Entities tagged EditorNoSerializeTag and component types flagged NoSerialize are left out, derived components
+    // such as WorldTransformComponent are rebuilt by their systems. Entity IDs are kept as they were, so IDs stored
+    // in components, e.g. HierarchyComponent::Parent, stay valid.
+    class TEMPUS_API SceneSerializer
+    {
+    public:
+
+        static constexpr uint32_t FileVersion = 1;
+        static constexpr const char* FileExtension = ".tscene";
+
+        // Written to a temporary file first, so a failed save leaves an existing file untouched
+        static bool Save(Scene& scene, const std::filesystem::path& path);
+
+        // Maps the file and restores every component block in parallel on the job system.
+        // The scene uses the storage mode it was saved with. nullptr if the file can't be read, was written by
+        // another file version or is corrupt. Blocks of component types whose size has changed since are skipped.
+        static std::unique_ptr<Scene> Load(const std::filesystem::path& path);
+    };
+}
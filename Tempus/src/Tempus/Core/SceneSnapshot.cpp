@@ -0,0 +1,474 @@
+// Copyright Levi Spevakow (C) 2025
+
+#include "SceneSnapshot.h"
+#include "Application.h"
+#include "Log.h"
+#include "Components/ComponentTypeTable.h"
+#include "Jobs/JobSystem.h"
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <unordered_map>
+
+namespace
+{
+    using namespace Tempus;
+
+    // Pages restored per job
+    constexpr uint32_t RestorePageGrainSize = 16;
+
+    struct ArrayLayout
+    {
+        size_t elementSize = 0;
+        size_t alignment = 0;
+        // nullptr for plain data
+        const ComponentTypeOps* ops = nullptr;
+        // Derived data only has to line up with the live array, its values are recomputed after a restore
+        bool bDerived = false;
+    };
+
+    template<typename T>
+    constexpr ArrayLayout PlainLayout = { sizeof(T), alignof(T), nullptr, false };
+
+    // NoSerialize components are rebuilt by their systems, e.g. WorldTransformComponent
+    bool IsDerivedComponent(ComponentId componentId)
+    {
+        return EnumCheckFlag(TPS_Private::ComponentRegistry::GetComponentTypeFromId(componentId).metadata, ComponentMetaFlags::NoSerialize);
+    }
+
+    // Whether count elements at src match the elements at offset in the page, skipping the rows in ignoredRows (ascending)
+    bool MatchesPage(const SnapshotPage& page, size_t offset, const std::byte* src, uint32_t count, size_t elementSize, std::span<const uint32_t> ignoredRows)
+    {
+        const std::byte* pageData = page.GetData() + offset;
+        uint32_t begin = 0;
+        for (uint32_t row : ignoredRows)
+        {
+            if (std::memcmp(src + begin * elementSize, pageData + begin * elementSize, (row - begin) * elementSize) != 0)
+            {
+                return false;
+            }
+            begin = row + 1;
+        }
+        return std::memcmp(src + begin * elementSize, pageData + begin * elementSize, (count - begin) * elementSize) == 0;
+    }
+
+    // Rows of ignoredRows (ascending) within [begin, begin + count), relative to begin
+    void GetPageIgnoredRows(std::span<const uint32_t> ignoredRows, uint32_t begin, uint32_t count, std::vector<uint32_t>& outRows)
+    {
+        outRows.clear();
+        for (auto it = std::ranges::lower_bound(ignoredRows, begin); it != ignoredRows.end() && *it < begin + count; ++it)
+        {
+            outRows.push_back(*it - begin);
+        }
+    }
+
+    // Pages the array, sharing every page whose elements match the page at the same position in previous.
+    // Pages changes reports unchanged since sinceVersion are shared without comparing them.
+    void CaptureArray(const void* data, uint32_t count, const ArrayLayout& layout, std::span<const uint32_t> ignoredRows, const SnapshotArray* previous,
+        const IComponentPool* changes, uint32_t sinceVersion, SnapshotArray& outArray, SceneSnapshot::CaptureStats& stats)
+    {
+        const uint32_t elementsPerPage = static_cast<uint32_t>(std::max<size_t>(SNAPSHOT_PAGE_SIZE / layout.elementSize, 1));
+        const std::byte* bytes = static_cast<const std::byte*>(data);
+        std::vector<uint32_t> pageIgnoredRows;
+
+        outArray.count = count;
+        outArray.pages.reserve((count + elementsPerPage - 1) / elementsPerPage);
+        for (uint32_t begin = 0, pageIndex = 0; begin < count; begin += elementsPerPage, pageIndex++)
+        {
+            const uint32_t pageCount = std::min(elementsPerPage, count - begin);
+            const std::byte* src = bytes + begin * layout.elementSize;
+
+            if (previous && pageIndex < previous->pages.size())
+            {
+                const SnapshotPageRef& previousPage = previous->pages[pageIndex];
+                bool bMatches = previousPage->GetCount() == pageCount && (layout.bDerived || (changes && changes->GetChangeVersion(begin, pageCount) <= sinceVersion));
+                if (!bMatches && previousPage->GetCount() == pageCount)
+                {
+                    GetPageIgnoredRows(ignoredRows, begin, pageCount, pageIgnoredRows);
+                    bMatches = MatchesPage(*previousPage, 0, src, pageCount, layout.elementSize, pageIgnoredRows);
+                }
+                if (bMatches)
+                {
+                    outArray.pages.push_back(previousPage);
+                    stats.sharedPages++;
+                    continue;
+                }
+            }
+
+            auto page = std::make_shared<SnapshotPage>(pageCount * layout.elementSize, layout.alignment, pageCount);
+            page->CopyObjects(0, src, pageCount, layout.elementSize, layout.ops);
+            stats.newPages++;
+            stats.newBytes += page->GetSize();
+            outArray.pages.push_back(std::move(page));
+        }
+    }
+
+    template<typename T>
+    std::vector<T> GatherArray(const SnapshotArray& array)
+    {
+        std::vector<T> values(array.count);
+        size_t offset = 0;
+        for (const SnapshotPageRef& page : array.pages)
+        {
+            std::memcpy(values.data() + offset, page->GetData(), page->GetCount() * sizeof(T));
+            offset += page->GetCount();
+        }
+        return values;
+    }
+
+    // Copies snapshotted components into a restored scene's storage
+    struct RestoreCopy
+    {
+        std::byte* dst = nullptr;
+        const std::byte* src = nullptr;
+        uint32_t count = 0;
+        const ComponentTypeOps* ops = nullptr;
+        // Pools default construct their new components, archetype rows are left unconstructed
+        bool bConstructed = false;
+    };
+}
+
+Tempus::SnapshotPage::SnapshotPage(size_t size, size_t alignment, uint32_t count)
+    : m_Size(size), m_Alignment(std::max(alignment, alignof(std::max_align_t))), m_Count(count)
+{
+    m_Data = static_cast<std::byte*>(::operator new(std::max<size_t>(m_Size, 1), std::align_val_t(m_Alignment)));
+}
+
+Tempus::SnapshotPage::~SnapshotPage()
+{
+    for (const ObjectRange& range : m_Objects)
+    {
+        range.destroy(m_Data + range.offset, range.count);
+    }
+    ::operator delete(m_Data, std::align_val_t(m_Alignment));
+}
+
+void Tempus::SnapshotPage::CopyObjects(size_t offset, const void* src, uint32_t count, size_t elementSize, const ComponentTypeOps* ops)
+{
+    if (ops && !ops->bTriviallyCopyable)
+    {
+        ops->copyConstruct(m_Data + offset, src, count);
+        m_Objects.push_back({ offset, count, ops->destroy });
+    }
+    else
+    {
+        std::memcpy(m_Data + offset, src, count * elementSize);
+    }
+}
+
+std::unique_ptr<Tempus::SceneSnapshot> Tempus::SceneSnapshot::Capture(Scene& scene, const SceneSnapshot* previous, uint32_t sinceVersion, NameTable& names, std::vector<NameId>& nameRemap,
+    CaptureStats& outStats)
+{
+    auto snapshot = std::make_unique<SceneSnapshot>();
+    snapshot->m_SceneName = scene.GetName();
+    snapshot->m_StorageMode = scene.GetStorageMode();
+    if (previous && previous->m_StorageMode != snapshot->m_StorageMode)
+    {
+        previous = nullptr;
+    }
+    if (!previous)
+    {
+        sinceVersion = 0;
+    }
+
+    const std::vector<uint32_t>& entityList = scene.m_EntityList;
+    const uint32_t entityCount = static_cast<uint32_t>(entityList.size());
+    if (sinceVersion > 0 && scene.GetEntityListChangeVersion() <= sinceVersion)
+    {
+        // No entity was created, destroyed, renamed or changed signature, so the entity arrays carry over whole
+        snapshot->m_EntityIds = previous->m_EntityIds;
+        snapshot->m_EntityNames = previous->m_EntityNames;
+        snapshot->m_EntitySignatures = previous->m_EntitySignatures;
+        snapshot->m_EditorEntities = previous->m_EditorEntities;
+        outStats.sharedPages += static_cast<uint32_t>(snapshot->m_EntityIds.pages.size() + snapshot->m_EntityNames.pages.size() + snapshot->m_EntitySignatures.pages.size());
+    }
+    else
+    {
+        // Names and signatures in entity list order, editor only entities are collected along the way
+        const ComponentId noSerializeTag = EditorNoSerializeTag::GetId();
+        std::vector<NameId> entityNames(entityCount);
+        std::vector<ComponentSignature> entitySignatures(entityCount);
+        nameRemap.resize(scene.m_NameTable.GetCount(), INVALID_NAME_ID);
+        for (uint32_t i = 0; i < entityCount; i++)
+        {
+            const uint32_t index = GetEntityIndex(entityList[i]);
+            const NameId nameId = scene.m_EntityNameIds[index];
+            if (nameRemap[nameId] == INVALID_NAME_ID)
+            {
+                nameRemap[nameId] = names.Intern(scene.m_NameTable.GetString(nameId));
+            }
+            entityNames[i] = nameRemap[nameId];
+            entitySignatures[i] = scene.m_EntityComponents[index];
+            if (entitySignatures[i].test(noSerializeTag))
+            {
+                snapshot->m_EditorEntities.push_back(entityList[i]);
+            }
+        }
+
+        CaptureArray(entityList.data(), entityCount, PlainLayout<uint32_t>, {}, previous ? &previous->m_EntityIds : nullptr, nullptr, 0, snapshot->m_EntityIds, outStats);
+        CaptureArray(entityNames.data(), entityCount, PlainLayout<NameId>, {}, previous ? &previous->m_EntityNames : nullptr, nullptr, 0, snapshot->m_EntityNames, outStats);
+        CaptureArray(entitySignatures.data(), entityCount, PlainLayout<ComponentSignature>, {}, previous ? &previous->m_EntitySignatures : nullptr, nullptr, 0,
+            snapshot->m_EntitySignatures, outStats);
+    }
+    const std::vector<uint32_t>& editorEntities = snapshot->m_EditorEntities;
+
+    std::vector<uint32_t> ignoredRows;
+    if (ArchetypeStorage* storage = scene.m_ArchetypeStorage.get())
+    {
+        std::unordered_map<ComponentSignature, const ArchetypeSnapshot*> previousArchetypes;
+        if (previous)
+        {
+            for (const ArchetypeSnapshot& archetype : previous->m_Archetypes)
+            {
+                previousArchetypes.emplace(archetype.signature, &archetype);
+            }
+        }
+
+        storage->ForEachArchetype(ComponentSignature(), [&](Archetype& archetype)
+        {
+            if (archetype.GetEntityCount() == 0)
+            {
+                return;
+            }
+
+            ArchetypeSnapshot& archetypeSnapshot = snapshot->m_Archetypes.emplace_back();
+            archetypeSnapshot.signature = archetype.GetSignature();
+            const std::byte* firstChunk = archetype.GetChunk(0).data;
+            for (ComponentId componentId = 0; componentId < MAX_COMPONENTS; componentId++)
+            {
+                if (archetypeSnapshot.signature.test(componentId))
+                {
+                    const size_t offset = static_cast<size_t>(static_cast<const std::byte*>(archetype.GetColumn(0, componentId)) - firstChunk);
+                    archetypeSnapshot.columns.push_back({ componentId, offset });
+                }
+            }
+
+            auto previousIt = previousArchetypes.find(archetypeSnapshot.signature);
+            const ArchetypeSnapshot* previousArchetype = previousIt != previousArchetypes.end() ? previousIt->second : nullptr;
+
+            archetypeSnapshot.chunks.reserve(archetype.GetChunkCount());
+            for (uint32_t chunk = 0; chunk < archetype.GetChunkCount(); chunk++)
+            {
+                const uint32_t count = archetype.GetChunk(chunk).count;
+                const uint32_t* entities = archetype.GetEntities(chunk);
+
+                if (previousArchetype && chunk < previousArchetype->chunks.size())
+                {
+                    const SnapshotPageRef& previousPage = previousArchetype->chunks[chunk];
+                    if (previousPage->GetCount() == count && archetype.GetChunk(chunk).changeVersion <= sinceVersion)
+                    {
+                        archetypeSnapshot.chunks.push_back(previousPage);
+                        outStats.sharedPages++;
+                        continue;
+                    }
+
+                    ignoredRows.clear();
+                    for (uint32_t entityId : editorEntities)
+                    {
+                        const ArchetypeStorage::EntityLocation* location = storage->GetLocation(entityId);
+                        if (location && location->archetype == &archetype && location->chunk == chunk)
+                        {
+                            ignoredRows.push_back(location->row);
+                        }
+                    }
+                    std::ranges::sort(ignoredRows);
+
+                    bool bMatches = previousPage->GetCount() == count && std::memcmp(previousPage->GetData(), entities, count * sizeof(uint32_t)) == 0;
+                    for (size_t column = 0; bMatches && column < archetypeSnapshot.columns.size(); column++)
+                    {
+                        const ArchetypeColumn& archetypeColumn = archetypeSnapshot.columns[column];
+                        if (IsDerivedComponent(archetypeColumn.componentId))
+                        {
+                            continue;
+                        }
+                        const std::byte* components = static_cast<const std::byte*>(archetype.GetColumn(chunk, archetypeColumn.componentId));
+                        const size_t elementSize = TPS_Private::ComponentRegistry::GetComponentTypeFromId(archetypeColumn.componentId).ops.size;
+                        bMatches = MatchesPage(*previousPage, archetypeColumn.offset, components, count, elementSize, ignoredRows);
+                    }
+                    if (bMatches)
+                    {
+                        archetypeSnapshot.chunks.push_back(previousPage);
+                        outStats.sharedPages++;
+                        continue;
+                    }
+                }
+
+                auto page = std::make_shared<SnapshotPage>(ARCHETYPE_CHUNK_SIZE, alignof(ArchetypeChunk), count);
+                page->CopyObjects(0, entities, count, sizeof(uint32_t), nullptr);
+                for (const ArchetypeColumn& archetypeColumn : archetypeSnapshot.columns)
+                {
+                    const ComponentTypeOps& ops = TPS_Private::ComponentRegistry::GetComponentTypeFromId(archetypeColumn.componentId).ops;
+                    page->CopyObjects(archetypeColumn.offset, archetype.GetColumn(chunk, archetypeColumn.componentId), count, ops.size, &ops);
+                }
+                outStats.newPages++;
+                outStats.newBytes += page->GetSize();
+                archetypeSnapshot.chunks.push_back(std::move(page));
+            }
+        });
+    }
+    else
+    {
+        for (const auto& [componentId, pool] : scene.m_ComponentPools)
+        {
+            const uint32_t count = pool->GetSize();
+            if (count == 0)
+            {
+                continue;
+            }
+
+            const ComponentTypeOps& ops = TPS_Private::ComponentRegistry::GetComponentTypeFromId(componentId).ops;
+            const std::byte* components = static_cast<const std::byte*>(pool->GetComponentData());
+            ignoredRows.clear();
+            for (uint32_t entityId : editorEntities)
+            {
+                if (const void* component = pool->GetComponentMemory(entityId))
+                {
+                    ignoredRows.push_back(static_cast<uint32_t>((static_cast<const std::byte*>(component) - components) / ops.size));
+                }
+            }
+            std::ranges::sort(ignoredRows);
+
+            const PoolSnapshot* previousPool = nullptr;
+            if (previous)
+            {
+                auto it = std::ranges::find(previous->m_Pools, componentId, &PoolSnapshot::componentId);
+                previousPool = it != previous->m_Pools.end() ? &*it : nullptr;
+            }
+
+            PoolSnapshot& poolSnapshot = snapshot->m_Pools.emplace_back();
+            poolSnapshot.componentId = componentId;
+            CaptureArray(pool->GetEntityIds().data(), count, PlainLayout<uint32_t>, {}, previousPool ? &previousPool->entityIds : nullptr, pool.get(), sinceVersion,
+                poolSnapshot.entityIds, outStats);
+            CaptureArray(components, count, { ops.size, ops.alignment, &ops, IsDerivedComponent(componentId) }, ignoredRows, previousPool ? &previousPool->components : nullptr,
+                pool.get(), sinceVersion, poolSnapshot.components, outStats);
+        }
+    }
+
+    return snapshot;
+}
+
+std::unique_ptr<Tempus::Scene> Tempus::SceneSnapshot::Restore(const NameTable& names, Scene* liveScene) const
+{
+    auto scene = std::make_unique<Scene>(m_SceneName, m_StorageMode);
+
+    const std::vector<uint32_t> entityIds = GatherArray<uint32_t>(m_EntityIds);
+    const std::vector<ComponentSignature> signatures = GatherArray<ComponentSignature>(m_EntitySignatures);
+    std::vector<NameId> nameIds = GatherArray<NameId>(m_EntityNames);
+
+    // Each distinct name is interned once
+    std::vector<NameId> nameRemap(names.GetCount(), INVALID_NAME_ID);
+    for (NameId& nameId : nameIds)
+    {
+        NameId& sceneNameId = nameRemap[nameId];
+        if (sceneNameId == INVALID_NAME_ID)
+        {
+            sceneNameId = scene->m_NameTable.Intern(names.GetString(nameId));
+        }
+        nameId = sceneNameId;
+    }
+
+    if (!scene->RestoreEntities(entityIds, nameIds, signatures))
+    {
+        TPS_CORE_ERROR("Failed to restore snapshot of scene [{0}]!", m_SceneName);
+        return nullptr;
+    }
+
+    // Structural changes are made up front on this thread, the jobs below only copy component data into place
+    std::vector<RestoreCopy> copies;
+    if (ArchetypeStorage* storage = scene->m_ArchetypeStorage.get())
+    {
+        std::vector<uint32_t> archetypeIds;
+        for (const ArchetypeSnapshot& archetypeSnapshot : m_Archetypes)
+        {
+            for (const ArchetypeColumn& column : archetypeSnapshot.columns)
+            {
+                storage->RegisterType(column.componentId, TPS_Private::ComponentRegistry::GetComponentTypeFromId(column.componentId).ops);
+            }
+
+            archetypeIds.clear();
+            for (const SnapshotPageRef& page : archetypeSnapshot.chunks)
+            {
+                const uint32_t* entities = reinterpret_cast<const uint32_t*>(page->GetData());
+                archetypeIds.insert(archetypeIds.end(), entities, entities + page->GetCount());
+            }
+
+            // Rows are filled chunk by chunk in the order given, so every chunk lines up with its page
+            storage->AddEntities(archetypeIds, archetypeSnapshot.signature);
+            Archetype& archetype = *storage->GetLocation(archetypeIds.front())->archetype;
+            for (uint32_t chunk = 0; chunk < archetypeSnapshot.chunks.size(); chunk++)
+            {
+                const SnapshotPage& page = *archetypeSnapshot.chunks[chunk];
+                for (const ArchetypeColumn& column : archetypeSnapshot.columns)
+                {
+                    const ComponentTypeOps& ops = TPS_Private::ComponentRegistry::GetComponentTypeFromId(column.componentId).ops;
+                    copies.push_back({ static_cast<std::byte*>(archetype.GetColumn(chunk, column.componentId)), page.GetData() + column.offset, page.GetCount(), &ops, false });
+                }
+            }
+        }
+    }
+    else
+    {
+        for (const PoolSnapshot& poolSnapshot : m_Pools)
+        {
+            const ComponentTypeInfo& info = TPS_Private::ComponentRegistry::GetComponentTypeFromId(poolSnapshot.componentId);
+            IComponentPool* pool = scene->GetOrCreateComponentPool(info.id, info.createPoolFunc);
+            const std::vector<uint32_t> poolIds = GatherArray<uint32_t>(poolSnapshot.entityIds);
+            std::byte* components = static_cast<std::byte*>(pool->AddDefaultComponents(poolIds));
+            for (const SnapshotPageRef& page : poolSnapshot.components.pages)
+            {
+                copies.push_back({ components, page->GetData(), page->GetCount(), &info.ops, true });
+                components += page->GetCount() * info.ops.size;
+            }
+        }
+    }
+
+    auto restoreCopies = [&copies](uint32_t begin, uint32_t end)
+    {
+        for (uint32_t i = begin; i < end; i++)
+        {
+            const RestoreCopy& copy = copies[i];
+            if (copy.bConstructed)
+            {
+                copy.ops->destroy(copy.dst, copy.count);
+            }
+            copy.ops->copyConstruct(copy.dst, copy.src, copy.count);
+        }
+    };
+    JobSystem* jobSystem = GApp ? JOB_SYSTEM : nullptr;
+    if (jobSystem && copies.size() > RestorePageGrainSize)
+    {
+        jobSystem->ParallelFor(static_cast<uint32_t>(copies.size()), RestorePageGrainSize, restoreCopies);
+    }
+    else
+    {
+        restoreCopies(0, static_cast<uint32_t>(copies.size()));
+    }
+
+    // Editor only entities aren't part of the history, so they keep what they have in the live scene
+    if (liveScene)
+    {
+        const ComponentId noSerializeTag = EditorNoSerializeTag::GetId();
+        for (uint32_t id : liveScene->m_EntityList)
+        {
+            const ComponentSignature& signature = liveScene->m_EntityComponents[GetEntityIndex(id)];
+            if (!signature.test(noSerializeTag) || !scene->HasEntity(id) || scene->m_EntityComponents[GetEntityIndex(id)] != signature)
+            {
+                continue;
+            }
+
+            for (ComponentId componentId = 0; componentId < MAX_COMPONENTS; componentId++)
+            {
+                const void* src = signature.test(componentId) ? liveScene->GetComponentMemory(id, componentId) : nullptr;
+                void* dst = src ? scene->GetComponentMemory(id, componentId) : nullptr;
+                if (dst)
+                {
+                    const ComponentTypeOps& ops = TPS_Private::ComponentRegistry::GetComponentTypeFromId(componentId).ops;
+                    ops.destroy(dst, 1);
+                    ops.copyConstruct(dst, src, 1);
+                }
+            }
+        }
+    }
+
+    return scene;
+}
@@ -0,0 +1,167 @@
+// Copyright Levi Spevakow (C) 2025
+
+#pragma once
+
+#include "Core.h"
+#include "Scene.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Tempus
+{
+    // Bytes of array data held by a single snapshot page, archetype pages hold a whole chunk instead
+    constexpr size_t SNAPSHOT_PAGE_SIZE = ARCHETYPE_CHUNK_SIZE;
+
+    // Immutable copy of a fixed size piece of scene storage. Consecutive snapshots in which the piece didn't change
+    // share the same page, so a snapshot only allocates and copies the pages that were touched since the one before.
+    // Components that aren't trivially relocatable are copy constructed into the page and destroyed with it.
+    class TEMPUS_API SnapshotPage
+    {
+    public:
+
+        SnapshotPage(size_t size, size_t alignment, uint32_t count);
+        ~SnapshotPage();
+
+        const std::byte* GetData() const { return m_Data; }
+        std::byte* GetData() { return m_Data; }
+        size_t GetSize() const { return m_Size; }
+        // Elements held, or rows for an archetype chunk page
+        uint32_t GetCount() const { return m_Count; }
+
+        // Copies count objects into the page, constructing them with the type's ops if it has any
+        void CopyObjects(size_t offset, const void* src, uint32_t count, size_t elementSize, const ComponentTypeOps* ops);
+
+        SnapshotPage(const SnapshotPage&) = delete;
+        SnapshotPage& operator=(const SnapshotPage&) = delete;
+
+    private:
+
+        struct ObjectRange
+        {
+            size_t offset = 0;
+            uint32_t count = 0;
+            void (*destroy)(void* ptr, uint32_t count) = nullptr;
+        };
+
+        std::byte* m_Data = nullptr;
+        size_t m_Size = 0;
+        size_t m_Alignment = 0;
+        uint32_t m_Count = 0;
+        std::vector<ObjectRange> m_Objects;
+    };
+
+    using SnapshotPageRef = std::shared_ptr<const SnapshotPage>;
+
+    // Array of elements split into pages of SNAPSHOT_PAGE_SIZE bytes
+    struct SnapshotArray
+    {
+        std::vector<SnapshotPageRef> pages;
+        uint32_t count = 0;
+    };
+
+    // Copy of a scene's entities and components at one point in time, see SceneHistory.
+    // Capture() shares every page of live storage that hasn't changed since the previous snapshot with the page at the
+    // same position in it, so memory and copying scale with the pages an edit touched rather than the scene size.
+    // Pages whose pool page or archetype chunk change version is no newer than the previous capture are shared without
+    // reading them, the rest are compared byte for byte. Writes must therefore go through GetMutableComponent() or
+    // MarkComponentChanged(), like any other change a system should see. Component pools are paged by dense index and
+    // archetypes by chunk, so adding, changing or removing a component only dirties the pages of the rows it moved.
+    // Entities tagged EditorNoSerializeTag, such as the editor camera, are ignored when comparing and keep their live
+    // state when a snapshot is restored.
+    // Components flagged NoSerialize are derived data their systems rebuild after a restore, so their pages are only
+    // recopied when their size changes and updating them alone doesn't count as an edit.
+    class TEMPUS_API SceneSnapshot
+    {
+    public:
+
+        struct CaptureStats
+        {
+            // Pages allocated by this capture and their size, the memory the snapshot adds to its history
+            uint32_t newPages = 0;
+            uint32_t sharedPages = 0;
+            size_t newBytes = 0;
+        };
+
+        // previous must have been captured from the same scene at change version sinceVersion, see
+        // Scene::AdvanceChangeVersion(), or sinceVersion must be 0 to compare every page with it.
+        // Names are stored as IDs into the history's name table, nameRemap caches scene name ID -> history name ID
+        // across captures of the same scene and must be cleared when the scene changes.
+        static std::unique_ptr<SceneSnapshot> Capture(Scene& scene, const SceneSnapshot* previous, uint32_t sinceVersion, NameTable& names, std::vector<NameId>& nameRemap,
+            CaptureStats& outStats);
+
+        // Builds a new scene holding the snapshotted entities with their IDs and components. Editor only entities
+        // that also exist in liveScene keep the component values they have there.
+        std::unique_ptr<Scene> Restore(const NameTable& names, Scene* liveScene) const;
+
+        uint32_t GetEntityCount() const { return m_EntityIds.count; }
+
+        // Visits every page the snapshot references, shared or not
+        template<typename Func>
+        void ForEachPage(Func&& func) const
+        {
+            for (const SnapshotArray* array : { &m_EntityIds, &m_EntityNames, &m_EntitySignatures })
+            {
+                for (const SnapshotPageRef& page : array->pages)
+                {
+                    func(page);
+                }
+            }
+            for (const PoolSnapshot& pool : m_Pools)
+            {
+                for (const SnapshotPageRef& page : pool.entityIds.pages)
+                {
+                    func(page);
+                }
+                for (const SnapshotPageRef& page : pool.components.pages)
+                {
+                    func(page);
+                }
+            }
+            for (const ArchetypeSnapshot& archetype : m_Archetypes)
+            {
+                for (const SnapshotPageRef& page : archetype.chunks)
+                {
+                    func(page);
+                }
+            }
+        }
+
+    private:
+
+        struct PoolSnapshot
+        {
+            ComponentId componentId = 0;
+            SnapshotArray entityIds;
+            SnapshotArray components;
+        };
+
+        struct ArchetypeColumn
+        {
+            ComponentId componentId = 0;
+            // Offset of the column from the start of the chunk
+            size_t offset = 0;
+        };
+
+        // One page per chunk, holding the entity column and every component column at their chunk offsets
+        struct ArchetypeSnapshot
+        {
+            ComponentSignature signature;
+            std::vector<ArchetypeColumn> columns;
+            std::vector<SnapshotPageRef> chunks;
+        };
+
+        std::string m_SceneName;
+        SceneStorageMode m_StorageMode = SceneStorageMode::ComponentPools;
+
+        // In the scene's entity list order
+        SnapshotArray m_EntityIds;
+        SnapshotArray m_EntityNames;
+        SnapshotArray m_EntitySignatures;
+        // EditorNoSerializeTag entities, their rows are ignored when pages are compared
+        std::vector<uint32_t> m_EditorEntities;
+
+        std::vector<PoolSnapshot> m_Pools;
+        std::vector<ArchetypeSnapshot> m_Archetypes;
+    };
+}
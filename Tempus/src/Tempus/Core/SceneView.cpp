@@ -0,0 +1,98 @@
+// Copyright Levi Spevakow (C) 2025
+
+#include "SceneView.h"
+
+void Tempus::SceneViewCache::OnSignatureChanged(uint32_t entityId, const ComponentSignature& oldSignature, const ComponentSignature& newSignature)
+{
+    const bool bMatchedBefore = Matches(oldSignature);
+    const bool bMatchesNow = Matches(newSignature);
+
+    if (!bMatchedBefore && bMatchesNow)
+    {
+        AddEntity(entityId);
+    }
+    else if (bMatchedBefore && !bMatchesNow)
+    {
+        RemoveEntity(entityId);
+    }
+}
+
+void Tempus::SceneViewCache::AddEntity(uint32_t entityId)
+{
+    uint32_t& index = m_Sparse.Ensure(GetEntityIndex(entityId));
+    if (index != InvalidIndex)
+    {
+        return;
+    }
+
+    index = static_cast<uint32_t>(m_Entities.size());
+    m_Entities.push_back(entityId);
+    m_StructureVersion++;
+}
+
+void Tempus::SceneViewCache::AddEntities(std::span<const uint32_t> entityIds)
+{
+    m_Entities.reserve(m_Entities.size() + entityIds.size());
+    for (uint32_t entityId : entityIds)
+    {
+        uint32_t& index = m_Sparse.Ensure(GetEntityIndex(entityId));
+        if (index == InvalidIndex)
+        {
+            index = static_cast<uint32_t>(m_Entities.size());
+            m_Entities.push_back(entityId);
+        }
+    }
+    m_StructureVersion++;
+}
+
+void Tempus::SceneViewCache::RemoveEntity(uint32_t entityId)
+{
+    const uint32_t entityIndex = GetEntityIndex(entityId);
+    const uint32_t* sparse = m_Sparse.TryGet(entityIndex);
+    if (!sparse || *sparse == InvalidIndex)
+    {
+        return;
+    }
+
+    // Swap and pop to keep the entity list packed
+    const uint32_t index = *sparse;
+    const uint32_t lastEntity = m_Entities.back();
+    m_Entities[index] = lastEntity;
+    m_Sparse[GetEntityIndex(lastEntity)] = index;
+
+    m_Entities.pop_back();
+    m_Sparse[entityIndex] = InvalidIndex;
+    m_StructureVersion++;
+}
+
+void Tempus::SceneViewCache::Reorder(std::span<const uint32_t> orderedEntityIds)
+{
+    std::vector<uint32_t> reordered;
+    reordered.reserve(m_Entities.size());
+    for (uint32_t entityId : orderedEntityIds)
+    {
+        uint32_t* sparse = m_Sparse.TryGet(GetEntityIndex(entityId));
+        if (sparse && *sparse != InvalidIndex && *sparse < m_Entities.size() && m_Entities[*sparse] == entityId)
+        {
+            *sparse = static_cast<uint32_t>(reordered.size());
+            reordered.push_back(entityId);
+        }
+    }
+
+    // Unlisted entities still point at their old position, which holds a different entity in the new order
+    if (reordered.size() < m_Entities.size())
+    {
+        for (uint32_t entityId : m_Entities)
+        {
+            uint32_t& sparse = m_Sparse[GetEntityIndex(entityId)];
+            if (sparse >= reordered.size() || reordered[sparse] != entityId)
+            {
+                sparse = static_cast<uint32_t>(reordered.size());
+                reordered.push_back(entityId);
+            }
+        }
+    }
+
+    m_Entities = std::move(reordered);
+    m_StructureVersion++;
+}
@@ -0,0 +1,278 @@
+// Copyright Levi Spevakow (C) 2025
+
+#pragma once
+
+#include "Core.h"
+#include "ComponentPool.h"
+#include "ArchetypeStorage.h"
+#include "PagedArray.h"
+#include <bitset>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace Tempus
+{
+    using ComponentSignature = std::bitset<MAX_COMPONENTS>;
+
+    // Packed list of every entity whose component signature contains a given signature.
+    // Owned by the Scene and updated incrementally whenever an entity gains or loses a component,
+    // so iterating a view only ever touches matching entities.
+    class TEMPUS_API SceneViewCache
+    {
+    public:
+
+        SceneViewCache(const ComponentSignature& signature) : m_Signature(signature) {}
+
+        const ComponentSignature& GetSignature() const { return m_Signature; }
+        std::span<const uint32_t> GetEntityIds() const { return m_Entities; }
+        uint32_t GetSize() const { return static_cast<uint32_t>(m_Entities.size()); }
+        // Incremented whenever an entity enters or leaves the cache, so callers can tell when the entity order changed
+        uint32_t GetStructureVersion() const { return m_StructureVersion; }
+
+        bool Matches(const ComponentSignature& signature) const { return (signature & m_Signature) == m_Signature; }
+
+        // Adds or removes the entity depending on whether its signature started or stopped matching
+        void OnSignatureChanged(uint32_t entityId, const ComponentSignature& oldSignature, const ComponentSignature& newSignature);
+
+        void AddEntity(uint32_t entityId);
+        // Appends entities that aren't in the cache yet, counted as a single structural change
+        void AddEntities(std::span<const uint32_t> entityIds);
+        void RemoveEntity(uint32_t entityId);
+        // Rearranges the cached entities into the order they appear in the given list, cached entities missing from it
+        // keep their relative order after the listed ones. Entities that aren't cached are skipped.
+        // Counted as a single structural change.
+        void Reorder(std::span<const uint32_t> orderedEntityIds);
+
+        size_t GetMemoryUsage() const { return m_Sparse.GetMemoryUsage() + m_Entities.capacity() * sizeof(uint32_t); }
+
+        static constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+    private:
+
+        ComponentSignature m_Signature;
+        PagedArray<uint32_t> m_Sparse{ InvalidIndex };
+        std::vector<uint32_t> m_Entities;
+        uint32_t m_StructureVersion = 0;
+    };
+
+    // Lightweight handle for iterating the entities of a scene that have all of the given components.
+    // Obtained through Scene::View<Ts...>() and meant to be used immediately, adding or removing
+    // components while iterating is not allowed.
+    //
+    // for (auto [entityId, transform, mesh] : scene->View<TransformComponent, StaticMeshComponent>()) { ... }
+    //
+    // Changed<T>(version) restricts iteration to entities whose T was added or marked changed after the given
+    // Scene::AdvanceChangeVersion() result, so incremental systems only touch what changed since they last ran.
+    //
+    // Tag components filter the view through the entity signature and have no storage of their own,
+    // View<SomeTag>() doubles as the dense list of every entity carrying the tag.
+    template<ValidComponent... Ts>
+    class SceneView
+    {
+    public:
+
+        SceneView(const SceneViewCache* cache, ArchetypeStorage* archetypeStorage, ComponentPool<Ts>*... pools)
+            : m_Cache(cache), m_ArchetypeStorage(archetypeStorage), m_Pools(pools...)
+        {
+        }
+
+        class Iterator
+        {
+        public:
+
+            using iterator_category = std::forward_iterator_tag;
+            using difference_type = std::ptrdiff_t;
+            using value_type = std::tuple<uint32_t, Ts&...>;
+
+            Iterator(const SceneView* view, const uint32_t* current, const uint32_t* end) : m_View(view), m_Current(current), m_End(end)
+            {
+                SkipFiltered();
+            }
+
+            value_type operator*() const { return value_type(*m_Current, m_View->template Get<Ts>(*m_Current)...); }
+            Iterator& operator++() { ++m_Current; SkipFiltered(); return *this; }
+            Iterator operator++(int) { Iterator temp = *this; ++(*this); return temp; }
+            bool operator==(const Iterator& other) const { return m_Current == other.m_Current; }
+
+        private:
+
+            void SkipFiltered()
+            {
+                while (m_Current != m_End && !m_View->PassesFilter(*m_Current))
+                {
+                    ++m_Current;
+                }
+            }
+
+            const SceneView* m_View;
+            const uint32_t* m_Current;
+            const uint32_t* m_End;
+        };
+
+        Iterator begin() const { return Iterator(this, m_Cache->GetEntityIds().data(), m_Cache->GetEntityIds().data() + m_Cache->GetSize()); }
+        Iterator end() const { return Iterator(this, m_Cache->GetEntityIds().data() + m_Cache->GetSize(), m_Cache->GetEntityIds().data() + m_Cache->GetSize()); }
+
+        // Invokes func(entityId, Ts&...) for every matching entity, walking the pool's packed arrays when IsPacked()
+        template<typename Func>
+        void Each(Func&& func) const
+        {
+            if constexpr (bSinglePool)
+            {
+                if (IsPacked())
+                {
+                    EachPacked(std::forward<Func>(func));
+                    return;
+                }
+            }
+
+            for (uint32_t entityId : m_Cache->GetEntityIds())
+            {
+                if (PassesFilter(entityId))
+                {
+                    func(entityId, Get<Ts>(entityId)...);
+                }
+            }
+        }
+
+        // Copy of this view that only visits entities whose T was added or marked changed after the given version
+        template<ValidComponent T>
+        SceneView Changed(uint32_t sinceVersion) const
+        {
+            TPS_STATIC_ASSERT((std::is_same_v<T, Ts> || ...), "Changed<T> requires T to be one of the view's components");
+            TPS_STATIC_ASSERT(!TagComponent<T>, "Tags have no data and are never marked changed");
+            SceneView view = *this;
+            view.m_FilterVersionFunc = &SceneView::GetVersion<T>;
+            view.m_FilterSinceVersion = sinceVersion;
+            return view;
+        }
+
+        // The entity list and size ignore the Changed filter
+        std::span<const uint32_t> GetEntityIds() const { return m_Cache->GetEntityIds(); }
+        uint32_t GetSize() const { return m_Cache->GetSize(); }
+        bool IsEmpty() const { return m_Cache->GetSize() == 0; }
+        uint32_t GetStructureVersion() const { return m_Cache->GetStructureVersion(); }
+
+        // Whether the view covers a whole component pool, a single non-tag component outside archetype mode.
+        // Its entities and components are then the pool's packed arrays, see GetPackedEntityIds().
+        bool IsPacked() const
+        {
+            if constexpr (bSinglePool)
+            {
+                return !m_ArchetypeStorage;
+            }
+            return false;
+        }
+
+        // The pool's dense arrays when IsPacked(), index i of each belongs to the same entity.
+        // Walking them skips the per entity sparse lookup of Get(). The Changed filter is not applied.
+        std::span<const uint32_t> GetPackedEntityIds() const
+        {
+            if constexpr (bSinglePool)
+            {
+                if (IsPacked() && std::get<0>(m_Pools))
+                {
+                    return std::get<0>(m_Pools)->GetEntityIds();
+                }
+            }
+            return {};
+        }
+
+        template<ValidComponent T>
+        std::span<T> GetPackedComponents() const
+        {
+            TPS_STATIC_ASSERT(bSinglePool && (std::is_same_v<T, Ts> && ...), "Packed components are only available for a view of a single non-tag component");
+            if (IsPacked() && std::get<0>(m_Pools))
+            {
+                return std::get<0>(m_Pools)->GetComponents();
+            }
+            return {};
+        }
+
+        // Version the entity's T was added or last marked changed at
+        template<ValidComponent T>
+        uint32_t GetVersion(uint32_t entityId) const
+        {
+            if (m_ArchetypeStorage)
+            {
+                return m_ArchetypeStorage->GetVersion(entityId, T::GetId());
+            }
+            return std::get<ComponentPool<T>*>(m_Pools)->GetVersion(entityId);
+        }
+
+        // Marks the entity's T as changed, call after writing to it through the view
+        template<ValidComponent T>
+        void MarkChanged(uint32_t entityId) const
+        {
+            if constexpr (!TagComponent<T>)
+            {
+                if (m_ArchetypeStorage)
+                {
+                    m_ArchetypeStorage->MarkChanged(entityId, T::GetId());
+                    return;
+                }
+                std::get<ComponentPool<T>*>(m_Pools)->MarkChanged(entityId);
+            }
+        }
+
+        bool PassesFilter(uint32_t entityId) const
+        {
+            return !m_FilterVersionFunc || (this->*m_FilterVersionFunc)(entityId) > m_FilterSinceVersion;
+        }
+
+        // Only valid for entities contained in the view
+        template<ValidComponent T>
+        T& Get(uint32_t entityId) const
+        {
+            if constexpr (TagComponent<T>)
+            {
+                return GetTagInstance<T>();
+            }
+            else
+            {
+                if (m_ArchetypeStorage)
+                {
+                    return *m_ArchetypeStorage->GetComponent<T>(entityId);
+                }
+                return *std::get<ComponentPool<T>*>(m_Pools)->GetComponent(entityId);
+            }
+        }
+
+    private:
+
+        static constexpr bool bSinglePool = sizeof...(Ts) == 1 && (!TagComponent<Ts> && ...);
+
+        // Each() over the pool's dense arrays, the Changed filter reads the pool's versions at the same index
+        template<typename Func>
+        void EachPacked(Func&& func) const
+        {
+            auto* pool = std::get<0>(m_Pools);
+            if (!pool)
+            {
+                return;
+            }
+
+            const std::span<const uint32_t> entityIds = pool->GetEntityIds();
+            const auto components = pool->GetComponents();
+            const std::span<const uint32_t> versions = pool->GetVersions();
+            for (size_t i = 0; i < entityIds.size(); i++)
+            {
+                if (!m_FilterVersionFunc || versions[i] > m_FilterSinceVersion)
+                {
+                    func(entityIds[i], components[i]);
+                }
+            }
+        }
+
+        const SceneViewCache* m_Cache;
+        ArchetypeStorage* m_ArchetypeStorage;
+        std::tuple<ComponentPool<Ts>*...> m_Pools;
+
+        // Set by Changed<T>(), reads the filtered component's version
+        uint32_t (SceneView::*m_FilterVersionFunc)(uint32_t entityId) const = nullptr;
+        uint32_t m_FilterSinceVersion = 0;
+    };
+}
@@ -0,0 +1,250 @@
+// Copyright Levi Spevakow (C) 2025
+
+#pragma once
+
+#include "Core.h"
+#include "ComponentTypeOps.h"
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Tempus
+{
+    using SharedDataHandle = uint32_t;
+    constexpr SharedDataHandle INVALID_SHARED_DATA_HANDLE = std::numeric_limits<SharedDataHandle>::max();
+
+    template<typename T>
+    class SharedDataTableBase;
+
+    namespace SharedDataPrivate
+    {
+        template<typename T>
+        struct Block
+        {
+            std::optional<T> value;
+            std::atomic<uint32_t> refCount = 0;
+            SharedDataHandle handle = INVALID_SHARED_DATA_HANDLE;
+            SharedDataTableBase<T>* table = nullptr;
+        };
+    }
+
+    // Counted reference to an immutable block of a SharedDataTable. Copying a reference never copies the data,
+    // so every component holding the same reference shares one block. Two references are equal when they
+    // point at the same block, which the table guarantees for equal values.
+    // The block is freed when its last reference is destroyed, so references must not outlive their table.
+    template<typename T>
+    class SharedRef
+    {
+    public:
+
+        SharedRef() = default;
+        SharedRef(const SharedRef& other) : m_Block(other.m_Block) { AddRef(); }
+        SharedRef(SharedRef&& other) noexcept : m_Block(std::exchange(other.m_Block, nullptr)) {}
+        ~SharedRef() { RemoveRef(); }
+
+        SharedRef& operator=(const SharedRef& other)
+        {
+            if (m_Block != other.m_Block)
+            {
+                RemoveRef();
+                m_Block = other.m_Block;
+                AddRef();
+            }
+            return *this;
+        }
+
+        SharedRef& operator=(SharedRef&& other) noexcept
+        {
+            if (this != &other)
+            {
+                RemoveRef();
+                m_Block = std::exchange(other.m_Block, nullptr);
+            }
+            return *this;
+        }
+
+        const T& operator*() const { return *m_Block->value; }
+        const T* operator->() const { return &*m_Block->value; }
+        const T* Get() const { return m_Block ? &*m_Block->value : nullptr; }
+
+        // Dense, usable as an index into per block caches. Handles of freed blocks are reused, see
+        // SharedDataTable::GetReleaseCount().
+        SharedDataHandle GetHandle() const { return m_Block ? m_Block->handle : INVALID_SHARED_DATA_HANDLE; }
+        bool IsValid() const { return m_Block != nullptr; }
+
+        bool operator==(const SharedRef& other) const { return m_Block == other.m_Block; }
+
+    private:
+
+        template<typename, typename>
+        friend class SharedDataTable;
+
+        // Takes over a reference the table already counted
+        explicit SharedRef(SharedDataPrivate::Block<T>* block) : m_Block(block) {}
+
+        // Copies come from a live reference, so the count is never raised from zero outside the table's lock
+        void AddRef()
+        {
+            if (m_Block)
+            {
+                m_Block->refCount.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        void RemoveRef()
+        {
+            if (m_Block && m_Block->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                m_Block->table->Release(m_Block);
+            }
+            m_Block = nullptr;
+        }
+
+        SharedDataPrivate::Block<T>* m_Block = nullptr;
+    };
+
+    // Moving a reference's bytes moves its count along with it
+    template<typename T>
+    struct IsTriviallyRelocatable<SharedRef<T>> : std::true_type {};
+
+    template<typename T>
+    class SharedDataTableBase
+    {
+    protected:
+
+        template<typename>
+        friend class SharedRef;
+
+        ~SharedDataTableBase() = default;
+
+        // Called once a block's count dropped to zero, frees it unless it was acquired again in the meantime
+        virtual void Release(SharedDataPrivate::Block<T>* block) = 0;
+    };
+
+    // Flyweight storage, every distinct value is stored once and handed out as a SharedRef.
+    // Blocks are immutable and reading through a reference needs no lock. Writes go through Modify(), which
+    // acquires a block for the modified copy and leaves the original untouched for everyone else still referencing it.
+    // A block lives exactly as long as references to it do, wherever they are held: scenes, prefabs, undo snapshots
+    // and cells being streamed in all keep their blocks alive, and unloading the last of them frees the value.
+    // Acquire() and Modify() are thread safe so components can be constructed from worker threads.
+    template<typename T, typename Hash = std::hash<T>>
+    class SharedDataTable final : public SharedDataTableBase<T>
+    {
+    public:
+
+        SharedDataTable() = default;
+
+        // Returns the existing block if an equal value was acquired before and is still referenced
+        SharedRef<T> Acquire(const T& value)
+        {
+            std::lock_guard lock(m_Mutex);
+
+            auto it = m_Lookup.find(&value);
+            if (it != m_Lookup.end())
+            {
+                Block& block = m_Blocks[it->second];
+                block.refCount.fetch_add(1, std::memory_order_relaxed);
+                return SharedRef<T>(&block);
+            }
+
+            SharedDataHandle handle;
+            if (!m_FreeHandles.empty())
+            {
+                handle = m_FreeHandles.back();
+                m_FreeHandles.pop_back();
+            }
+            else
+            {
+                handle = static_cast<SharedDataHandle>(m_Blocks.size());
+                m_Blocks.emplace_back();
+            }
+
+            Block& block = m_Blocks[handle];
+            block.value.emplace(value);
+            block.refCount.store(1, std::memory_order_relaxed);
+            block.handle = handle;
+            block.table = this;
+            m_Lookup.emplace(&*block.value, handle);
+            return SharedRef<T>(&block);
+        }
+
+        // Copy on write, func(T&) edits a copy of the referenced value and the block for the result is returned
+        template<typename Func>
+        SharedRef<T> Modify(const SharedRef<T>& ref, Func&& func)
+        {
+            T value = ref.IsValid() ? *ref : T{};
+            func(value);
+            return Acquire(value);
+        }
+
+        // Invalid reference if the handle doesn't belong to a live block
+        SharedRef<T> Get(SharedDataHandle handle)
+        {
+            std::lock_guard lock(m_Mutex);
+            if (handle >= m_Blocks.size() || !m_Blocks[handle].value)
+            {
+                return SharedRef<T>();
+            }
+            m_Blocks[handle].refCount.fetch_add(1, std::memory_order_relaxed);
+            return SharedRef<T>(&m_Blocks[handle]);
+        }
+
+        // Live blocks
+        uint32_t GetCount() const
+        {
+            std::lock_guard lock(m_Mutex);
+            return static_cast<uint32_t>(m_Lookup.size());
+        }
+
+        // Bumped every time a block is freed. Its handle may then be reused for another value, so caches indexed by
+        // handle must be cleared when this changes.
+        uint32_t GetReleaseCount() const { return m_ReleaseCount.load(std::memory_order_acquire); }
+
+        SharedDataTable(const SharedDataTable&) = delete;
+        SharedDataTable& operator=(const SharedDataTable&) = delete;
+
+    private:
+
+        using Block = SharedDataPrivate::Block<T>;
+
+        void Release(Block* block) override
+        {
+            std::lock_guard lock(m_Mutex);
+
+            // Acquire() may have handed the block out again before the lock was taken, or an earlier release freed it
+            if (block->refCount.load(std::memory_order_relaxed) != 0 || !block->value)
+            {
+                return;
+            }
+
+            m_Lookup.erase(&*block->value);
+            block->value.reset();
+            m_FreeHandles.push_back(block->handle);
+            m_ReleaseCount.fetch_add(1, std::memory_order_release);
+        }
+
+        // The lookup keys point into m_Blocks, which never moves its elements as it grows
+        struct PointerHash
+        {
+            size_t operator()(const T* value) const { return Hash{}(*value); }
+        };
+
+        struct PointerEqual
+        {
+            bool operator()(const T* a, const T* b) const { return *a == *b; }
+        };
+
+        // Indexed by handle, freed blocks stay in place with no value until their handle is reused
+        std::deque<Block> m_Blocks;
+        std::vector<SharedDataHandle> m_FreeHandles;
+        std::unordered_map<const T*, SharedDataHandle, PointerHash, PointerEqual> m_Lookup;
+        std::atomic<uint32_t> m_ReleaseCount = 0;
+        mutable std::mutex m_Mutex;
+    };
+}
@@ -0,0 +1,113 @@
+// Copyright Levi Spevakow (C) 2025
+
+#include "TransformKernelBenchmark.h"
+
+#include "Components/TransformComponent.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <glm/glm.hpp>
+
+namespace
+{
+    double ElapsedMs(std::chrono::high_resolution_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+}
+
+std::vector<Tempus::TransformKernelBenchmark::Result> Tempus::TransformKernelBenchmark::Run(uint32_t transformCount, uint32_t passCount)
+{
+    passCount = std::max(passCount, 1u);
+
+    // Angles well past a full turn so the kernels' range reduction is covered
+    std::vector<TransformComponent> transforms(transformCount);
+    std::vector<float> soaData[9];
+    for (std::vector<float>& data : soaData)
+    {
+        data.resize(transformCount);
+    }
+    for (uint32_t i = 0; i < transformCount; i++)
+    {
+        const float f = static_cast<float>(i);
+        const glm::vec3 position(f, f * 0.5f, -f);
+        const glm::vec3 rotation(f * 0.1f, f * -0.2f, f * 0.3f);
+        const glm::vec3 scale(1.0f + (i % 7) * 0.5f, 1.0f, 0.25f + (i % 3));
+        transforms[i] = TransformComponent(position, rotation, scale);
+
+        for (uint32_t axis = 0; axis < 3; axis++)
+        {
+            soaData[axis][i] = position[axis];
+            soaData[3 + axis][i] = rotation[axis];
+            soaData[6 + axis][i] = scale[axis];
+        }
+    }
+
+    TransformSoA soa;
+    soa.positionX = soaData[0].data();
+    soa.positionY = soaData[1].data();
+    soa.positionZ = soaData[2].data();
+    soa.rotationX = soaData[3].data();
+    soa.rotationY = soaData[4].data();
+    soa.rotationZ = soaData[5].data();
+    soa.scaleX = soaData[6].data();
+    soa.scaleY = soaData[7].data();
+    soa.scaleZ = soaData[8].data();
+
+    std::vector<glm::mat4> expected(transformCount);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint32_t pass = 0; pass < passCount; pass++)
+    {
+        for (uint32_t i = 0; i < transformCount; i++)
+        {
+            expected[i] = transforms[i].GetLocalMatrix();
+        }
+    }
+    const double glmMs = ElapsedMs(start) / passCount;
+
+    std::vector<Result> results;
+    std::vector<glm::mat4> matrices(transformCount);
+    const SimdLevel supportedLevel = TransformKernels::GetSupportedLevel();
+    for (SimdLevel level : { SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2 })
+    {
+        if (level > supportedLevel)
+        {
+            break;
+        }
+
+        Result result;
+        result.level = level;
+        result.transformCount = transformCount;
+        result.glmMs = glmMs;
+
+        start = std::chrono::high_resolution_clock::now();
+        for (uint32_t pass = 0; pass < passCount; pass++)
+        {
+            TransformKernels::ComposeModelMatrices(soa, transformCount, matrices.data(), level);
+        }
+        result.kernelMs = ElapsedMs(start) / passCount;
+        result.nsPerMatrix = transformCount > 0 ? result.kernelMs * 1'000'000.0 / transformCount : 0.0;
+        result.speedup = result.kernelMs > 0.0 ? glmMs / result.kernelMs : 0.0;
+
+        for (uint32_t i = 0; i < transformCount; i++)
+        {
+            for (uint32_t column = 0; column < 4; column++)
+            {
+                for (uint32_t row = 0; row < 4; row++)
+                {
+                    const float expectedValue = expected[i][column][row];
+                    const float error = std::abs(matrices[i][column][row] - expectedValue) / std::max(1.0f, std::abs(expectedValue));
+                    result.maxError = std::max(result.maxError, error);
+                }
+            }
+        }
+        result.bWithinTolerance = result.maxError <= Tolerance;
+
+        TPS_CORE_INFO("Transform kernel benchmark | {0} | {1} transforms | glm: {2:.3f} ms | Kernel: {3:.3f} ms ({4:.2f} ns/matrix, {5:.2f}x) | Max error: {6:.2e} | {7}",
+            TransformKernels::GetLevelName(level), transformCount, result.glmMs, result.kernelMs, result.nsPerMatrix, result.speedup,
+            result.maxError, result.bWithinTolerance ? "Within tolerance" : "OUT OF TOLERANCE");
+        results.push_back(result);
+    }
+
+    return results;
+}
@@ -0,0 +1,37 @@
+// Copyright Levi Spevakow (C) 2025
+
+#pragma once
+
+#include "Core.h"
+#include "TransformKernels.h"
+#include <vector>
+
+namespace Tempus
+{
+    // Measures TransformKernels throughput at every SIMD level the CPU supports, against composing the same
+    // matrices one at a time through TransformComponent::GetLocalMatrix(), and validates each level's output against it.
+    class TEMPUS_API TransformKernelBenchmark
+    {
+    public:
+
+        // Largest difference allowed between a kernel's matrix element and glm's, relative to the element for elements above one
+        static constexpr float Tolerance = 1e-5f;
+
+        struct Result
+        {
+            SimdLevel level = SimdLevel::Scalar;
+            uint32_t transformCount = 0;
+            // Average time of one pass over every transform through GetLocalMatrix()
+            double glmMs = 0.0;
+            // Average time of one pass over every transform through the kernel
+            double kernelMs = 0.0;
+            double nsPerMatrix = 0.0;
+            double speedup = 0.0;
+            // Largest relative difference to the GetLocalMatrix() result
+            float maxError = 0.0f;
+            bool bWithinTolerance = false;
+        };
+
+        static std::vector<Result> Run(uint32_t transformCount = 1'000'000, uint32_t passCount = 10);
+    };
+}
@@ -0,0 +1,332 @@
+// Copyright Levi Spevakow (C) 2025
+
+#include "TransformKernels.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define TPS_TRANSFORM_KERNELS_X86 1
+    #include <immintrin.h>
+    #ifdef _MSC_VER
+        #include <intrin.h>
+        // MSVC allows AVX2 intrinsics in any function
+        #define TPS_TARGET_AVX2
+    #else
+        #define TPS_TARGET_AVX2 __attribute__((target("avx2,fma")))
+    #endif
+#else
+    #define TPS_TRANSFORM_KERNELS_X86 0
+#endif
+
+namespace
+{
+    // Same constant glm::radians() uses
+    constexpr float DegreesToRadians = 0.01745329251994329576923690768489f;
+
+    // Reference path for the SIMD kernels, also finishes whatever doesn't fill a whole SIMD batch
+    void ComposeScalar(const Tempus::TransformSoA& transforms, uint32_t begin, uint32_t end, glm::mat4* outMatrices)
+    {
+        for (uint32_t i = begin; i < end; i++)
+        {
+            const float rx = transforms.rotationX[i] * DegreesToRadians;
+            const float ry = transforms.rotationY[i] * DegreesToRadians;
+            const float rz = transforms.rotationZ[i] * DegreesToRadians;
+            const float sx = std::sin(rx), cx = std::cos(rx);
+            const float sy = std::sin(ry), cy = std::cos(ry);
+            const float sz = std::sin(rz), cz = std::cos(rz);
+            const float scaleX = transforms.scaleX[i];
+            const float scaleY = transforms.scaleY[i];
+            const float scaleZ = transforms.scaleZ[i];
+
+            // Translation * RotationX * RotationY * RotationZ * Scale, written out column by column
+            glm::mat4& m = outMatrices[i];
+            m[0] = glm::vec4(cy * cz * scaleX, (cx * sz + sx * sy * cz) * scaleX, (sx * sz - cx * sy * cz) * scaleX, 0.0f);
+            m[1] = glm::vec4(-cy * sz * scaleY, (cx * cz - sx * sy * sz) * scaleY, (sx * cz + cx * sy * sz) * scaleY, 0.0f);
+            m[2] = glm::vec4(sy * scaleZ, -sx * cy * scaleZ, cx * cy * scaleZ, 0.0f);
+            m[3] = glm::vec4(transforms.positionX[i], transforms.positionY[i], transforms.positionZ[i], 1.0f);
+        }
+    }
+
+#if TPS_TRANSFORM_KERNELS_X86
+
+    // Sine and cosine share one range reduction to [-pi/4, pi/4] by multiples of pi/2, split in three parts
+    // so large angles keep their precision, followed by minimax polynomials for each half of the result.
+    constexpr float TwoOverPi = 0.636619772367581343f;
+    constexpr float PiOverTwoA = 1.5703125f;
+    constexpr float PiOverTwoB = 4.837512969970703125e-4f;
+    constexpr float PiOverTwoC = 7.54978995489188216e-8f;
+    constexpr float SinCoefficient0 = -1.6666654611e-1f;
+    constexpr float SinCoefficient1 = 8.3321608736e-3f;
+    constexpr float SinCoefficient2 = -1.9515295891e-4f;
+    constexpr float CosCoefficient0 = 4.166664568298827e-2f;
+    constexpr float CosCoefficient1 = -1.388731625493765e-3f;
+    constexpr float CosCoefficient2 = 2.443315711809948e-5f;
+
+    void SinCos4(__m128 x, __m128& outSin, __m128& outCos)
+    {
+        const __m128i quadrant = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(TwoOverPi)));
+        const __m128 q = _mm_cvtepi32_ps(quadrant);
+        __m128 r = _mm_sub_ps(x, _mm_mul_ps(q, _mm_set1_ps(PiOverTwoA)));
+        r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(PiOverTwoB)));
+        r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(PiOverTwoC)));
+        const __m128 r2 = _mm_mul_ps(r, r);
+
+        __m128 sinPoly = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(SinCoefficient2), r2), _mm_set1_ps(SinCoefficient1));
+        sinPoly = _mm_add_ps(_mm_mul_ps(sinPoly, r2), _mm_set1_ps(SinCoefficient0));
+        const __m128 sinR = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(sinPoly, r2), r));
+
+        __m128 cosPoly = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(CosCoefficient2), r2), _mm_set1_ps(CosCoefficient1));
+        cosPoly = _mm_add_ps(_mm_mul_ps(cosPoly, r2), _mm_set1_ps(CosCoefficient0));
+        const __m128 cosR = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(r2, _mm_set1_ps(0.5f))), _mm_mul_ps(_mm_mul_ps(cosPoly, r2), r2));
+
+        // Odd quadrants swap sine and cosine, the sign of each follows the quadrant
+        const __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+        const __m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(2)), 30));
+        const __m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 30));
+        outSin = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, cosR), _mm_andnot_ps(swap, sinR)), sinSign);
+        outCos = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, sinR), _mm_andnot_ps(swap, cosR)), cosSign);
+    }
+
+    uint32_t ComposeSSE2(const Tempus::TransformSoA& transforms, uint32_t count, glm::mat4* outMatrices)
+    {
+        const __m128 toRadians = _mm_set1_ps(DegreesToRadians);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+
+        uint32_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 sx, cx, sy, cy, sz, cz;
+            SinCos4(_mm_mul_ps(_mm_loadu_ps(transforms.rotationX + i), toRadians), sx, cx);
+            SinCos4(_mm_mul_ps(_mm_loadu_ps(transforms.rotationY + i), toRadians), sy, cy);
+            SinCos4(_mm_mul_ps(_mm_loadu_ps(transforms.rotationZ + i), toRadians), sz, cz);
+            const __m128 scaleX = _mm_loadu_ps(transforms.scaleX + i);
+            const __m128 scaleY = _mm_loadu_ps(transforms.scaleY + i);
+            const __m128 scaleZ = _mm_loadu_ps(transforms.scaleZ + i);
+            const __m128 sxsy = _mm_mul_ps(sx, sy);
+            const __m128 cxsy = _mm_mul_ps(cx, sy);
+
+            // One register per matrix element, each lane belonging to a different matrix
+            __m128 columns[4][4] =
+            {
+                {
+                    _mm_mul_ps(_mm_mul_ps(cy, cz), scaleX),
+                    _mm_mul_ps(_mm_add_ps(_mm_mul_ps(cx, sz), _mm_mul_ps(sxsy, cz)), scaleX),
+                    _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(sx, sz), _mm_mul_ps(cxsy, cz)), scaleX),
+                    zero
+                },
+                {
+                    _mm_mul_ps(_mm_sub_ps(zero, _mm_mul_ps(cy, sz)), scaleY),
+                    _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(cx, cz), _mm_mul_ps(sxsy, sz)), scaleY),
+                    _mm_mul_ps(_mm_add_ps(_mm_mul_ps(sx, cz), _mm_mul_ps(cxsy, sz)), scaleY),
+                    zero
+                },
+                {
+                    _mm_mul_ps(sy, scaleZ),
+                    _mm_mul_ps(_mm_sub_ps(zero, _mm_mul_ps(sx, cy)), scaleZ),
+                    _mm_mul_ps(_mm_mul_ps(cx, cy), scaleZ),
+                    zero
+                },
+                {
+                    _mm_loadu_ps(transforms.positionX + i),
+                    _mm_loadu_ps(transforms.positionY + i),
+                    _mm_loadu_ps(transforms.positionZ + i),
+                    one
+                }
+            };
+
+            // Transposing a column's four elements gives that column for each of the four matrices
+            float* out = &outMatrices[i][0][0];
+            for (uint32_t column = 0; column < 4; column++)
+            {
+                __m128* elements = columns[column];
+                _MM_TRANSPOSE4_PS(elements[0], elements[1], elements[2], elements[3]);
+                for (uint32_t matrix = 0; matrix < 4; matrix++)
+                {
+                    _mm_storeu_ps(out + matrix * 16 + column * 4, elements[matrix]);
+                }
+            }
+        }
+        return i;
+    }
+
+    TPS_TARGET_AVX2 void SinCos8(__m256 x, __m256& outSin, __m256& outCos)
+    {
+        const __m256i quadrant = _mm256_cvtps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(TwoOverPi)));
+        const __m256 q = _mm256_cvtepi32_ps(quadrant);
+        __m256 r = _mm256_fnmadd_ps(q, _mm256_set1_ps(PiOverTwoA), x);
+        r = _mm256_fnmadd_ps(q, _mm256_set1_ps(PiOverTwoB), r);
+        r = _mm256_fnmadd_ps(q, _mm256_set1_ps(PiOverTwoC), r);
+        const __m256 r2 = _mm256_mul_ps(r, r);
+
+        __m256 sinPoly = _mm256_fmadd_ps(_mm256_set1_ps(SinCoefficient2), r2, _mm256_set1_ps(SinCoefficient1));
+        sinPoly = _mm256_fmadd_ps(sinPoly, r2, _mm256_set1_ps(SinCoefficient0));
+        const __m256 sinR = _mm256_fmadd_ps(_mm256_mul_ps(sinPoly, r2), r, r);
+
+        __m256 cosPoly = _mm256_fmadd_ps(_mm256_set1_ps(CosCoefficient2), r2, _mm256_set1_ps(CosCoefficient1));
+        cosPoly = _mm256_fmadd_ps(cosPoly, r2, _mm256_set1_ps(CosCoefficient0));
+        const __m256 cosR = _mm256_fmadd_ps(_mm256_mul_ps(cosPoly, r2), r2, _mm256_fnmadd_ps(r2, _mm256_set1_ps(0.5f), _mm256_set1_ps(1.0f)));
+
+        const __m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(quadrant, _mm256_set1_epi32(1)), _mm256_set1_epi32(1)));
+        const __m256 sinSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(quadrant, _mm256_set1_epi32(2)), 30));
+        const __m256 cosSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(quadrant, _mm256_set1_epi32(1)), _mm256_set1_epi32(2)), 30));
+        outSin = _mm256_xor_ps(_mm256_blendv_ps(sinR, cosR, swap), sinSign);
+        outCos = _mm256_xor_ps(_mm256_blendv_ps(cosR, sinR, swap), cosSign);
+    }
+
+    // Rows hold one element for each of eight matrices, afterwards each row holds eight elements of one matrix
+    TPS_TARGET_AVX2 void Transpose8x8(__m256 rows[8])
+    {
+        const __m256 t0 = _mm256_unpacklo_ps(rows[0], rows[1]);
+        const __m256 t1 = _mm256_unpackhi_ps(rows[0], rows[1]);
+        const __m256 t2 = _mm256_unpacklo_ps(rows[2], rows[3]);
+        const __m256 t3 = _mm256_unpackhi_ps(rows[2], rows[3]);
+        const __m256 t4 = _mm256_unpacklo_ps(rows[4], rows[5]);
+        const __m256 t5 = _mm256_unpackhi_ps(rows[4], rows[5]);
+        const __m256 t6 = _mm256_unpacklo_ps(rows[6], rows[7]);
+        const __m256 t7 = _mm256_unpackhi_ps(rows[6], rows[7]);
+
+        const __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+        const __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+        const __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+        const __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+        const __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+        const __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+        const __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+        const __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+        rows[0] = _mm256_permute2f128_ps(s0, s4, 0x20);
+        rows[1] = _mm256_permute2f128_ps(s1, s5, 0x20);
+        rows[2] = _mm256_permute2f128_ps(s2, s6, 0x20);
+        rows[3] = _mm256_permute2f128_ps(s3, s7, 0x20);
+        rows[4] = _mm256_permute2f128_ps(s0, s4, 0x31);
+        rows[5] = _mm256_permute2f128_ps(s1, s5, 0x31);
+        rows[6] = _mm256_permute2f128_ps(s2, s6, 0x31);
+        rows[7] = _mm256_permute2f128_ps(s3, s7, 0x31);
+    }
+
+    TPS_TARGET_AVX2 uint32_t ComposeAVX2(const Tempus::TransformSoA& transforms, uint32_t count, glm::mat4* outMatrices)
+    {
+        const __m256 toRadians = _mm256_set1_ps(DegreesToRadians);
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 one = _mm256_set1_ps(1.0f);
+
+        uint32_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 sx, cx, sy, cy, sz, cz;
+            SinCos8(_mm256_mul_ps(_mm256_loadu_ps(transforms.rotationX + i), toRadians), sx, cx);
+            SinCos8(_mm256_mul_ps(_mm256_loadu_ps(transforms.rotationY + i), toRadians), sy, cy);
+            SinCos8(_mm256_mul_ps(_mm256_loadu_ps(transforms.rotationZ + i), toRadians), sz, cz);
+            const __m256 scaleX = _mm256_loadu_ps(transforms.scaleX + i);
+            const __m256 scaleY = _mm256_loadu_ps(transforms.scaleY + i);
+            const __m256 scaleZ = _mm256_loadu_ps(transforms.scaleZ + i);
+            const __m256 sxsy = _mm256_mul_ps(sx, sy);
+            const __m256 cxsy = _mm256_mul_ps(cx, sy);
+
+            // Elements 0-7 then 8-15 of the eight matrices, each transposed into eight contiguous floats per matrix
+            __m256 firstHalf[8] =
+            {
+                _mm256_mul_ps(_mm256_mul_ps(cy, cz), scaleX),
+                _mm256_mul_ps(_mm256_fmadd_ps(sxsy, cz, _mm256_mul_ps(cx, sz)), scaleX),
+                _mm256_mul_ps(_mm256_fnmadd_ps(cxsy, cz, _mm256_mul_ps(sx, sz)), scaleX),
+                zero,
+                _mm256_mul_ps(_mm256_sub_ps(zero, _mm256_mul_ps(cy, sz)), scaleY),
+                _mm256_mul_ps(_mm256_fnmadd_ps(sxsy, sz, _mm256_mul_ps(cx, cz)), scaleY),
+                _mm256_mul_ps(_mm256_fmadd_ps(cxsy, sz, _mm256_mul_ps(sx, cz)), scaleY),
+                zero
+            };
+            __m256 secondHalf[8] =
+            {
+                _mm256_mul_ps(sy, scaleZ),
+                _mm256_mul_ps(_mm256_sub_ps(zero, _mm256_mul_ps(sx, cy)), scaleZ),
+                _mm256_mul_ps(_mm256_mul_ps(cx, cy), scaleZ),
+                zero,
+                _mm256_loadu_ps(transforms.positionX + i),
+                _mm256_loadu_ps(transforms.positionY + i),
+                _mm256_loadu_ps(transforms.positionZ + i),
+                one
+            };
+            Transpose8x8(firstHalf);
+            Transpose8x8(secondHalf);
+
+            float* out = &outMatrices[i][0][0];
+            for (uint32_t matrix = 0; matrix < 8; matrix++)
+            {
+                _mm256_storeu_ps(out + matrix * 16, firstHalf[matrix]);
+                _mm256_storeu_ps(out + matrix * 16 + 8, secondHalf[matrix]);
+            }
+        }
+        return i;
+    }
+
+    Tempus::SimdLevel DetectSimdLevel()
+    {
+        // SSE2 is part of the x86-64 baseline
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 1);
+        const bool bOsSavesAvx = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+        const bool bFma = (info[2] & (1 << 12)) != 0;
+        __cpuidex(info, 7, 0);
+        const bool bAvx2 = (info[1] & (1 << 5)) != 0;
+        return bOsSavesAvx && bFma && bAvx2 ? Tempus::SimdLevel::AVX2 : Tempus::SimdLevel::SSE2;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") ? Tempus::SimdLevel::AVX2 : Tempus::SimdLevel::SSE2;
+#endif
+    }
+
+#else
+
+    Tempus::SimdLevel DetectSimdLevel()
+    {
+        return Tempus::SimdLevel::Scalar;
+    }
+
+#endif
+}
+
+void Tempus::TransformKernels::ComposeModelMatrices(const TransformSoA& transforms, uint32_t count, glm::mat4* outMatrices)
+{
+    ComposeModelMatrices(transforms, count, outMatrices, GetSupportedLevel());
+}
+
+void Tempus::TransformKernels::ComposeModelMatrices(const TransformSoA& transforms, uint32_t count, glm::mat4* outMatrices, SimdLevel level)
+{
+    level = std::min(level, GetSupportedLevel());
+
+    // Whatever doesn't fill a whole batch is finished by the scalar path
+    uint32_t composed = 0;
+#if TPS_TRANSFORM_KERNELS_X86
+    if (level == SimdLevel::AVX2)
+    {
+        composed = ComposeAVX2(transforms, count, outMatrices);
+    }
+    else if (level == SimdLevel::SSE2)
+    {
+        composed = ComposeSSE2(transforms, count, outMatrices);
+    }
+#endif
+    ComposeScalar(transforms, composed, count, outMatrices);
+}
+
+Tempus::SimdLevel Tempus::TransformKernels::GetSupportedLevel()
+{
+    static const SimdLevel supportedLevel = DetectSimdLevel();
+    return supportedLevel;
+}
+
+const char* Tempus::TransformKernels::GetLevelName(SimdLevel level)
+{
+    switch (level)
+    {
+    case SimdLevel::SSE2:
+        return "SSE2";
+    case SimdLevel::AVX2:
+        return "AVX2";
+    default:
+        return "Scalar";
+    }
+}
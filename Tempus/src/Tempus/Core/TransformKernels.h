@@ -0,0 +1,48 @@
+// Copyright Levi Spevakow (C) 2025
+
+#pragma once
+
+#include "Core.h"
+#include <glm/mat4x4.hpp>
+
+namespace Tempus
+{
+    enum class SimdLevel : uint8_t
+    {
+        Scalar = 0,
+        SSE2,
+        AVX2
+    };
+
+    // Structure of arrays view over transforms, every array holds the same number of elements.
+    // Rotations are Euler angles in degrees, matching TransformComponent.
+    struct TransformSoA
+    {
+        const float* positionX = nullptr;
+        const float* positionY = nullptr;
+        const float* positionZ = nullptr;
+        const float* rotationX = nullptr;
+        const float* rotationY = nullptr;
+        const float* rotationZ = nullptr;
+        const float* scaleX = nullptr;
+        const float* scaleY = nullptr;
+        const float* scaleZ = nullptr;
+    };
+
+    // Batch model matrix composition, producing the same matrices as TransformComponent::GetLocalMatrix().
+    // The SIMD paths compose 4 (SSE2) or 8 (AVX2) matrices per iteration using polynomial sine and cosine,
+    // which agree with the glm path to within a few ulps. The widest level the CPU supports is picked at runtime,
+    // targets without x86 SIMD always use the scalar path.
+    class TEMPUS_API TransformKernels
+    {
+    public:
+
+        static void ComposeModelMatrices(const TransformSoA& transforms, uint32_t count, glm::mat4* outMatrices);
+        // Runs a specific level, for validation and benchmarking. Levels the CPU doesn't support fall back to the supported one.
+        static void ComposeModelMatrices(const TransformSoA& transforms, uint32_t count, glm::mat4* outMatrices, SimdLevel level);
+
+        // Detected once on first use
+        static SimdLevel GetSupportedLevel();
+        static const char* GetLevelName(SimdLevel level);
+    };
+}
@@ -0,0 +1,575 @@
+// Copyright Levi Spevakow (C) 2025
+
+#include "WorldPartition.h"
+
+#include "SceneSerializer.h"
+#include "Jobs/JobSystem.h"
+#include "Components/ComponentTypeTable.h"
+#include "Components/EditorTagComponents.h"
+#include "Components/TransformComponent.h"
+#include "Components/WorldCellComponent.h"
+#include "Systems/TransformSystem.h"
+#include "Utils/Profiling.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <system_error>
+
+namespace
+{
+    constexpr char IndexMagic[4] = { 'T', 'P', 'S', 'W' };
+    constexpr uint32_t IndexVersion = 1;
+
+    struct IndexHeader
+    {
+        char magic[4] = {};
+        uint32_t version = 0;
+        float cellSize = 0.0f;
+        uint32_t cellCount = 0;
+    };
+
+    struct IndexCell
+    {
+        int32_t x = 0;
+        int32_t y = 0;
+        uint32_t entityCount = 0;
+        uint32_t padding = 0;
+        uint64_t fileBytes = 0;
+    };
+
+    uint64_t GetCellKey(int32_t x, int32_t y)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+    }
+
+    std::string GetCellFileName(int32_t x, int32_t y)
+    {
+        return "Cell_" + std::to_string(x) + "_" + std::to_string(y) + Tempus::SceneSerializer::FileExtension;
+    }
+
+    double GetElapsedMs(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+bool Tempus::WorldPartition::BuildCells(Scene& world, const std::filesystem::path& directory, float cellSize, std::vector<uint32_t>& outPartitionedIds)
+{
+    TPS_SCOPED_TIMER();
+
+    outPartitionedIds.clear();
+    if (!(cellSize > 0.0f))
+    {
+        TPS_CORE_ERROR("Cannot partition scene [{0}], cell size {1} must be positive!", world.GetName(), cellSize);
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error)
+    {
+        TPS_CORE_ERROR("Failed to create world partition directory {0}: {1}", directory.string(), error.message());
+        return false;
+    }
+
+    // Entities go to the cell of their root, depth puts parents before their children within a cell
+    struct Placement
+    {
+        uint32_t id = INVALID_ENTITY_ID;
+        uint32_t depth = 0;
+    };
+    std::map<std::pair<int32_t, int32_t>, std::vector<Placement>> cells;
+    for (auto [id, transform] : world.View<TransformComponent>())
+    {
+        if (world.HasComponent<EditorNoSerializeTag>(id))
+        {
+            continue;
+        }
+
+        // Children of editor only entities stay with them, streamed without their parent they would move
+        uint32_t root = id;
+        uint32_t depth = 0;
+        bool bEditorOnlyAncestor = false;
+        for (uint32_t parent = world.GetParent(root); world.HasComponent<TransformComponent>(parent) && depth < world.GetEntityCount(); parent = world.GetParent(root))
+        {
+            bEditorOnlyAncestor = bEditorOnlyAncestor || world.HasComponent<EditorNoSerializeTag>(parent);
+            root = parent;
+            depth++;
+        }
+        if (bEditorOnlyAncestor)
+        {
+            continue;
+        }
+
+        const glm::vec3& position = world.GetComponent<TransformComponent>(root)->Position;
+        const int32_t x = static_cast<int32_t>(std::floor(position.x / cellSize));
+        const int32_t y = static_cast<int32_t>(std::floor(position.y / cellSize));
+        cells[{ x, y }].push_back({ id, depth });
+    }
+
+    std::vector<IndexCell> indexCells;
+    indexCells.reserve(cells.size());
+    std::vector<uint32_t> ids;
+    for (auto& [coordinates, placements] : cells)
+    {
+        const auto [x, y] = coordinates;
+        std::stable_sort(placements.begin(), placements.end(), [](const Placement& a, const Placement& b) { return a.depth < b.depth; });
+        ids.clear();
+        for (const Placement& placement : placements)
+        {
+            ids.push_back(placement.id);
+        }
+
+        Scene cellScene(world.GetName() + " Cell " + std::to_string(x) + " " + std::to_string(y), world.GetStorageMode());
+        std::unordered_map<uint32_t, uint32_t> idMap;
+        for (uint32_t id : cellScene.CopyEntities(world, ids, idMap))
+        {
+            cellScene.AddComponent<WorldCellComponent>(id, x, y);
+        }
+
+        const std::filesystem::path path = directory / GetCellFileName(x, y);
+        if (!SceneSerializer::Save(cellScene, path))
+        {
+            outPartitionedIds.clear();
+            return false;
+        }
+
+        IndexCell& indexCell = indexCells.emplace_back();
+        indexCell.x = x;
+        indexCell.y = y;
+        indexCell.entityCount = cellScene.GetEntityCount();
+        indexCell.fileBytes = std::filesystem::file_size(path, error);
+        outPartitionedIds.insert(outPartitionedIds.end(), ids.begin(), ids.end());
+    }
+
+    IndexHeader header;
+    std::memcpy(header.magic, IndexMagic, sizeof(IndexMagic));
+    header.version = IndexVersion;
+    header.cellSize = cellSize;
+    header.cellCount = static_cast<uint32_t>(indexCells.size());
+
+    const std::filesystem::path indexPath = directory / IndexFileName;
+    std::ofstream file(indexPath, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(indexCells.data()), static_cast<std::streamsize>(indexCells.size() * sizeof(IndexCell)));
+    if (!file)
+    {
+        TPS_CORE_ERROR("Failed to write world partition index {0}", indexPath.string());
+        outPartitionedIds.clear();
+        return false;
+    }
+
+    TPS_CORE_INFO("Scene [{0}] partitioned into {1}! Cells: [{2}] Cell Size: [{3}] Entities: [{4}]",
+        world.GetName(), directory.string(), indexCells.size(), cellSize, outPartitionedIds.size());
+    return true;
+}
+
+bool Tempus::WorldPartition::Open(const std::filesystem::path& directory)
+{
+    const std::filesystem::path indexPath = directory / IndexFileName;
+    std::ifstream file(indexPath, std::ios::binary);
+    IndexHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file)
+    {
+        TPS_CORE_ERROR("Failed to read world partition index {0}", indexPath.string());
+        return false;
+    }
+    if (std::memcmp(header.magic, IndexMagic, sizeof(IndexMagic)) != 0 || header.version != IndexVersion || !(header.cellSize > 0.0f))
+    {
+        TPS_CORE_ERROR("Failed to open world partition {0}, the index is invalid or of an unsupported version", indexPath.string());
+        return false;
+    }
+
+    std::vector<IndexCell> indexCells(header.cellCount);
+    file.read(reinterpret_cast<char*>(indexCells.data()), static_cast<std::streamsize>(indexCells.size() * sizeof(IndexCell)));
+    if (!file)
+    {
+        TPS_CORE_ERROR("Failed to read world partition index {0}, the file is truncated", indexPath.string());
+        return false;
+    }
+
+    m_Cells.clear();
+    m_CellIndices.clear();
+    m_Cells.reserve(indexCells.size());
+    for (const IndexCell& indexCell : indexCells)
+    {
+        Cell& cell = m_Cells.emplace_back();
+        cell.x = indexCell.x;
+        cell.y = indexCell.y;
+        cell.entityCount = indexCell.entityCount;
+        cell.fileBytes = indexCell.fileBytes;
+        m_CellIndices.emplace(GetCellKey(cell.x, cell.y), static_cast<uint32_t>(m_Cells.size() - 1));
+    }
+
+    m_Directory = directory;
+    m_CellSize = header.cellSize;
+    m_SceneSerial = 0;
+    m_RecentLoads.clear();
+    m_Stats = {};
+    m_Stats.cellCount = static_cast<uint32_t>(m_Cells.size());
+
+    TPS_CORE_INFO("World partition opened! Directory: [{0}] Cells: [{1}] Cell Size: [{2}]", directory.string(), m_Cells.size(), m_CellSize);
+    return true;
+}
+
+void Tempus::WorldPartition::Update(Scene& scene, const glm::vec3& focus, JobSystem* jobSystem)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    if (scene.GetSceneSerial() != m_SceneSerial)
+    {
+        Reconcile(scene);
+    }
+
+    // Hysteresis, cells in between the two radii keep whatever state they are in
+    const float unloadRadius = std::max(m_Settings.unloadRadius, m_Settings.loadRadius);
+    m_ScratchCells.clear();
+    for (uint32_t i = 0; i < m_Cells.size(); i++)
+    {
+        Cell& cell = m_Cells[i];
+        cell.distance = GetDistance(cell, focus);
+        switch (cell.state)
+        {
+        case CellState::Unloaded:
+            if (cell.distance <= m_Settings.loadRadius && !cell.bFailed)
+            {
+                m_ScratchCells.emplace_back(cell.distance, i);
+            }
+            break;
+        case CellState::Loading:
+            if (cell.distance > unloadRadius)
+            {
+                // The job finishes on its own and discards the scene
+                cell.load.reset();
+                cell.state = CellState::Unloaded;
+            }
+            break;
+        case CellState::Integrating:
+        case CellState::Resident:
+            if (cell.distance > unloadRadius)
+            {
+                BeginUnload(cell, jobSystem);
+            }
+            break;
+        case CellState::Unloading:
+            break;
+        }
+    }
+
+    uint32_t loadingCount = 0;
+    for (Cell& cell : m_Cells)
+    {
+        if (cell.state == CellState::Loading)
+        {
+            if (cell.load->IsFinished())
+            {
+                FinishLoad(cell);
+            }
+            else
+            {
+                loadingCount++;
+            }
+        }
+    }
+
+    // Nearest cells first
+    std::sort(m_ScratchCells.begin(), m_ScratchCells.end());
+    for (const auto& [distance, cellIndex] : m_ScratchCells)
+    {
+        if (loadingCount >= m_Settings.maxConcurrentLoads)
+        {
+            break;
+        }
+        StartLoad(m_Cells[cellIndex], jobSystem);
+        loadingCount++;
+    }
+
+    // Unloading goes first as it frees memory, then the nearest cells are copied in
+    m_ScratchCells.clear();
+    for (uint32_t i = 0; i < m_Cells.size(); i++)
+    {
+        const Cell& cell = m_Cells[i];
+        if (cell.state == CellState::Unloading)
+        {
+            m_ScratchCells.emplace_back(-1.0f, i);
+        }
+        else if (cell.state == CellState::Integrating)
+        {
+            m_ScratchCells.emplace_back(cell.distance, i);
+        }
+    }
+    std::sort(m_ScratchCells.begin(), m_ScratchCells.end());
+
+    bool bProcessedSlice = false;
+    for (const auto& [distance, cellIndex] : m_ScratchCells)
+    {
+        Cell& cell = m_Cells[cellIndex];
+        while (cell.state == CellState::Integrating || cell.state == CellState::Unloading)
+        {
+            if (bProcessedSlice && GetElapsedMs(start) >= m_Settings.frameBudgetMs)
+            {
+                UpdateStats(start);
+                return;
+            }
+
+            if (cell.state == CellState::Integrating)
+            {
+                CopySlice(scene, cell, jobSystem);
+            }
+            else
+            {
+                UnloadSlice(scene, cell);
+            }
+            bProcessedSlice = true;
+        }
+    }
+
+    UpdateStats(start);
+}
+
+void Tempus::WorldPartition::UnloadAll(Scene& scene)
+{
+    if (scene.GetSceneSerial() != m_SceneSerial)
+    {
+        Reconcile(scene);
+    }
+
+    m_ScratchIds.clear();
+    for (Cell& cell : m_Cells)
+    {
+        for (uint32_t i = cell.removedCount; i < cell.entityIds.size(); i++)
+        {
+            if (scene.HasEntity(cell.entityIds[i]))
+            {
+                m_ScratchIds.push_back(cell.entityIds[i]);
+            }
+        }
+        if (cell.state == CellState::Resident || cell.state == CellState::Integrating || cell.state == CellState::Unloading)
+        {
+            m_Stats.cellsUnloaded++;
+        }
+
+        cell.load.reset();
+        ReleaseCellScene(cell, nullptr);
+        cell.entityIds = {};
+        cell.removedCount = 0;
+        cell.state = CellState::Unloaded;
+    }
+    scene.DespawnBatch(m_ScratchIds);
+
+    TPS_CORE_INFO("World partition unloaded from scene [{0}]! Entities: [{1}]", scene.GetName(), m_ScratchIds.size());
+    m_ScratchIds.clear();
+    m_Stats.residentCells = 0;
+    m_Stats.loadingCells = 0;
+    m_Stats.unloadingCells = 0;
+    m_Stats.residentEntities = 0;
+}
+
+void Tempus::WorldPartition::Reconcile(Scene& scene)
+{
+    for (Cell& cell : m_Cells)
+    {
+        cell.entityIds.clear();
+        cell.removedCount = 0;
+    }
+
+    // A cell the scene holds in full is resident, one it holds part of is removed and loaded again
+    uint32_t adoptedCount = 0;
+    for (auto [id, worldCell] : scene.View<WorldCellComponent>())
+    {
+        auto it = m_CellIndices.find(GetCellKey(worldCell.X, worldCell.Y));
+        if (it != m_CellIndices.end())
+        {
+            m_Cells[it->second].entityIds.push_back(id);
+            adoptedCount++;
+        }
+    }
+
+    for (Cell& cell : m_Cells)
+    {
+        ReleaseCellScene(cell, nullptr);
+        if (cell.entityIds.empty())
+        {
+            // Loads in flight are still of use to the new scene
+            if (cell.state != CellState::Loading)
+            {
+                cell.state = CellState::Unloaded;
+            }
+            continue;
+        }
+
+        cell.load.reset();
+        cell.state = cell.entityIds.size() == cell.entityCount ? CellState::Resident : CellState::Unloading;
+    }
+
+    if (m_SceneSerial != 0)
+    {
+        TPS_CORE_INFO("World partition switched to scene [{0}]! Streamed entities taken over: [{1}]", scene.GetName(), adoptedCount);
+    }
+    m_SceneSerial = scene.GetSceneSerial();
+}
+
+void Tempus::WorldPartition::StartLoad(Cell& cell, JobSystem* jobSystem)
+{
+    // Tagged on the worker, the copy into the scene then carries the tag over as part of the signature
+    AsyncSceneLoad::PrepareFunc prepare = [cellPrepare = m_CellPrepare](Scene& cellScene)
+    {
+        for (uint32_t id : cellScene.GetEntityIDs())
+        {
+            cellScene.AddComponent<EditorNoSerializeTag>(id);
+        }
+        if (cellPrepare)
+        {
+            cellPrepare(cellScene);
+        }
+    };
+
+    cell.load = AsyncSceneLoad::Start(m_Directory / GetCellFileName(cell.x, cell.y), jobSystem, std::move(prepare));
+    cell.state = CellState::Loading;
+}
+
+void Tempus::WorldPartition::FinishLoad(Cell& cell)
+{
+    const std::shared_ptr<AsyncSceneLoad> load = std::move(cell.load);
+    cell.cellScene = load->TakeScene();
+    if (!cell.cellScene)
+    {
+        TPS_CORE_ERROR("Failed to load world cell [{0}, {1}] from {2}!", cell.x, cell.y, load->GetPath().string());
+        cell.bFailed = true;
+        cell.state = CellState::Unloaded;
+        return;
+    }
+
+    // The loading job ran the cell's transform system, which orders its entities parents first
+    const std::span<const uint32_t> sortedIds = cell.cellScene->GetTransformSystem()->GetSortedEntities();
+    cell.sourceIds.assign(sortedIds.begin(), sortedIds.end());
+    cell.entityCount = static_cast<uint32_t>(cell.sourceIds.size());
+    cell.copiedCount = 0;
+    cell.entityIds.clear();
+    cell.entityIds.reserve(cell.entityCount);
+    cell.state = CellState::Integrating;
+
+    m_Stats.bytesLoaded += cell.fileBytes;
+    m_Stats.lastCellLoadMs = load->GetLoadMs();
+    m_RecentLoads.emplace_back(std::chrono::steady_clock::now(), cell.fileBytes);
+}
+
+void Tempus::WorldPartition::BeginUnload(Cell& cell, JobSystem* jobSystem)
+{
+    ReleaseCellScene(cell, jobSystem);
+    cell.removedCount = 0;
+    cell.state = cell.entityIds.empty() ? CellState::Unloaded : CellState::Unloading;
+}
+
+void Tempus::WorldPartition::CopySlice(Scene& scene, Cell& cell, JobSystem* jobSystem)
+{
+    const uint32_t count = std::min<uint32_t>(std::max(m_Settings.sliceSize, 1u), static_cast<uint32_t>(cell.sourceIds.size()) - cell.copiedCount);
+    const std::vector<uint32_t> ids = scene.CopyEntities(*cell.cellScene, std::span<const uint32_t>(cell.sourceIds).subspan(cell.copiedCount, count), cell.idMap);
+    cell.entityIds.insert(cell.entityIds.end(), ids.begin(), ids.end());
+    cell.copiedCount += count;
+
+    if (cell.copiedCount == cell.sourceIds.size())
+    {
+        ReleaseCellScene(cell, jobSystem);
+        cell.state = CellState::Resident;
+        m_Stats.cellsLoaded++;
+    }
+}
+
+void Tempus::WorldPartition::UnloadSlice(Scene& scene, Cell& cell)
+{
+    const uint32_t count = std::min<uint32_t>(std::max(m_Settings.sliceSize, 1u), static_cast<uint32_t>(cell.entityIds.size()) - cell.removedCount);
+
+    // Entities deleted in the editor since they were streamed in are skipped quietly
+    m_ScratchIds.clear();
+    for (uint32_t id : std::span<const uint32_t>(cell.entityIds).subspan(cell.removedCount, count))
+    {
+        if (scene.HasEntity(id))
+        {
+            m_ScratchIds.push_back(id);
+        }
+    }
+    scene.DespawnBatch(m_ScratchIds);
+    cell.removedCount += count;
+
+    if (cell.removedCount == cell.entityIds.size())
+    {
+        cell.entityIds = {};
+        cell.removedCount = 0;
+        cell.state = CellState::Unloaded;
+        m_Stats.cellsUnloaded++;
+    }
+}
+
+void Tempus::WorldPartition::ReleaseCellScene(Cell& cell, JobSystem* jobSystem)
+{
+    cell.sourceIds = {};
+    cell.idMap = {};
+    cell.copiedCount = 0;
+    if (!cell.cellScene)
+    {
+        return;
+    }
+
+    if (jobSystem)
+    {
+        jobSystem->RunBackground([cellScene = std::shared_ptr<Scene>(std::move(cell.cellScene))]() {});
+    }
+    cell.cellScene.reset();
+}
+
+float Tempus::WorldPartition::GetDistance(const Cell& cell, const glm::vec3& focus) const
+{
+    // Distance to the nearest point of the cell on the XY plane, 0 inside it
+    const float minX = static_cast<float>(cell.x) * m_CellSize;
+    const float minY = static_cast<float>(cell.y) * m_CellSize;
+    const float dx = std::max({ minX - focus.x, 0.0f, focus.x - (minX + m_CellSize) });
+    const float dy = std::max({ minY - focus.y, 0.0f, focus.y - (minY + m_CellSize) });
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+void Tempus::WorldPartition::UpdateStats(std::chrono::steady_clock::time_point start)
+{
+    m_Stats.residentCells = 0;
+    m_Stats.loadingCells = 0;
+    m_Stats.unloadingCells = 0;
+    m_Stats.residentEntities = 0;
+    for (const Cell& cell : m_Cells)
+    {
+        switch (cell.state)
+        {
+        case CellState::Loading:
+        case CellState::Integrating:
+            m_Stats.loadingCells++;
+            break;
+        case CellState::Resident:
+            m_Stats.residentCells++;
+            break;
+        case CellState::Unloading:
+            m_Stats.unloadingCells++;
+            break;
+        case CellState::Unloaded:
+            break;
+        }
+        m_Stats.residentEntities += static_cast<uint32_t>(cell.entityIds.size()) - cell.removedCount;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    while (!m_RecentLoads.empty() && now - m_RecentLoads.front().first > std::chrono::seconds(1))
+    {
+        m_RecentLoads.pop_front();
+    }
+    uint64_t recentBytes = 0;
+    for (const auto& [time, bytes] : m_RecentLoads)
+    {
+        recentBytes += bytes;
+    }
+    m_Stats.bandwidthBytesPerSecond = static_cast<double>(recentBytes);
+
+    m_Stats.lastUpdateMs = GetElapsedMs(start);
+    m_Stats.maxUpdateMs = std::max(m_Stats.maxUpdateMs, m_Stats.lastUpdateMs);
+}
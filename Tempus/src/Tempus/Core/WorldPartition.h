@@ -0,0 +1,164 @@
+// Copyright Levi Spevakow (C) 2025
+
+#pragma once
+
+#include "Core.h"
+#include "AsyncSceneLoad.h"
+#include "Scene.h"
+#include <glm/vec3.hpp>
+#include <chrono>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Tempus
+{
+    class JobSystem;
+
+    struct WorldPartitionSettings
+    {
+        // Cells are loaded once the focus comes within loadRadius of them and only unloaded again once it is further
+        // than unloadRadius away, so moving back and forth along a cell's edge doesn't reload it every time
+        float loadRadius = 3000.0f;
+        float unloadRadius = 4000.0f;
+        // Main thread time per update spent copying loaded cells into the scene and removing unloaded ones.
+        // At least one slice is processed per update so streaming always makes progress.
+        double frameBudgetMs = 2.0;
+        // Entities copied into or removed from the scene between budget checks
+        uint32_t sliceSize = 2048;
+        // Cell files read by background jobs at the same time
+        uint32_t maxConcurrentLoads = 4;
+    };
+
+    // Streams a world that is too large for one resident scene in and out of a scene by distance from a focus point,
+    // usually the active camera. The world is split into square cells on the XY plane by BuildCells(), each written as
+    // its own scene file. Cells in range are read by background jobs, which also resolve their transforms, and then
+    // copied into the scene a slice at a time within a per update budget. Cells out of range are removed the same way.
+    // Streamed entities carry a WorldCellComponent naming their cell and an EditorNoSerializeTag so they are never
+    // saved with the scene. When the scene is replaced by a copy of itself, e.g. for a play session or by an undo step,
+    // every cell takes over whatever of it the new scene holds.
+    class TEMPUS_API WorldPartition
+    {
+    public:
+
+        static constexpr const char* IndexFileName = "Cells.tpartition";
+
+        struct Stats
+        {
+            uint32_t cellCount = 0;
+            // Cells fully copied into the scene
+            uint32_t residentCells = 0;
+            // Cells being read or copied into the scene
+            uint32_t loadingCells = 0;
+            uint32_t unloadingCells = 0;
+            uint32_t residentEntities = 0;
+            uint32_t cellsLoaded = 0;
+            uint32_t cellsUnloaded = 0;
+            // Size of every cell file read so far
+            uint64_t bytesLoaded = 0;
+            // Cell file bytes read over the last second
+            double bandwidthBytesPerSecond = 0.0;
+            // Background time spent reading and preparing the last cell
+            double lastCellLoadMs = 0.0;
+            // Main thread time of the last Update() and the longest one since Open()
+            double lastUpdateMs = 0.0;
+            double maxUpdateMs = 0.0;
+        };
+
+        // Writes every entity of the world with a TransformComponent into the cell containing its root parent's XY
+        // position, so a hierarchy is always streamed as a whole. Cells are written as scene files into the directory
+        // along with an index for Open(). Editor only entities and their children are left out. Entities aren't removed
+        // from the world, outPartitionedIds receives the ones that were written. Returns false if a file couldn't be written.
+        static bool BuildCells(Scene& world, const std::filesystem::path& directory, float cellSize, std::vector<uint32_t>& outPartitionedIds);
+
+        explicit WorldPartition(const WorldPartitionSettings& settings = {}) : m_Settings(settings) {}
+        WorldPartition(const WorldPartition&) = delete;
+        WorldPartition& operator=(const WorldPartition&) = delete;
+
+        // Reads the index of a directory written by BuildCells(), every cell starts unloaded
+        bool Open(const std::filesystem::path& directory);
+
+        // Runs on the loading job of every cell after it is read, e.g. to read resources its entities use
+        void SetCellPrepareFunc(AsyncSceneLoad::PrepareFunc prepare) { m_CellPrepare = std::move(prepare); }
+
+        // Starts loading cells that came into range, copies finished ones into the scene and removes cells that went
+        // out of range, nearest cells first. Call once per frame before the scene updates. Cells are loaded on the
+        // calling thread if jobSystem is nullptr.
+        void Update(Scene& scene, const glm::vec3& focus, JobSystem* jobSystem);
+        // Removes every streamed entity from the scene right away and drops pending loads
+        void UnloadAll(Scene& scene);
+
+        // Whether any cell is being loaded, copied or removed
+        bool IsStreaming() const { return m_Stats.loadingCells != 0 || m_Stats.unloadingCells != 0; }
+
+        const Stats& GetStats() const { return m_Stats; }
+        const WorldPartitionSettings& GetSettings() const { return m_Settings; }
+        const std::filesystem::path& GetDirectory() const { return m_Directory; }
+        float GetCellSize() const { return m_CellSize; }
+
+    private:
+
+        enum class CellState : uint8_t
+        {
+            Unloaded,
+            Loading,
+            Integrating,
+            Resident,
+            Unloading
+        };
+
+        struct Cell
+        {
+            int32_t x = 0;
+            int32_t y = 0;
+            uint32_t entityCount = 0;
+            uint64_t fileBytes = 0;
+            CellState state = CellState::Unloaded;
+            // Set once the file failed to load, so it isn't read again every update
+            bool bFailed = false;
+            float distance = 0.0f;
+
+            std::shared_ptr<AsyncSceneLoad> load;
+            // Loaded cell being copied into the scene, with its entities parents first
+            std::unique_ptr<Scene> cellScene;
+            std::vector<uint32_t> sourceIds;
+            std::unordered_map<uint32_t, uint32_t> idMap;
+            uint32_t copiedCount = 0;
+
+            // The cell's entities in the scene, removed from the front while unloading
+            std::vector<uint32_t> entityIds;
+            uint32_t removedCount = 0;
+        };
+
+        // Rebuilds every cell's entities from the WorldCellComponents of a scene the partition hasn't seen before
+        void Reconcile(Scene& scene);
+        void StartLoad(Cell& cell, JobSystem* jobSystem);
+        void FinishLoad(Cell& cell);
+        void BeginUnload(Cell& cell, JobSystem* jobSystem);
+        void CopySlice(Scene& scene, Cell& cell, JobSystem* jobSystem);
+        void UnloadSlice(Scene& scene, Cell& cell);
+        // Frees a cell's loaded scene on a background job, freeing it takes about as long as copying it
+        static void ReleaseCellScene(Cell& cell, JobSystem* jobSystem);
+        float GetDistance(const Cell& cell, const glm::vec3& focus) const;
+        void UpdateStats(std::chrono::steady_clock::time_point start);
+
+        WorldPartitionSettings m_Settings;
+        std::filesystem::path m_Directory;
+        float m_CellSize = 0.0f;
+        std::vector<Cell> m_Cells;
+        // Cell coordinates packed by GetCellKey() to an index into m_Cells
+        std::unordered_map<uint64_t, uint32_t> m_CellIndices;
+        AsyncSceneLoad::PrepareFunc m_CellPrepare;
+        // Scene the cells' entity IDs belong to
+        uint64_t m_SceneSerial = 0;
+
+        // Bytes of the cells loaded over the last second
+        std::deque<std::pair<std::chrono::steady_clock::time_point, uint64_t>> m_RecentLoads;
+        std::vector<std::pair<float, uint32_t>> m_ScratchCells;
+        std::vector<uint32_t> m_ScratchIds;
+        Stats m_Stats;
+    };
+}
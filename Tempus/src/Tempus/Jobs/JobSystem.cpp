@@ -0,0 +1,328 @@
+// Copyright Levi Spevakow (C) 2025
+
+#include "JobSystem.h"
+
+namespace
+{
+    // Set on pool threads so job scheduling knows which deque belongs to the caller
+    thread_local const Tempus::JobSystem* t_JobSystem = nullptr;
+    thread_local uint32_t t_WorkerIndex = Tempus::JobSystem::InvalidWorker;
+
+    // Failed lookups before an idle worker goes to sleep
+    constexpr uint32_t IdleSpinCount = 64;
+}
+
+Tempus::JobSystem::~JobSystem()
+{
+    Shutdown();
+}
+
+void Tempus::JobSystem::Init(uint32_t workerCount)
+{
+    if (IsInitialized())
+    {
+        TPS_CORE_WARN("Job system is already initialized!");
+        return;
+    }
+
+    if (workerCount == 0)
+    {
+        workerCount = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    m_bShutdown = false;
+    m_OwnerThreadId = std::this_thread::get_id();
+
+    for (uint32_t i = 0; i < workerCount; i++)
+    {
+        m_Workers.push_back(std::make_unique<Worker>());
+        m_Workers.back()->randomState = i * 2654435761u + 1;
+    }
+
+    // Worker 0 is the calling thread
+    for (uint32_t i = 1; i < workerCount; i++)
+    {
+        m_Workers[i]->thread = std::thread(&JobSystem::WorkerLoop, this, i);
+    }
+
+    TPS_CORE_INFO("Job system initialized with {0} workers", workerCount);
+}
+
+void Tempus::JobSystem::Shutdown()
+{
+    if (!IsInitialized())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard lock(m_WakeMutex);
+        m_bShutdown = true;
+    }
+    m_WakeCondition.notify_all();
+
+    for (auto& worker : m_Workers)
+    {
+        if (worker->thread.joinable())
+        {
+            worker->thread.join();
+        }
+    }
+
+    m_Workers.clear();
+    m_PendingJobs = 0;
+
+    // Background jobs nobody got to are dropped, their counters are released so no one waits on them forever
+    std::deque<BackgroundJob> droppedJobs;
+    {
+        std::lock_guard lock(m_BackgroundMutex);
+        droppedJobs.swap(m_BackgroundJobs);
+    }
+    for (BackgroundJob& job : droppedJobs)
+    {
+        if (job.counter)
+        {
+            FinishCounter(*job.counter);
+        }
+    }
+}
+
+void Tempus::JobSystem::Wait(JobCounter& counter)
+{
+    const uint32_t workerIndex = GetCurrentWorkerIndex();
+
+    while (!counter.IsDone())
+    {
+        if (workerIndex != InvalidWorker)
+        {
+            if (Job* job = FindJob(workerIndex))
+            {
+                Execute(job, workerIndex);
+                continue;
+            }
+        }
+        std::this_thread::yield();
+    }
+
+    // Wait for the thread that brought the counter to zero to release the lock before the caller can destroy it
+    std::lock_guard lock(counter.m_ContinuationMutex);
+}
+
+std::vector<uint64_t> Tempus::JobSystem::GetExecutedJobCounts() const
+{
+    std::vector<uint64_t> counts;
+    counts.reserve(m_Workers.size());
+    for (const auto& worker : m_Workers)
+    {
+        counts.push_back(worker->executedJobs.load(std::memory_order_relaxed));
+    }
+    return counts;
+}
+
+Tempus::Job* Tempus::JobSystem::AllocateJob()
+{
+    const uint32_t workerIndex = GetCurrentWorkerIndex();
+    if (workerIndex == InvalidWorker)
+    {
+        return nullptr;
+    }
+
+    Worker& worker = *m_Workers[workerIndex];
+    Job* job = &worker.jobPool[worker.nextJob & (MaxJobsPerWorker - 1)];
+
+    // The ring wrapped onto a job that hasn't finished yet, the caller runs the work inline instead
+    if (job->bInUse.load(std::memory_order_acquire))
+    {
+        return nullptr;
+    }
+
+    worker.nextJob++;
+    job->bInUse.store(true, std::memory_order_relaxed);
+    return job;
+}
+
+void Tempus::JobSystem::Submit(Job* job)
+{
+    const uint32_t workerIndex = GetCurrentWorkerIndex();
+
+    // Threads outside the pool have no deque to push to
+    if (workerIndex == InvalidWorker)
+    {
+        Execute(job, 0);
+        return;
+    }
+
+    // Counted before the push so a stealer can never decrement it below zero
+    m_PendingJobs.fetch_add(1, std::memory_order_seq_cst);
+    if (!m_Workers[workerIndex]->queue.Push(job))
+    {
+        // A full deque means there is plenty of queued work already
+
+        m_PendingJobs.fetch_sub(1, std::memory_order_relaxed);
+        Execute(job, workerIndex);
+        return;
+    }
+
+    WakeWorker();
+}
+
+void Tempus::JobSystem::WakeWorker()
+{
+    if (m_SleepingWorkers.load(std::memory_order_seq_cst) > 0)
+    {
+        // Taking the lock guarantees a worker between its predicate check and its wait can't miss the notify
+        std::lock_guard lock(m_WakeMutex);
+        m_WakeCondition.notify_one();
+    }
+}
+
+bool Tempus::JobSystem::RunBackgroundJob(uint32_t workerIndex)
+{
+    BackgroundJob job;
+    {
+        std::lock_guard lock(m_BackgroundMutex);
+        if (m_BackgroundJobs.empty())
+        {
+            return false;
+        }
+        job = std::move(m_BackgroundJobs.front());
+        m_BackgroundJobs.pop_front();
+    }
+    m_PendingJobs.fetch_sub(1, std::memory_order_relaxed);
+
+    job.func();
+    m_Workers[workerIndex]->executedJobs.fetch_add(1, std::memory_order_relaxed);
+
+    if (job.counter)
+    {
+        FinishCounter(*job.counter);
+    }
+    return true;
+}
+
+void Tempus::JobSystem::Execute(Job* job, uint32_t workerIndex)
+{
+    JobCounter* counter = job->counter;
+    job->invoke(job->storage);
+    job->bInUse.store(false, std::memory_order_release);
+
+    m_Workers[workerIndex]->executedJobs.fetch_add(1, std::memory_order_relaxed);
+
+    if (counter)
+    {
+        FinishCounter(*counter);
+    }
+}
+
+void Tempus::JobSystem::FinishCounter(JobCounter& counter)
+{
+    uint32_t value = counter.m_Value.load(std::memory_order_relaxed);
+    while (value > 1)
+    {
+        if (counter.m_Value.compare_exchange_weak(value, value - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+        {
+            return;
+        }
+    }
+
+    // Possibly the last job. Reaching zero happens under the lock so Wait() can't return and destroy
+    // the counter while its continuations are still being released.
+    std::vector<Job*> continuations;
+    {
+        std::lock_guard lock(counter.m_ContinuationMutex);
+        if (counter.m_Value.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            continuations.swap(counter.m_Continuations);
+        }
+    }
+    for (Job* job : continuations)
+    {
+        Submit(job);
+    }
+}
+
+Tempus::Job* Tempus::JobSystem::FindJob(uint32_t workerIndex)
+{
+    Worker& worker = *m_Workers[workerIndex];
+
+    Job* job = worker.queue.Pop();
+    if (!job)
+    {
+        // Steal starting from a random victim so idle workers don't all hammer the same deque
+        const uint32_t workerCount = GetWorkerCount();
+        worker.randomState ^= worker.randomState << 13;
+        worker.randomState ^= worker.randomState >> 17;
+        worker.randomState ^= worker.randomState << 5;
+        const uint32_t start = worker.randomState % workerCount;
+
+        for (uint32_t i = 0; i < workerCount && !job; i++)
+        {
+            const uint32_t victim = (start + i) % workerCount;
+            if (victim != workerIndex)
+            {
+                job = m_Workers[victim]->queue.Steal();
+            }
+        }
+    }
+
+    if (job)
+    {
+        m_PendingJobs.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+uint32_t Tempus::JobSystem::GetCurrentWorkerIndex() const
+{
+    if (t_JobSystem == this)
+    {
+        return t_WorkerIndex;
+    }
+    if (IsInitialized() && std::this_thread::get_id() == m_OwnerThreadId)
+    {
+        return 0;
+    }
+    return InvalidWorker;
+}
+
+void Tempus::JobSystem::WorkerLoop(uint32_t workerIndex)
+{
+    t_JobSystem = this;
+    t_WorkerIndex = workerIndex;
+
+    uint32_t idleSpins = 0;
+    while (!m_bShutdown.load(std::memory_order_relaxed))
+    {
+        if (Job* job = FindJob(workerIndex))
+        {
+            Execute(job, workerIndex);
+            idleSpins = 0;
+            continue;
+        }
+
+        // Only once there is nothing else to do, so frame work is never queued behind a long background job
+        if (RunBackgroundJob(workerIndex))
+        {
+            idleSpins = 0;
+            continue;
+        }
+
+        if (++idleSpins < IdleSpinCount)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock lock(m_WakeMutex);
+        m_SleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+        m_WakeCondition.wait(lock, [this]()
+        {
+            return m_PendingJobs.load(std::memory_order_seq_cst) > 0 || m_bShutdown.load(std::memory_order_relaxed);
+        });
+        m_SleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+        idleSpins = 0;
+    }
+
+    t_JobSystem = nullptr;
+    t_WorkerIndex = InvalidWorker;
+}
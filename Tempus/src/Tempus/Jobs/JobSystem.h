@@ -0,0 +1,283 @@
+// Copyright Levi Spevakow (C) 2025
+
+#pragma once
+
+#include "Core/Core.h"
+#include "WorkStealingQueue.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#define JOB_SYSTEM ::Tempus::GApp->GetJobSystem()
+
+namespace Tempus
+{
+    class JobCounter;
+
+    // A single unit of work. The callable is stored inline so scheduling a job never allocates.
+    struct alignas(64) Job
+    {
+        static constexpr size_t StorageSize = 40;
+        using InvokeFunc = void(*)(void* storage);
+
+        InvokeFunc invoke = nullptr;
+        JobCounter* counter = nullptr;
+        // Set while the job is queued or running, the slot can't be reused until it is cleared
+        std::atomic<bool> bInUse = false;
+        alignas(8) std::byte storage[StorageSize];
+    };
+
+    // Tracks completion of a group of jobs.
+    // Incremented when a job is scheduled against it and decremented when that job finishes.
+    // Jobs scheduled with JobSystem::RunAfter() are held back until the counter reaches zero.
+    // Only destroy a counter after JobSystem::Wait() on it has returned.
+    class TEMPUS_API JobCounter
+    {
+    public:
+
+        JobCounter() = default;
+
+        bool IsDone() const { return m_Value.load(std::memory_order_acquire) == 0; }
+        uint32_t GetValue() const { return m_Value.load(std::memory_order_acquire); }
+
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+    private:
+
+        friend class JobSystem;
+
+        std::atomic<uint32_t> m_Value = 0;
+        std::mutex m_ContinuationMutex;
+        std::vector<Job*> m_Continuations;
+    };
+
+    // Work stealing thread pool.
+    // Each worker owns a Chase-Lev deque, spawns onto the bottom of it and steals from the top of others when empty.
+    // The thread that calls Init() becomes worker 0 and takes part in executing jobs while it waits on a counter.
+    // Jobs scheduled from a thread outside the pool are executed inline on that thread.
+    class TEMPUS_API JobSystem
+    {
+    public:
+
+        static constexpr uint32_t MaxJobsPerWorker = 4096;
+        static constexpr uint32_t InvalidWorker = std::numeric_limits<uint32_t>::max();
+
+        JobSystem() = default;
+        ~JobSystem();
+
+        // A worker count of 0 uses one worker per hardware thread
+        void Init(uint32_t workerCount = 0);
+        void Shutdown();
+
+        bool IsInitialized() const { return !m_Workers.empty(); }
+        // Includes the thread that called Init()
+        uint32_t GetWorkerCount() const { return static_cast<uint32_t>(m_Workers.size()); }
+
+        // Schedules func() to run on any worker. If a counter is given it is incremented now and decremented once func returns.
+        template<typename Func>
+        void Run(Func&& func, JobCounter* counter = nullptr)
+        {
+            if (counter)
+            {
+                counter->m_Value.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            Job* job = CreateJob(std::forward<Func>(func), counter);
+            if (!job)
+            {
+                ExecuteInline(std::forward<Func>(func), counter);
+                return;
+            }
+            Submit(job);
+        }
+
+        // Schedules func() to run once the dependency counter reaches zero
+        template<typename Func>
+        void RunAfter(JobCounter& dependency, Func&& func, JobCounter* counter = nullptr)
+        {
+            if (counter)
+            {
+                counter->m_Value.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            Job* job = CreateJob(std::forward<Func>(func), counter);
+            if (!job)
+            {
+                Wait(dependency);
+                ExecuteInline(std::forward<Func>(func), counter);
+                return;
+            }
+
+            {
+                std::lock_guard lock(dependency.m_ContinuationMutex);
+                if (!dependency.IsDone())
+                {
+                    dependency.m_Continuations.push_back(job);
+                    return;
+                }
+            }
+            Submit(job);
+        }
+
+        // Schedules long running func(), such as loading, to run on a worker other than the thread that called Init().
+        // Background jobs are only picked up by idle workers and never by Wait(), so they can't stall the caller's frame.
+        // The callable is stored on the heap, there is no size limit. Runs inline if the pool has no other workers.
+        template<typename Func>
+        void RunBackground(Func&& func, JobCounter* counter = nullptr)
+        {
+            if (counter)
+            {
+                counter->m_Value.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            if (GetWorkerCount() <= 1)
+            {
+                ExecuteInline(std::forward<Func>(func), counter);
+                return;
+            }
+
+            {
+                std::lock_guard lock(m_BackgroundMutex);
+                m_BackgroundJobs.push_back({ std::function<void()>(std::forward<Func>(func)), counter });
+            }
+            m_PendingJobs.fetch_add(1, std::memory_order_seq_cst);
+            WakeWorker();
+        }
+
+        // Blocks until the counter reaches zero, executing other jobs in the meantime
+        void Wait(JobCounter& counter);
+
+        // Splits [0, count) into ranges of at most grainSize elements and invokes func(begin, end) for each in parallel.
+        // Ranges are split recursively so idle workers steal large halves rather than one small range at a time.
+        // Blocks until every range has been processed.
+        template<typename Func>
+        void ParallelFor(uint32_t count, uint32_t grainSize, Func&& func)
+        {
+            if (count == 0)
+            {
+                return;
+            }
+
+            grainSize = std::max(grainSize, 1u);
+            if (count <= grainSize || GetWorkerCount() <= 1)
+            {
+                func(0u, count);
+                return;
+            }
+
+            JobCounter counter;
+            ParallelForRange(0, count, grainSize, func, counter);
+            Wait(counter);
+        }
+
+        // Number of jobs executed by each worker since Init(), for load balance diagnostics
+        std::vector<uint64_t> GetExecutedJobCounts() const;
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+    private:
+
+        struct Worker
+        {
+            WorkStealingQueue<Job, MaxJobsPerWorker> queue;
+            // Ring of job slots, only the owning worker allocates from it
+            std::unique_ptr<Job[]> jobPool = std::make_unique<Job[]>(MaxJobsPerWorker);
+            uint32_t nextJob = 0;
+            uint32_t randomState = 0;
+            std::atomic<uint64_t> executedJobs = 0;
+            std::thread thread;
+        };
+
+        template<typename Func>
+        Job* CreateJob(Func&& func, JobCounter* counter)
+        {
+            using FuncType = std::decay_t<Func>;
+            TPS_STATIC_ASSERT(sizeof(FuncType) <= Job::StorageSize, "Job callable is too large, capture less state or capture by reference");
+            TPS_STATIC_ASSERT(alignof(FuncType) <= 8, "Job callable alignment is too large");
+
+            Job* job = AllocateJob();
+            if (!job)
+            {
+                return nullptr;
+            }
+
+            new (job->storage) FuncType(std::forward<Func>(func));
+            job->invoke = [](void* storage)
+            {
+                FuncType* storedFunc = std::launder(static_cast<FuncType*>(storage));
+                (*storedFunc)();
+                storedFunc->~FuncType();
+            };
+            job->counter = counter;
+            return job;
+        }
+
+        template<typename Func>
+        void ExecuteInline(Func&& func, JobCounter* counter)
+        {
+            func();
+            if (counter)
+            {
+                FinishCounter(*counter);
+            }
+        }
+
+        template<typename Func>
+        void ParallelForRange(uint32_t begin, uint32_t end, uint32_t grainSize, Func& func, JobCounter& counter)
+        {
+            while (end - begin > grainSize)
+            {
+                // Hand the upper half to the pool and keep splitting the lower half
+                const uint32_t mid = begin + (end - begin) / 2;
+                Run([this, mid, end, grainSize, &func, &counter]()
+                {
+                    ParallelForRange(mid, end, grainSize, func, counter);
+                }, &counter);
+                end = mid;
+            }
+            func(begin, end);
+        }
+
+        struct BackgroundJob
+        {
+            std::function<void()> func;
+            JobCounter* counter = nullptr;
+        };
+
+        // Returns nullptr when called from outside the pool or when the next slot is still in use
+        Job* AllocateJob();
+        void Submit(Job* job);
+        void WakeWorker();
+        // Runs the oldest background job, returns false if there was none
+        bool RunBackgroundJob(uint32_t workerIndex);
+        void Execute(Job* job, uint32_t workerIndex);
+        void FinishCounter(JobCounter& counter);
+        Job* FindJob(uint32_t workerIndex);
+        uint32_t GetCurrentWorkerIndex() const;
+        void WorkerLoop(uint32_t workerIndex);
+
+        std::vector<std::unique_ptr<Worker>> m_Workers;
+        std::thread::id m_OwnerThreadId;
+
+        // Jobs queued but not yet picked up, lets idle workers sleep instead of spinning
+        std::atomic<uint32_t> m_PendingJobs = 0;
+        std::atomic<uint32_t> m_SleepingWorkers = 0;
+        std::mutex m_WakeMutex;
+        std::condition_variable m_WakeCondition;
+        std::atomic<bool> m_bShutdown = false;
+
+        std::mutex m_BackgroundMutex;
+        std::deque<BackgroundJob> m_BackgroundJobs;
+    };
+}
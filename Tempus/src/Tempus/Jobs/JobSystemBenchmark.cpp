@@ -0,0 +1,92 @@
+// Copyright Levi Spevakow (C) 2025
+
+#include "JobSystemBenchmark.h"
+
+#include "JobSystem.h"
+#include <chrono>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace
+{
+    // Stays below JobSystem::MaxJobsPerWorker so the job ring never wraps onto a pending job
+    constexpr uint32_t EmptyJobBatchSize = 2048;
+    constexpr uint32_t EmptyJobCount = 100 * EmptyJobBatchSize;
+    constexpr uint32_t TransformGrainSize = 1024;
+
+    struct BenchmarkTransform
+    {
+        glm::vec3 position;
+        glm::vec3 rotation;
+        glm::vec3 scale;
+    };
+
+    double ElapsedMs(std::chrono::high_resolution_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+}
+
+std::vector<Tempus::JobSystemBenchmark::Result> Tempus::JobSystemBenchmark::Run(uint32_t maxWorkers, uint32_t transformCount)
+{
+    if (maxWorkers == 0)
+    {
+        maxWorkers = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    std::vector<BenchmarkTransform> transforms(transformCount);
+    for (uint32_t i = 0; i < transformCount; i++)
+    {
+        const float f = static_cast<float>(i);
+        transforms[i] = { glm::vec3(f, f * 0.5f, -f), glm::vec3(f * 0.1f, f * 0.2f, f * 0.3f), glm::vec3(1.0f) };
+    }
+    std::vector<glm::mat4> matrices(transformCount);
+
+    std::vector<Result> results;
+    for (uint32_t workerCount = 1; workerCount <= maxWorkers; workerCount++)
+    {
+        JobSystem jobSystem;
+        jobSystem.Init(workerCount);
+
+        Result result;
+        result.workerCount = workerCount;
+
+        // Scheduling overhead
+        auto start = std::chrono::high_resolution_clock::now();
+        for (uint32_t batch = 0; batch < EmptyJobCount; batch += EmptyJobBatchSize)
+        {
+            JobCounter counter;
+            for (uint32_t i = 0; i < EmptyJobBatchSize; i++)
+            {
+                jobSystem.Run([]() {}, &counter);
+            }
+            jobSystem.Wait(counter);
+        }
+        result.nsPerJob = ElapsedMs(start) * 1'000'000.0 / EmptyJobCount;
+
+        // Embarrassingly parallel model matrix building
+        start = std::chrono::high_resolution_clock::now();
+        jobSystem.ParallelFor(transformCount, TransformGrainSize, [&transforms, &matrices](uint32_t begin, uint32_t end)
+        {
+            for (uint32_t i = begin; i < end; i++)
+            {
+                const BenchmarkTransform& transform = transforms[i];
+                glm::mat4 model = glm::translate(glm::mat4(1.0f), transform.position);
+                model = glm::rotate(model, glm::radians(transform.rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
+                model = glm::rotate(model, glm::radians(transform.rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
+                model = glm::rotate(model, glm::radians(transform.rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
+                matrices[i] = glm::scale(model, transform.scale);
+            }
+        });
+        result.parallelForMs = ElapsedMs(start);
+        result.speedup = results.empty() ? 1.0 : results.front().parallelForMs / result.parallelForMs;
+
+        jobSystem.Shutdown();
+
+        TPS_CORE_INFO("Job benchmark | Workers: {0} | {1:.1f} ns/job | ParallelFor {2} transforms: {3:.3f} ms ({4:.2f}x)",
+            result.workerCount, result.nsPerJob, transformCount, result.parallelForMs, result.speedup);
+        results.push_back(result);
+    }
+
+    return results;
+}
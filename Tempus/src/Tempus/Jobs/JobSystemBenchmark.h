@@ -0,0 +1,30 @@
+// Copyright Levi Spevakow (C) 2025
+
+#pragma once
+
+#include "Core/Core.h"
+#include <vector>
+
+namespace Tempus
+{
+    // Measures job scheduling overhead and ParallelFor scaling on 1..N workers.
+    // Each worker count runs on its own temporary JobSystem so the engine's pool is left untouched.
+    class TEMPUS_API JobSystemBenchmark
+    {
+    public:
+
+        struct Result
+        {
+            uint32_t workerCount = 0;
+            // Average cost of scheduling, running and waiting on an empty job
+            double nsPerJob = 0.0;
+            // Time to build model matrices for every transform with ParallelFor
+            double parallelForMs = 0.0;
+            // ParallelFor speedup relative to the single worker run
+            double speedup = 0.0;
+        };
+
+        // A max worker count of 0 tests up to one worker per hardware thread
+        static std::vector<Result> Run(uint32_t maxWorkers = 0, uint32_t transformCount = 1'000'000);
+    };
+}
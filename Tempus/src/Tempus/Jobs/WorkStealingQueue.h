@@ -0,0 +1,102 @@
+// Copyright Levi Spevakow (C) 2025
+
+#pragma once
+
+#include "Core/Core.h"
+#include <atomic>
+#include <array>
+
+namespace Tempus
+{
+    // Fixed capacity Chase-Lev work stealing deque.
+    // - The owning worker pushes and pops from the bottom (LIFO, keeps recently spawned work hot in cache)
+    // - Any other worker steals from the top (FIFO, takes the oldest and usually largest work)
+    // Based on "Correct and Efficient Work-Stealing for Weak Memory Models" (Le et al. 2013), using seq_cst
+    // operations in place of standalone fences.
+    template<typename T, uint32_t Capacity>
+    class WorkStealingQueue
+    {
+        TPS_STATIC_ASSERT((Capacity & (Capacity - 1)) == 0, "WorkStealingQueue capacity must be a power of two");
+
+    public:
+
+        // Owner thread only. Returns false if the queue is full.
+        bool Push(T* item)
+        {
+            const int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+            const int64_t top = m_Top.load(std::memory_order_acquire);
+
+            if (bottom - top >= static_cast<int64_t>(Capacity))
+            {
+                return false;
+            }
+
+            m_Items[bottom & Mask].store(item, std::memory_order_relaxed);
+            // Publishes the item (and everything written to it) to stealers that acquire bottom
+            m_Bottom.store(bottom + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Owner thread only. Returns nullptr if the queue is empty.
+        T* Pop()
+        {
+            const int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+            // Reserving the slot must be ordered before reading top, or a stealer could take the same item
+            m_Bottom.store(bottom, std::memory_order_seq_cst);
+            int64_t top = m_Top.load(std::memory_order_seq_cst);
+
+            if (top > bottom)
+            {
+                // Queue was already empty
+                m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            T* item = m_Items[bottom & Mask].load(std::memory_order_relaxed);
+            if (top == bottom)
+            {
+                // Last item, race against stealers for it
+                if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    item = nullptr;
+                }
+                m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+            return item;
+        }
+
+        // Any thread. Returns nullptr if the queue is empty or the steal lost a race.
+        T* Steal()
+        {
+            int64_t top = m_Top.load(std::memory_order_seq_cst);
+            const int64_t bottom = m_Bottom.load(std::memory_order_seq_cst);
+
+            if (top >= bottom)
+            {
+                return nullptr;
+            }
+
+            T* item = m_Items[top & Mask].load(std::memory_order_relaxed);
+            if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                return nullptr;
+            }
+            return item;
+        }
+
+        // Approximate, only meaningful as a hint
+        bool IsEmpty() const
+        {
+            return m_Bottom.load(std::memory_order_relaxed) <= m_Top.load(std::memory_order_relaxed);
+        }
+
+    private:
+
+        static constexpr int64_t Mask = static_cast<int64_t>(Capacity) - 1;
+
+        // Top and bottom live on separate cache lines as they are written by different threads
+        alignas(64) std::atomic<int64_t> m_Top = 0;
+        alignas(64) std::atomic<int64_t> m_Bottom = 0;
+        alignas(64) std::array<std::atomic<T*>, Capacity> m_Items{};
+    };
+}
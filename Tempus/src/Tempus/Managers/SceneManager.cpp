@@ -3,16 +3,70 @@
 #include "SceneManager.h"
 
 #include "Core/Application.h"
+#include "Core/Renderer.h"
+#include "Core/SceneSerializer.h"
+#include "Jobs/JobSystem.h"
+#include "Utils/FileUtils.h"
 #include "Components/Component.h"
+#include "Components/ComponentTypeTable.h"
 #include "Entity/Entity.h"
 #include "Components/TransformComponent.h"
 #include "Components/CameraComponent.h"
-#include "Components/EditorDataComponent.h"
+#include "Components/EditorTagComponents.h"
 #include "Components/StaticMeshComponent.h"
+#include "Components/WorldCellComponent.h"
+#include "Components/WorldTransformComponent.h"
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_set>
 
-Tempus::Scene* Tempus::SceneManager::CreateScene(const std::string& sceneName)
+struct Tempus::SceneManager::StreamedModels
 {
-    m_ActiveScene = std::make_unique<Scene>(sceneName);
+    std::mutex mutex;
+    // Uploaded already or claimed by a loading job
+    std::unordered_set<std::string> requested;
+    // Read by loading jobs, waiting to be uploaded
+    std::vector<ModelData> ready;
+};
+
+namespace
+{
+    // Every model the scene's meshes use, once each
+    std::vector<std::string> GetMeshModelNames(Tempus::Scene& scene)
+    {
+        using namespace Tempus;
+
+        // Instances of one mesh share a handle, so each shared block's model name is only looked up once
+        std::unordered_set<std::string> modelNames;
+        std::vector<bool> visitedMeshes;
+        for (auto [id, mesh] : scene.View<StaticMeshComponent>())
+        {
+            const SharedDataHandle handle = mesh.GetMesh().GetHandle();
+            if (handle >= visitedMeshes.size())
+            {
+                visitedMeshes.resize(handle + 1, false);
+            }
+            if (visitedMeshes[handle])
+            {
+                continue;
+            }
+            visitedMeshes[handle] = true;
+            modelNames.insert(mesh.GetModelName());
+        }
+        return std::vector<std::string>(modelNames.begin(), modelNames.end());
+    }
+}
+
+Tempus::Scene* Tempus::SceneManager::CreateScene(const std::string& sceneName, SceneStorageMode storageMode)
+{
+    m_ActiveScene = std::make_unique<Scene>(sceneName, storageMode);
+    m_EditScene.reset();
+    m_PendingLoad.reset();
+    m_PendingModels.reset();
+    m_WorldPartition.reset();
+    m_StreamedModels.reset();
+    m_History.Clear();
     
     CreateEditorCamera();
     
@@ -21,11 +75,240 @@ Tempus::Scene* Tempus::SceneManager::CreateScene(const std::string& sceneName)
 
 bool Tempus::SceneManager::SetActiveScene(const std::string& sceneName)
 {
-    return false;
+    const std::filesystem::path path = FileUtils::ScenesDir() / (sceneName + SceneSerializer::FileExtension);
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(path, error))
+    {
+        TPS_CORE_ERROR("Can't set active scene [{0}], no scene file at [{1}]!", sceneName, path.string());
+        return false;
+    }
+
+    return LoadSceneAsync(path);
+}
+
+bool Tempus::SceneManager::SaveActiveScene(const std::filesystem::path& path)
+{
+    return m_ActiveScene && SceneSerializer::Save(*m_ActiveScene, path);
+}
+
+Tempus::Scene* Tempus::SceneManager::LoadScene(const std::filesystem::path& path)
+{
+    std::unique_ptr<Scene> scene = SceneSerializer::Load(path);
+    if (!scene)
+    {
+        return nullptr;
+    }
+
+    m_PendingLoad.reset();
+    m_PendingModels.reset();
+    SetLoadedScene(std::move(scene));
+
+    return m_ActiveScene.get();
+}
+
+bool Tempus::SceneManager::LoadSceneAsync(const std::filesystem::path& path)
+{
+    if (m_PendingLoad)
+    {
+        TPS_CORE_WARN("Can't load scene [{0}], scene [{1}] is still loading!", path.string(), m_PendingLoad->GetPath().string());
+        return false;
+    }
+
+    // The renderer is only read here on the main thread, the worker gets a snapshot of the loaded models
+    Renderer* renderer = GApp ? GApp->GetRenderer() : nullptr;
+    std::shared_ptr<std::vector<ModelData>> models = std::make_shared<std::vector<ModelData>>();
+    AsyncSceneLoad::PrepareFunc prepare;
+    if (renderer)
+    {
+        prepare = [models, loadedModels = renderer->GetLoadedModelNames()](Scene& scene) mutable
+        {
+            // The view caches the renderer draws from are built on first use, which would otherwise be the swap frame
+            scene.View<WorldTransformComponent, StaticMeshComponent>().GetSize();
+
+            for (const std::string& modelName : GetMeshModelNames(scene))
+            {
+                ModelData model;
+                if (loadedModels.insert(modelName).second && Renderer::ReadModel(modelName, model))
+                {
+                    models->push_back(std::move(model));
+                }
+            }
+        };
+    }
+
+    TPS_CORE_INFO("Loading scene [{0}] in the background", path.string());
+    m_PendingModels = std::move(models);
+    m_PendingLoad = AsyncSceneLoad::Start(path, GApp ? JOB_SYSTEM : nullptr, std::move(prepare));
+    return true;
+}
+
+bool Tempus::SceneManager::OpenWorldPartition(const std::filesystem::path& directory, const WorldPartitionSettings& settings)
+{
+    if (!m_ActiveScene)
+    {
+        return false;
+    }
+
+    CloseWorldPartition();
+
+    std::unique_ptr<WorldPartition> partition = std::make_unique<WorldPartition>(settings);
+    if (!partition->Open(directory))
+    {
+        return false;
+    }
+
+    // Loading jobs claim the models they read, so two cells using a new model don't both read it
+    if (Renderer* renderer = GApp ? GApp->GetRenderer() : nullptr)
+    {
+        std::shared_ptr<StreamedModels> models = std::make_shared<StreamedModels>();
+        models->requested = renderer->GetLoadedModelNames();
+        partition->SetCellPrepareFunc([models](Scene& cell)
+        {
+            std::vector<std::string> modelNames = GetMeshModelNames(cell);
+            {
+                std::lock_guard lock(models->mutex);
+                std::erase_if(modelNames, [&models](const std::string& modelName) { return !models->requested.insert(modelName).second; });
+            }
+
+            std::vector<ModelData> readModels;
+            for (const std::string& modelName : modelNames)
+            {
+                ModelData model;
+                if (Renderer::ReadModel(modelName, model))
+                {
+                    readModels.push_back(std::move(model));
+                }
+            }
+
+            std::lock_guard lock(models->mutex);
+            std::move(readModels.begin(), readModels.end(), std::back_inserter(models->ready));
+        });
+        m_StreamedModels = std::move(models);
+    }
+
+    m_WorldPartition = std::move(partition);
+    return true;
+}
+
+void Tempus::SceneManager::CloseWorldPartition()
+{
+    if (!m_WorldPartition)
+    {
+        return;
+    }
+
+    if (m_ActiveScene)
+    {
+        m_WorldPartition->UnloadAll(*m_ActiveScene);
+    }
+    if (m_EditScene)
+    {
+        m_WorldPartition->UnloadAll(*m_EditScene);
+    }
+    m_WorldPartition.reset();
+    m_StreamedModels.reset();
+
+    TPS_CORE_INFO("World partition closed!");
+}
+
+bool Tempus::SceneManager::RecordUndoStep()
+{
+    return m_ActiveScene && !IsPlaying() && m_History.Record(*m_ActiveScene);
+}
+
+bool Tempus::SceneManager::Undo()
+{
+    if (IsPlaying())
+    {
+        return false;
+    }
+
+    std::unique_ptr<Scene> scene = m_History.Undo(m_ActiveScene.get());
+    if (!scene)
+    {
+        return false;
+    }
+
+    m_ActiveScene = std::move(scene);
+    return true;
+}
+
+bool Tempus::SceneManager::Redo()
+{
+    if (IsPlaying())
+    {
+        return false;
+    }
+
+    std::unique_ptr<Scene> scene = m_History.Redo(m_ActiveScene.get());
+    if (!scene)
+    {
+        return false;
+    }
+
+    m_ActiveScene = std::move(scene);
+    return true;
+}
+
+bool Tempus::SceneManager::BeginPlay()
+{
+    if (!m_ActiveScene || IsPlaying())
+    {
+        return false;
+    }
+
+    // The clone is the one that plays, so the edited scene keeps its serial and undo history
+    std::unique_ptr<Scene> playScene = m_ActiveScene->Clone();
+    m_EditScene = std::move(m_ActiveScene);
+    m_ActiveScene = std::move(playScene);
+
+    TPS_CORE_INFO("Play session started! Scene: [{0}]", m_ActiveScene->GetName());
+    return true;
+}
+
+bool Tempus::SceneManager::EndPlay()
+{
+    if (!IsPlaying())
+    {
+        return false;
+    }
+
+    // Editor only entities were never part of the play session, so the view carries over. Streamed world cells
+    // are an exception, their IDs change as cells stream, the world partition takes over the edited scene's cells instead.
+    for (auto [id, transform, tag] : m_ActiveScene->View<TransformComponent, EditorNoSerializeTag>())
+    {
+        if (m_ActiveScene->HasComponent<WorldCellComponent>(id))
+        {
+            continue;
+        }
+        if (TransformComponent* editTransform = m_EditScene->GetMutableComponent<TransformComponent>(id))
+        {
+            *editTransform = transform;
+        }
+    }
+
+    m_ActiveScene = std::move(m_EditScene);
+
+    TPS_CORE_INFO("Play session ended! Scene: [{0}]", m_ActiveScene->GetName());
+    return true;
 }
 
 void Tempus::SceneManager::OnUpdate(float DeltaTime)
 {
+    // Swapped before updating so the loaded scene is what this frame updates and renders
+    if (m_PendingLoad && m_PendingLoad->IsFinished())
+    {
+        SwapInPendingScene();
+    }
+
+    // Streamed before updating, so cells copied in this frame have their world transforms by the time they are rendered
+    glm::vec3 focus;
+    if (m_WorldPartition && GetStreamingFocus(focus))
+    {
+        m_WorldPartition->Update(*m_ActiveScene, focus, GApp ? JOB_SYSTEM : nullptr);
+        UploadStreamedModels();
+    }
+
     if (m_ActiveScene)
     {
         m_ActiveScene->OnUpdate(DeltaTime);
@@ -42,6 +325,98 @@ void Tempus::SceneManager::CreateEditorCamera()
         {
             camComp->FarClip = 10000.0f;
         }
-        editorCam.AddComponent<EditorDataComponent>(EditorEntityDataFlags::NoDelete | EditorEntityDataFlags::NoSerialize | EditorEntityDataFlags::NoAddComponent | EditorEntityDataFlags::NoRemoveComponent);
+        editorCam.AddComponent<EditorNoDeleteTag>();
+        editorCam.AddComponent<EditorNoSerializeTag>();
+        editorCam.AddComponent<EditorNoAddComponentTag>();
+        editorCam.AddComponent<EditorNoRemoveComponentTag>();
+    }
+}
+
+void Tempus::SceneManager::SetLoadedScene(std::unique_ptr<Scene> scene)
+{
+    m_ActiveScene = std::move(scene);
+    m_EditScene.reset();
+    m_WorldPartition.reset();
+    m_StreamedModels.reset();
+    m_History.Clear();
+
+    CreateEditorCamera();
+}
+
+void Tempus::SceneManager::SwapInPendingScene()
+{
+    const std::shared_ptr<AsyncSceneLoad> load = std::move(m_PendingLoad);
+    const std::shared_ptr<std::vector<ModelData>> models = std::move(m_PendingModels);
+
+    std::unique_ptr<Scene> scene = load->TakeScene();
+    if (!scene)
+    {
+        TPS_CORE_ERROR("Failed to load scene [{0}]!", load->GetPath().string());
+        return;
+    }
+
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    if (Renderer* renderer = GApp ? GApp->GetRenderer() : nullptr)
+    {
+        for (const ModelData& model : *models)
+        {
+            renderer->UploadModel(model);
+        }
+    }
+
+    // Freeing a large scene takes as long as building it, so the replaced scenes are freed by a background job
+    std::shared_ptr<Scene> previousScene = std::move(m_ActiveScene);
+    std::shared_ptr<Scene> previousEditScene = std::move(m_EditScene);
+    SetLoadedScene(std::move(scene));
+    if (JobSystem* jobSystem = GApp ? JOB_SYSTEM : nullptr)
+    {
+        jobSystem->RunBackground([previousScene = std::move(previousScene), previousEditScene = std::move(previousEditScene)]() {});
+    }
+
+    const double swapMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    TPS_CORE_INFO("Scene [{0}] swapped in! Loaded in the background in {1:.2f} ms, swap took {2:.2f} ms",
+        m_ActiveScene->GetName(), load->GetLoadMs(), swapMs);
+}
+
+bool Tempus::SceneManager::GetStreamingFocus(glm::vec3& outFocus) const
+{
+    Renderer* renderer = GApp ? GApp->GetRenderer() : nullptr;
+    if (!renderer || !m_ActiveScene || !m_ActiveScene->HasEntity(renderer->GetActiveCamera()))
+    {
+        return false;
+    }
+
+    const uint32_t cameraId = renderer->GetActiveCamera();
+    if (const WorldTransformComponent* worldTransform = m_ActiveScene->GetComponent<WorldTransformComponent>(cameraId))
+    {
+        outFocus = worldTransform->GetPosition();
+        return true;
+    }
+    if (const TransformComponent* transform = m_ActiveScene->GetComponent<TransformComponent>(cameraId))
+    {
+        outFocus = transform->Position;
+        return true;
+    }
+    return false;
+}
+
+void Tempus::SceneManager::UploadStreamedModels()
+{
+    Renderer* renderer = GApp ? GApp->GetRenderer() : nullptr;
+    if (!renderer || !m_StreamedModels)
+    {
+        return;
+    }
+
+    // Cells finished loading this frame read their models before finishing, so they are all in the list by now
+    std::vector<ModelData> models;
+    {
+        std::lock_guard lock(m_StreamedModels->mutex);
+        models.swap(m_StreamedModels->ready);
+    }
+    for (const ModelData& model : models)
+    {
+        renderer->UploadModel(model);
     }
 }
@@ -4,12 +4,21 @@
 
 #include "Core/Core.h"
 #include "Core/IUpdateable.h"
+#include "Core/AsyncSceneLoad.h"
 #include "Core/Scene.h"
+#include "Core/SceneHistory.h"
+#include "Core/WorldPartition.h"
+#include <glm/vec3.hpp>
+#include <filesystem>
+#include <memory>
+#include <vector>
 
 #define SCENE_MANAGER ::Tempus::GApp->GetManager<Tempus::SceneManager>()
 
 namespace Tempus
 {
+    struct ModelData;
+
     class TEMPUS_API SceneManager : public IUpdateable
     {
         TPS_DEBUG_NAME("Scene Manager")
@@ -20,19 +29,78 @@ namespace Tempus
 
         SceneManager() = default;
         std::unique_ptr<Scene> m_ActiveScene = nullptr;
+        SceneHistory m_History;
+        // The scene as it was edited, set aside while a clone of it plays
+        std::unique_ptr<Scene> m_EditScene = nullptr;
+        // Scene file being loaded by LoadSceneAsync(), swapped in by the first update after it finishes
+        std::shared_ptr<AsyncSceneLoad> m_PendingLoad = nullptr;
+        // Models used by the pending scene that weren't loaded yet, read by the loading worker
+        std::shared_ptr<std::vector<ModelData>> m_PendingModels = nullptr;
+        // Streams world cells into the active scene around the active camera
+        std::unique_ptr<WorldPartition> m_WorldPartition = nullptr;
+        // Models used by streamed cells, shared with the cells' loading jobs
+        struct StreamedModels;
+        std::shared_ptr<StreamedModels> m_StreamedModels = nullptr;
 
     public:
         
-        Scene* CreateScene(const std::string& sceneName);
+        Scene* CreateScene(const std::string& sceneName, SceneStorageMode storageMode = SceneStorageMode::ComponentPools);
         Scene* GetActiveScene() const { return m_ActiveScene.get();}
+        // Loads the scene saved as sceneName in the scenes directory with LoadSceneAsync(), so it replaces the active scene
+        // at the start of the first update after it is ready. Returns false if there is no such file or a load is already
+        // in progress.
         bool SetActiveScene(const std::string& sceneName);
 
+        // Writes the active scene to a scene file, see SceneSerializer
+        bool SaveActiveScene(const std::filesystem::path& path);
+        // Replaces the active scene with the one saved in the file, which keeps its entity IDs. The editor camera
+        // takes the first free slot, which is ID 0 for scenes saved from the editor. Returns nullptr and keeps the
+        // current scene if the file couldn't be loaded.
+        Scene* LoadScene(const std::filesystem::path& path);
+        // Loads the scene file on a background worker while the active scene keeps updating and rendering. The worker also
+        // builds the scene's world transforms and reads the models it uses that aren't loaded yet. The loaded scene replaces
+        // the active one at the start of the first update after it is ready, the same way LoadScene() does. Returns false if
+        // a load is already in progress. Calling CreateScene() or LoadScene() in the meantime discards the pending load.
+        bool LoadSceneAsync(const std::filesystem::path& path);
+        bool IsLoadingScene() const { return m_PendingLoad != nullptr; }
+        std::filesystem::path GetLoadingScenePath() const { return m_PendingLoad ? m_PendingLoad->GetPath() : std::filesystem::path(); }
+
+        // Streams the cells of a directory written by WorldPartition::BuildCells() into the active scene around the
+        // renderer's active camera, see WorldPartition. The models the cells use are read by their loading jobs.
+        // Replaces the partition that is open, creating or loading a scene closes it.
+        bool OpenWorldPartition(const std::filesystem::path& directory, const WorldPartitionSettings& settings = {});
+        // Removes every streamed entity from the active and edited scene and stops streaming
+        void CloseWorldPartition();
+        WorldPartition* GetWorldPartition() const { return m_WorldPartition.get(); }
+
+        // Records the active scene as an undo step, call after every editor operation. Returns false if nothing changed.
+        bool RecordUndoStep();
+        // Replace the active scene with the one of the previous or next undo step, the editor camera keeps its view
+        bool Undo();
+        bool Redo();
+        SceneHistory& GetHistory() { return m_History; }
+
+        // Starts a play session on a clone of the active scene, the edited scene is set aside untouched
+        bool BeginPlay();
+        // Ends the play session by swapping the edited scene back in, everything that changed while playing is
+        // discarded apart from the editor camera's view. Undo steps aren't recorded while playing.
+        bool EndPlay();
+        bool IsPlaying() const { return m_EditScene != nullptr; }
+
         bool IsUpdating() const override { return true; };
         void OnUpdate(float DeltaTime) override;
 
     private:
 
         void CreateEditorCamera();
+        // Makes the scene active with a fresh history and editor camera, ending any play session
+        void SetLoadedScene(std::unique_ptr<Scene> scene);
+        // Swaps in the scene of a finished LoadSceneAsync(), uploading its models first
+        void SwapInPendingScene();
+        // Position of the renderer's active camera, false if it has no transform
+        bool GetStreamingFocus(glm::vec3& outFocus) const;
+        // Uploads the models loading jobs read for streamed cells
+        void UploadStreamedModels();
       
     };
 
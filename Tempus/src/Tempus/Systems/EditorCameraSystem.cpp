@@ -8,8 +8,7 @@
 Tempus::EditorCameraSystem::EditorCameraSystem() : System()
 {
     // Initializing the signature for the Editor Camera System
-    m_Signature.set(TransformComponent::GetId());
-    m_Signature.set(CameraComponent::GetId());
+    Reads<TransformComponent, CameraComponent>();
 }
 
 void Tempus::EditorCameraSystem::OnInit(class Scene* ownerScene)
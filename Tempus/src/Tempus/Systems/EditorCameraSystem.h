@@ -9,6 +9,8 @@ namespace Tempus
 {
     class TEMPUS_API EditorCameraSystem : public System
     {
+        TPS_DEBUG_NAME("Editor Camera System")
+
     public:
 
         EditorCameraSystem();
@@ -21,10 +21,33 @@ namespace Tempus
         virtual void OnUpdate(float DeltaTime) override {}
         
         ComponentSignature GetComponentSignature() const { return m_Signature; }
+        ComponentSignature GetReadSignature() const { return m_ReadSignature; }
+        ComponentSignature GetWriteSignature() const { return m_WriteSignature; }
+
+        // Systems that declare no component access are assumed to touch everything and never run in parallel
+        bool HasDeclaredAccess() const { return m_ReadSignature.any() || m_WriteSignature.any(); }
 
     protected:
 
+        // Declares components this system only reads during OnUpdate, used by the scheduler to run systems in parallel
+        template<ValidComponent... Ts>
+        void Reads()
+        {
+            (m_ReadSignature.set(Ts::GetId()), ...);
+            m_Signature |= m_ReadSignature;
+        }
+
+        // Declares components this system modifies during OnUpdate
+        template<ValidComponent... Ts>
+        void Writes()
+        {
+            (m_WriteSignature.set(Ts::GetId()), ...);
+            m_Signature |= m_WriteSignature;
+        }
+
         ComponentSignature m_Signature;
+        ComponentSignature m_ReadSignature;
+        ComponentSignature m_WriteSignature;
         std::set<uint32_t> m_Entities;
         Scene* m_OwnerScene = nullptr;
     };
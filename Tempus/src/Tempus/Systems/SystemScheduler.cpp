@@ -0,0 +1,214 @@
+// Copyright Levi Spevakow (C) 2025
+
+#include "SystemScheduler.h"
+
+#include <algorithm>
+#include "Core/Application.h"
+#include "Jobs/JobSystem.h"
+#include "Utils/Profiling.h"
+
+namespace
+{
+    double MsSince(std::chrono::high_resolution_clock::time_point start, std::chrono::high_resolution_clock::time_point end)
+    {
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+}
+
+void Tempus::SystemScheduler::AddSystem(std::unique_ptr<System> system, const char* name)
+{
+    ScheduledSystem& scheduled = m_Systems.emplace_back();
+    scheduled.system = std::move(system);
+    scheduled.name = name;
+}
+
+void Tempus::SystemScheduler::Update(float DeltaTime)
+{
+    BuildGraph();
+    if (m_NodeSystems.empty())
+    {
+        m_FrameMs = 0.0;
+        m_CriticalPathMs = 0.0;
+        return;
+    }
+
+    m_FrameStart = std::chrono::high_resolution_clock::now();
+
+    JobSystem* jobSystem = GApp ? JOB_SYSTEM : nullptr;
+    if (m_bSerialExecution || m_NodeSystems.size() == 1 || !jobSystem || jobSystem->GetWorkerCount() <= 1)
+    {
+        RunSerial(DeltaTime);
+    }
+    else
+    {
+        RunParallel(DeltaTime);
+    }
+
+    m_FrameMs = MsSince(m_FrameStart, std::chrono::high_resolution_clock::now());
+    ComputeCriticalPath();
+    PublishTimings();
+}
+
+bool Tempus::SystemScheduler::Conflicts(const System& a, const System& b)
+{
+    if (!a.HasDeclaredAccess() || !b.HasDeclaredAccess())
+    {
+        return true;
+    }
+
+    const ComponentSignature aAccess = a.GetReadSignature() | a.GetWriteSignature();
+    const ComponentSignature bAccess = b.GetReadSignature() | b.GetWriteSignature();
+    return (a.GetWriteSignature() & bAccess).any() || (b.GetWriteSignature() & aAccess).any();
+}
+
+void Tempus::SystemScheduler::BuildGraph()
+{
+    m_NodeSystems.clear();
+    for (uint32_t i = 0; i < m_Systems.size(); i++)
+    {
+        if (m_Systems[i].system->IsUpdating())
+        {
+            m_NodeSystems.push_back(i);
+        }
+    }
+
+    const uint32_t nodeCount = static_cast<uint32_t>(m_NodeSystems.size());
+    m_Dependents.assign(nodeCount, {});
+    m_Timings.resize(nodeCount);
+
+    if (nodeCount > m_RemainingCapacity)
+    {
+        m_RemainingDependencies = std::make_unique<std::atomic<uint32_t>[]>(nodeCount);
+        m_RemainingCapacity = nodeCount;
+    }
+
+    // Registration order decides which of two conflicting systems runs first, so the graph is always acyclic
+    for (uint32_t node = 0; node < nodeCount; node++)
+    {
+        SystemTiming& timing = m_Timings[node];
+        timing.name = m_Systems[m_NodeSystems[node]].name;
+        timing.dependencies.clear();
+
+        const System& system = *m_Systems[m_NodeSystems[node]].system;
+        for (uint32_t earlier = 0; earlier < node; earlier++)
+        {
+            if (Conflicts(*m_Systems[m_NodeSystems[earlier]].system, system))
+            {
+                timing.dependencies.push_back(earlier);
+                m_Dependents[earlier].push_back(node);
+            }
+        }
+        m_RemainingDependencies[node].store(static_cast<uint32_t>(timing.dependencies.size()), std::memory_order_relaxed);
+    }
+}
+
+void Tempus::SystemScheduler::RunSerial(float DeltaTime)
+{
+    for (uint32_t node = 0; node < m_NodeSystems.size(); node++)
+    {
+        RunNode(node, DeltaTime);
+    }
+}
+
+void Tempus::SystemScheduler::RunParallel(float DeltaTime)
+{
+    JobSystem* jobSystem = JOB_SYSTEM;
+    JobCounter frameCounter;
+    m_FrameCounter = &frameCounter;
+
+    for (uint32_t node = 0; node < m_NodeSystems.size(); node++)
+    {
+        if (m_RemainingDependencies[node].load(std::memory_order_relaxed) == 0)
+        {
+            jobSystem->Run([this, node, DeltaTime]() { RunNode(node, DeltaTime); }, &frameCounter);
+        }
+    }
+
+    jobSystem->Wait(frameCounter);
+    m_FrameCounter = nullptr;
+}
+
+void Tempus::SystemScheduler::RunNode(uint32_t node, float DeltaTime)
+{
+    const auto start = std::chrono::high_resolution_clock::now();
+    m_Systems[m_NodeSystems[node]].system->OnUpdate(DeltaTime);
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    SystemTiming& timing = m_Timings[node];
+    timing.startMs = MsSince(m_FrameStart, start);
+    timing.durationMs = MsSince(start, end);
+
+    // Serial execution runs nodes in order and never needs to release dependents
+    if (!m_FrameCounter)
+    {
+        return;
+    }
+
+    for (uint32_t dependent : m_Dependents[node])
+    {
+        if (m_RemainingDependencies[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            JOB_SYSTEM->Run([this, dependent, DeltaTime]() { RunNode(dependent, DeltaTime); }, m_FrameCounter);
+        }
+    }
+}
+
+void Tempus::SystemScheduler::ComputeCriticalPath()
+{
+    // Longest chain of dependent system durations, nodes are already in topological order
+    const uint32_t nodeCount = static_cast<uint32_t>(m_Timings.size());
+    std::vector<double> finishMs(nodeCount, 0.0);
+    std::vector<uint32_t> slowestDependency(nodeCount, std::numeric_limits<uint32_t>::max());
+
+    uint32_t lastNode = 0;
+    for (uint32_t node = 0; node < nodeCount; node++)
+    {
+        SystemTiming& timing = m_Timings[node];
+        timing.bOnCriticalPath = false;
+
+        double readyMs = 0.0;
+        for (uint32_t dependency : timing.dependencies)
+        {
+            if (finishMs[dependency] > readyMs)
+            {
+                readyMs = finishMs[dependency];
+                slowestDependency[node] = dependency;
+            }
+        }
+        finishMs[node] = readyMs + timing.durationMs;
+
+        if (finishMs[node] > finishMs[lastNode])
+        {
+            lastNode = node;
+        }
+    }
+
+    m_CriticalPathMs = nodeCount > 0 ? finishMs[lastNode] : 0.0;
+    for (uint32_t node = lastNode; node < nodeCount; node = slowestDependency[node])
+    {
+        m_Timings[node].bOnCriticalPath = true;
+    }
+}
+
+void Tempus::SystemScheduler::PublishTimings()
+{
+    for (uint32_t node = 0; node < m_Timings.size(); node++)
+    {
+        SystemTiming& timing = m_Timings[node];
+        ScheduledSystem& scheduled = m_Systems[m_NodeSystems[node]];
+        if (Profiling::IsPendingSlowestTimeReset())
+        {
+            scheduled.highestDurationMs = timing.durationMs;
+        }
+        else
+        {
+            scheduled.highestDurationMs = std::max(scheduled.highestDurationMs, timing.durationMs);
+        }
+        timing.highestDurationMs = scheduled.highestDurationMs;
+
+#ifndef TPS_DIST
+        // Registered from the main thread once all systems are done, the profiler itself isn't thread safe
+        Profiling::RegisterProfilingData({ timing.name, timing.durationMs, timing.highestDurationMs, timing.bOnCriticalPath ? "System (critical path)" : "System" });
+#endif
+    }
+}
@@ -0,0 +1,85 @@
+// Copyright Levi Spevakow (C) 2025
+
+#pragma once
+
+#include "Core/Core.h"
+#include "System.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace Tempus
+{
+    // Runs a scene's systems each frame, executing systems with non-conflicting component access concurrently.
+    // Every frame a dependency graph is built from the updating systems in registration order:
+    // a system depends on an earlier one if either writes a component the other reads or writes.
+    // Systems running in parallel must not add or remove entities or components directly,
+    // they record them into Scene::GetCommandBuffer() and the scene applies them once every system has finished.
+    class TEMPUS_API SystemScheduler
+    {
+    public:
+
+        struct SystemTiming
+        {
+            const char* name = nullptr;
+            // Relative to the start of the frame's system update
+            double startMs = 0.0;
+            double durationMs = 0.0;
+            double highestDurationMs = 0.0;
+            // Indices into the timing list of systems this one waited on
+            std::vector<uint32_t> dependencies;
+            bool bOnCriticalPath = false;
+        };
+
+        SystemScheduler() = default;
+
+        void AddSystem(std::unique_ptr<System> system, const char* name);
+        void Update(float DeltaTime);
+
+        // Forces systems to run one at a time in registration order, for debugging ordering issues
+        void SetSerialExecution(bool bSerial) { m_bSerialExecution = bSerial; }
+        bool IsSerialExecution() const { return m_bSerialExecution; }
+
+        // Timings from the last update, one entry per system that updated
+        const std::vector<SystemTiming>& GetTimings() const { return m_Timings; }
+        // Wall time of the last update and the longest dependency chain within it
+        double GetFrameMs() const { return m_FrameMs; }
+        double GetCriticalPathMs() const { return m_CriticalPathMs; }
+        uint32_t GetSystemCount() const { return static_cast<uint32_t>(m_Systems.size()); }
+
+    private:
+
+        struct ScheduledSystem
+        {
+            std::unique_ptr<System> system;
+            const char* name = nullptr;
+            double highestDurationMs = 0.0;
+        };
+
+        void BuildGraph();
+        void RunSerial(float DeltaTime);
+        void RunParallel(float DeltaTime);
+        void RunNode(uint32_t node, float DeltaTime);
+        void ComputeCriticalPath();
+        void PublishTimings();
+
+        static bool Conflicts(const System& a, const System& b);
+
+        std::vector<ScheduledSystem> m_Systems;
+
+        // Per-frame graph over the updating systems, node i runs m_Systems[m_NodeSystems[i]]
+        std::vector<uint32_t> m_NodeSystems;
+        std::vector<std::vector<uint32_t>> m_Dependents;
+        std::unique_ptr<std::atomic<uint32_t>[]> m_RemainingDependencies;
+        uint32_t m_RemainingCapacity = 0;
+        class JobCounter* m_FrameCounter = nullptr;
+
+        std::vector<SystemTiming> m_Timings;
+        std::chrono::high_resolution_clock::time_point m_FrameStart;
+        double m_FrameMs = 0.0;
+        double m_CriticalPathMs = 0.0;
+
+        bool m_bSerialExecution = false;
+    };
+}
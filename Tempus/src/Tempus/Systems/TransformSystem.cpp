@@ -0,0 +1,410 @@
+// Copyright Levi Spevakow (C) 2025
+
+#include "TransformSystem.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <utility>
+#include "Core/Application.h"
+#include "Core/Scene.h"
+#include "Core/TransformKernels.h"
+#include "Components/ComponentTypeTable.h"
+#include "Components/HierarchyComponent.h"
+#include "Components/TransformComponent.h"
+#include "Components/WorldTransformComponent.h"
+#include "Jobs/JobSystem.h"
+#include <glm/geometric.hpp>
+#include <glm/mat3x3.hpp>
+
+namespace
+{
+    // Rotation part of a world matrix, its normalized axes. An axis scaled to zero is left unrotated.
+    glm::mat3 GetWorldRotation(const glm::mat4& world)
+    {
+        glm::mat3 rotation(1.0f);
+        for (int axis = 0; axis < 3; axis++)
+        {
+            const glm::vec3 column = glm::vec3(world[axis]);
+            const float length = glm::length(column);
+            if (length > std::numeric_limits<float>::epsilon())
+            {
+                rotation[axis] = column / length;
+            }
+        }
+        return rotation;
+    }
+}
+
+Tempus::TransformSystem::TransformSystem() : System()
+{
+    Reads<TransformComponent, HierarchyComponent>();
+    Writes<WorldTransformComponent>();
+}
+
+void Tempus::TransformSystem::OnInit(class Scene* ownerScene)
+{
+    System::OnInit(ownerScene);
+
+    // Observers run at structural sync points, so the world transform can follow the transform in and out
+    ownerScene->OnComponentAdded<TransformComponent>([this](Scene* scene, std::span<const uint32_t> entityIds)
+    {
+        for (uint32_t entityId : entityIds)
+        {
+            if (scene->HasComponent<TransformComponent>(entityId) && !scene->HasComponent<WorldTransformComponent>(entityId))
+            {
+                scene->AddComponent<WorldTransformComponent>(entityId);
+            }
+        }
+        m_bOrderDirty = true;
+    });
+    ownerScene->OnComponentRemoved<TransformComponent>([this](Scene* scene, std::span<const uint32_t> entityIds)
+    {
+        for (uint32_t entityId : entityIds)
+        {
+            if (scene->HasComponent<WorldTransformComponent>(entityId))
+            {
+                scene->RemoveComponent<WorldTransformComponent>(entityId);
+            }
+        }
+        m_bOrderDirty = true;
+    });
+
+    auto onStructureChanged = [this](Scene* scene, std::span<const uint32_t> entityIds)
+    {
+        m_bOrderDirty = true;
+    };
+    ownerScene->OnComponentAdded<WorldTransformComponent>([this](Scene* scene, std::span<const uint32_t> entityIds)
+    {
+        m_AddedEntities.insert(m_AddedEntities.end(), entityIds.begin(), entityIds.end());
+        m_bOrderDirty = true;
+    });
+    ownerScene->OnComponentRemoved<WorldTransformComponent>(onStructureChanged);
+    ownerScene->OnComponentAdded<HierarchyComponent>(onStructureChanged);
+    ownerScene->OnComponentRemoved<HierarchyComponent>(onStructureChanged);
+}
+
+void Tempus::TransformSystem::OnUpdate(float DeltaTime)
+{
+    Scene* scene = m_OwnerScene;
+    const uint32_t sinceVersion = m_LastVersion;
+    m_LastVersion = scene->AdvanceChangeVersion();
+    m_LastUpdatedCount = 0;
+
+    // Reparenting changes the order just like adding or removing a hierarchy does
+    if (!m_bOrderDirty)
+    {
+        auto changedHierarchies = scene->View<HierarchyComponent>().Changed<HierarchyComponent>(sinceVersion);
+        m_bOrderDirty = changedHierarchies.begin() != changedHierarchies.end();
+    }
+
+    auto transformView = scene->View<TransformComponent, WorldTransformComponent>();
+    bool bAnyDirty = false;
+    if (m_bOrderDirty)
+    {
+        bAnyDirty = RebuildOrder();
+        m_bOrderDirty = false;
+    }
+
+    transformView.Changed<TransformComponent>(sinceVersion).Each([this, &bAnyDirty](uint32_t entityId, TransformComponent& transform, WorldTransformComponent& worldTransform)
+    {
+        const uint32_t slot = GetSlot(entityId);
+        if (slot != InvalidIndex)
+        {
+            m_Dirty[slot] = 1;
+            bAnyDirty = true;
+        }
+    });
+
+    if (!bAnyDirty)
+    {
+        return;
+    }
+
+    std::atomic<uint32_t> updatedCount = 0;
+
+    auto updateSlots = [this, &transformView, &updatedCount](uint32_t begin, uint32_t end)
+    {
+        // Dirty slots are gathered into structure of arrays batches so their local matrices are composed by the SIMD kernel
+        float batchData[9][ComposeBatchSize];
+        uint32_t batchSlots[ComposeBatchSize];
+        glm::mat4 batchLocals[ComposeBatchSize];
+        uint32_t batchCount = 0;
+
+        TransformSoA batchTransforms;
+        batchTransforms.positionX = batchData[0];
+        batchTransforms.positionY = batchData[1];
+        batchTransforms.positionZ = batchData[2];
+        batchTransforms.rotationX = batchData[3];
+        batchTransforms.rotationY = batchData[4];
+        batchTransforms.rotationZ = batchData[5];
+        batchTransforms.scaleX = batchData[6];
+        batchTransforms.scaleY = batchData[7];
+        batchTransforms.scaleZ = batchData[8];
+
+        auto flushBatch = [this, &transformView, &batchTransforms, &batchSlots, &batchLocals, &batchCount]()
+        {
+            TransformKernels::ComposeModelMatrices(batchTransforms, batchCount, batchLocals);
+            for (uint32_t i = 0; i < batchCount; i++)
+            {
+                const uint32_t slot = batchSlots[i];
+                const uint32_t parentSlot = m_ParentSlots[slot];
+                m_WorldMatrices[slot] = parentSlot != InvalidIndex ? m_WorldMatrices[parentSlot] * batchLocals[i] : batchLocals[i];
+
+                const uint32_t entityId = m_Entities[slot];
+                WorldTransformComponent& worldTransform = transformView.template Get<WorldTransformComponent>(entityId);
+                worldTransform.World = m_WorldMatrices[slot];
+                transformView.template Get<TransformComponent>(entityId).GetBasisVectors(worldTransform.Forward, worldTransform.Right, worldTransform.Up);
+                if (parentSlot != InvalidIndex)
+                {
+                    // The local basis turned by every parent's rotation, read from the parent's world matrix
+                    const glm::mat3 parentRotation = GetWorldRotation(m_WorldMatrices[parentSlot]);
+                    worldTransform.Forward = glm::normalize(parentRotation * worldTransform.Forward);
+                    worldTransform.Right = glm::normalize(parentRotation * worldTransform.Right);
+                    worldTransform.Up = glm::normalize(parentRotation * worldTransform.Up);
+                }
+                transformView.template MarkChanged<WorldTransformComponent>(entityId);
+            }
+            batchCount = 0;
+        };
+
+        uint32_t updated = 0;
+        for (uint32_t slot = begin; slot < end; slot++)
+        {
+            const uint32_t parentSlot = m_ParentSlots[slot];
+            if (parentSlot != InvalidIndex && m_Dirty[parentSlot])
+            {
+                m_Dirty[slot] = 1;
+            }
+            if (!m_Dirty[slot])
+            {
+                continue;
+            }
+
+            const TransformComponent& transform = transformView.template Get<TransformComponent>(m_Entities[slot]);
+            batchData[0][batchCount] = transform.Position.x;
+            batchData[1][batchCount] = transform.Position.y;
+            batchData[2][batchCount] = transform.Position.z;
+            batchData[3][batchCount] = transform.Rotation.x;
+            batchData[4][batchCount] = transform.Rotation.y;
+            batchData[5][batchCount] = transform.Rotation.z;
+            batchData[6][batchCount] = transform.Scale.x;
+            batchData[7][batchCount] = transform.Scale.y;
+            batchData[8][batchCount] = transform.Scale.z;
+            batchSlots[batchCount++] = slot;
+            updated++;
+
+            if (batchCount == ComposeBatchSize)
+            {
+                flushBatch();
+            }
+        }
+        flushBatch();
+        updatedCount.fetch_add(updated, std::memory_order_relaxed);
+    };
+
+    JobSystem* jobSystem = GApp ? JOB_SYSTEM : nullptr;
+    for (uint32_t level = 0; level + 1 < m_LevelOffsets.size(); level++)
+    {
+        const uint32_t levelBegin = m_LevelOffsets[level];
+        const uint32_t levelEnd = m_LevelOffsets[level + 1];
+        if (jobSystem && levelEnd - levelBegin > ParallelGrainSize)
+        {
+            jobSystem->ParallelFor(levelEnd - levelBegin, ParallelGrainSize, [levelBegin, &updateSlots](uint32_t begin, uint32_t end)
+            {
+                updateSlots(levelBegin + begin, levelBegin + end);
+            });
+        }
+        else
+        {
+            updateSlots(levelBegin, levelEnd);
+        }
+    }
+
+    std::ranges::fill(m_Dirty, 0);
+    m_LastUpdatedCount = updatedCount.load(std::memory_order_relaxed);
+}
+
+bool Tempus::TransformSystem::RebuildOrder()
+{
+    Scene* scene = m_OwnerScene;
+    auto transformView = scene->View<TransformComponent, WorldTransformComponent>();
+    std::span<const uint32_t> transformEntities = transformView.GetEntityIds();
+    const uint32_t count = static_cast<uint32_t>(transformEntities.size());
+
+    // Slot of every entity in the previous order, so entities that kept their parent keep their world matrix.
+    // The previous order is swapped out rather than moved so rebuilding every frame while streaming doesn't reallocate.
+    m_PreviousSlots.resize(count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        m_PreviousSlots[i] = GetSlot(transformEntities[i]);
+    }
+    std::swap(m_Entities, m_PreviousEntities);
+    std::swap(m_ParentSlots, m_PreviousParentSlots);
+    std::swap(m_WorldMatrices, m_PreviousWorldMatrices);
+
+    for (uint32_t entityId : m_PreviousEntities)
+    {
+        m_EntitySlots[GetEntityIndex(entityId)] = InvalidIndex;
+    }
+
+    // Slots temporarily hold each entity's position in the transform view
+    for (uint32_t i = 0; i < count; i++)
+    {
+        m_EntitySlots.Ensure(GetEntityIndex(transformEntities[i])) = i;
+    }
+
+    // Parent position of every entity, parents without a transform leave the entity a root
+    std::vector<uint32_t>& parents = m_ScratchParents;
+    parents.assign(count, InvalidIndex);
+    auto findPosition = [this, transformEntities](uint32_t entityId)
+    {
+        const uint32_t* position = m_EntitySlots.TryGet(GetEntityIndex(entityId));
+        return position && *position != InvalidIndex && transformEntities[*position] == entityId ? *position : InvalidIndex;
+    };
+    scene->View<HierarchyComponent>().Each([&parents, &findPosition](uint32_t entityId, HierarchyComponent& hierarchy)
+    {
+        const uint32_t position = findPosition(entityId);
+        if (position != InvalidIndex && hierarchy.Parent != INVALID_ENTITY_ID)
+        {
+            parents[position] = findPosition(hierarchy.Parent);
+        }
+    });
+
+    std::vector<uint32_t>& childOffsets = m_ScratchChildOffsets;
+    std::vector<uint32_t>& childCursor = m_ScratchChildCursor;
+    std::vector<uint32_t>& children = m_ScratchChildren;
+    std::vector<uint32_t>& order = m_ScratchOrder;
+    std::vector<uint32_t>& orderPositions = m_ScratchOrderPositions;
+    std::vector<uint32_t> cycleWalk;
+    for (;;)
+    {
+        // Children grouped by parent so each parent's children are contiguous
+        childOffsets.assign(count + 1, 0);
+        for (uint32_t parent : parents)
+        {
+            if (parent != InvalidIndex)
+            {
+                childOffsets[parent + 1]++;
+            }
+        }
+        for (uint32_t i = 0; i < count; i++)
+        {
+            childOffsets[i + 1] += childOffsets[i];
+        }
+        children.resize(childOffsets[count]);
+        childCursor.assign(childOffsets.begin(), childOffsets.end() - 1);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (parents[i] != InvalidIndex)
+            {
+                children[childCursor[parents[i]]++] = i;
+            }
+        }
+
+        // Breadth first from every root, recording where each depth level starts
+        order.clear();
+        m_LevelOffsets.clear();
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (parents[i] == InvalidIndex)
+            {
+                order.push_back(i);
+            }
+        }
+        uint32_t levelBegin = 0;
+        while (levelBegin < order.size())
+        {
+            m_LevelOffsets.push_back(levelBegin);
+            const uint32_t levelEnd = static_cast<uint32_t>(order.size());
+            for (uint32_t i = levelBegin; i < levelEnd; i++)
+            {
+                const uint32_t node = order[i];
+                order.insert(order.end(), children.begin() + childOffsets[node], children.begin() + childOffsets[node + 1]);
+            }
+            levelBegin = levelEnd;
+        }
+        m_LevelOffsets.push_back(static_cast<uint32_t>(order.size()));
+
+        if (order.size() == count)
+        {
+            break;
+        }
+
+        // Entities unreachable from a root are in a parent cycle or below one. Walk up from one of them until
+        // the walk repeats, detach the entity it repeats on, and sort again.
+        orderPositions.assign(count, InvalidIndex);
+        for (uint32_t i = 0; i < static_cast<uint32_t>(order.size()); i++)
+        {
+            orderPositions[order[i]] = i;
+        }
+        const uint32_t unreached = static_cast<uint32_t>(std::ranges::find(orderPositions, InvalidIndex) - orderPositions.begin());
+        cycleWalk.assign(count, 0);
+        uint32_t node = unreached;
+        while (!cycleWalk[node])
+        {
+            cycleWalk[node] = 1;
+            node = parents[node];
+        }
+        TPS_CORE_ERROR("Transform hierarchy cycle detected at entity [{0}], treating it as a root", transformEntities[node]);
+        parents[node] = InvalidIndex;
+    }
+
+    m_Entities.resize(count);
+    m_ParentSlots.resize(count);
+    orderPositions.assign(count, InvalidIndex);
+    for (uint32_t slot = 0; slot < count; slot++)
+    {
+        orderPositions[order[slot]] = slot;
+    }
+    for (uint32_t slot = 0; slot < count; slot++)
+    {
+        const uint32_t node = order[slot];
+        m_Entities[slot] = transformEntities[node];
+        m_ParentSlots[slot] = parents[node] != InvalidIndex ? orderPositions[parents[node]] : InvalidIndex;
+        m_EntitySlots[GetEntityIndex(m_Entities[slot])] = slot;
+    }
+
+    // Only entities that are new to the order or moved to another parent are recomputed, along with their descendants
+    m_WorldMatrices.resize(count);
+    m_Dirty.assign(count, 0);
+    bool bAnyDirty = false;
+    for (uint32_t slot = 0; slot < count; slot++)
+    {
+        const uint32_t previousSlot = m_PreviousSlots[order[slot]];
+        if (previousSlot != InvalidIndex)
+        {
+            const uint32_t parentSlot = m_ParentSlots[slot];
+            const uint32_t previousParentSlot = m_PreviousParentSlots[previousSlot];
+            const uint32_t parent = parentSlot != InvalidIndex ? m_Entities[parentSlot] : INVALID_ENTITY_ID;
+            const uint32_t previousParent = previousParentSlot != InvalidIndex ? m_PreviousEntities[previousParentSlot] : INVALID_ENTITY_ID;
+            if (parent == previousParent)
+            {
+                m_WorldMatrices[slot] = m_PreviousWorldMatrices[previousSlot];
+                continue;
+            }
+        }
+        m_Dirty[slot] = 1;
+        bAnyDirty = true;
+    }
+
+    // A world transform removed and added again between updates holds default values
+    for (uint32_t entityId : m_AddedEntities)
+    {
+        const uint32_t slot = GetSlot(entityId);
+        if (slot != InvalidIndex)
+        {
+            m_Dirty[slot] = 1;
+            bAnyDirty = true;
+        }
+    }
+    m_AddedEntities.clear();
+
+    return bAnyDirty;
+}
+
+uint32_t Tempus::TransformSystem::GetSlot(uint32_t entityId) const
+{
+    const uint32_t* slot = m_EntitySlots.TryGet(GetEntityIndex(entityId));
+    return slot && *slot != InvalidIndex && m_Entities[*slot] == entityId ? *slot : InvalidIndex;
+}
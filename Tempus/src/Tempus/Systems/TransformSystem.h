@@ -0,0 +1,82 @@
+// Copyright Levi Spevakow (C) 2025
+
+#pragma once
+
+#include "Core/Core.h"
+#include "Core/PagedArray.h"
+#include "System.h"
+#include <glm/mat4x4.hpp>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace Tempus
+{
+    // Keeps the WorldTransformComponent of every entity with a TransformComponent up to date, following HierarchyComponent parents.
+    // Entities are kept in flat arrays sorted breadth first, so parents always come before their children and
+    // every world matrix is produced in one linear pass. Entities at the same depth never depend on each other,
+    // so each depth level is split across the job system, which for a flat scene is a parallel loop over the roots.
+    // Only entities whose transform changed since the last update are recomputed, along with their descendants,
+    // and each recomputed WorldTransformComponent is marked changed for consumers using the Changed<T> view filter.
+    // Adding, removing or reparenting entities rebuilds the order, but only the entities added or reparented are recomputed.
+    class TEMPUS_API TransformSystem : public System
+    {
+        TPS_DEBUG_NAME("Transform System")
+
+    public:
+
+        TransformSystem();
+        void OnInit(class Scene* ownerScene) override;
+        void OnUpdate(float DeltaTime) override;
+
+        // Every entity with a transform and world transform, parents before children
+        std::span<const uint32_t> GetSortedEntities() const { return m_Entities; }
+        uint32_t GetDepthCount() const { return m_LevelOffsets.empty() ? 0 : static_cast<uint32_t>(m_LevelOffsets.size()) - 1; }
+        // World matrices recomputed by the last update
+        uint32_t GetLastUpdatedCount() const { return m_LastUpdatedCount; }
+
+    private:
+
+        static constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+        // Depth levels with fewer entities than this are processed on the calling thread
+        static constexpr uint32_t ParallelGrainSize = 1024;
+        // Dirty transforms composed per call to the batch matrix kernel
+        static constexpr uint32_t ComposeBatchSize = 64;
+
+        // Sorts every entity with a transform and world transform breadth first. Entities new to the order or moved to
+        // another parent are marked dirty, every other entity keeps its world matrix. Returns whether any entity is dirty.
+        bool RebuildOrder();
+        uint32_t GetSlot(uint32_t entityId) const;
+
+        // Slot order arrays, a slot's parent slot is always lower than its own
+        std::vector<uint32_t> m_Entities;
+        std::vector<uint32_t> m_ParentSlots;
+        // Copy of each slot's world matrix, so children read their parent's from the same contiguous array
+        std::vector<glm::mat4> m_WorldMatrices;
+        // Bytes rather than bools so slots of one level can be written from several threads
+        std::vector<uint8_t> m_Dirty;
+        // First slot of every depth level, followed by the slot count
+        std::vector<uint32_t> m_LevelOffsets;
+        // Slot of each entity, indexed by entity index
+        PagedArray<uint32_t> m_EntitySlots{ InvalidIndex };
+
+        // Order before the last rebuild, and each current transform view entity's slot in it
+        std::vector<uint32_t> m_PreviousEntities;
+        std::vector<uint32_t> m_PreviousParentSlots;
+        std::vector<glm::mat4> m_PreviousWorldMatrices;
+        std::vector<uint32_t> m_PreviousSlots;
+        // Reused by RebuildOrder(), indexed by position in the transform view
+        std::vector<uint32_t> m_ScratchParents;
+        std::vector<uint32_t> m_ScratchChildOffsets;
+        std::vector<uint32_t> m_ScratchChildCursor;
+        std::vector<uint32_t> m_ScratchChildren;
+        std::vector<uint32_t> m_ScratchOrder;
+        std::vector<uint32_t> m_ScratchOrderPositions;
+        // Entities given a world transform since the last update
+        std::vector<uint32_t> m_AddedEntities;
+        // Set when transforms or hierarchies were added, removed or reparented
+        bool m_bOrderDirty = true;
+        uint32_t m_LastVersion = 0;
+        uint32_t m_LastUpdatedCount = 0;
+    };
+}
@@ -7,10 +7,14 @@
 #include <filesystem>
 
 #ifdef TPS_PLATFORM_WINDOWS
+#include <windows.h>
 #include <direct.h>
 #include <shellapi.h>
 #define ChangeDir _chdir
 #elif TPS_PLATFORM_MAC
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #include <mach-o/dyld.h>
 #define ChangeDir chdir
@@ -95,3 +99,86 @@ void Tempus::FileUtils::OpenDirectory(const std::string& directory)
     std::system(command.c_str());
 #endif
 }
+
+bool Tempus::MappedFile::Open(const std::filesystem::path& path)
+{
+    Close();
+
+#ifdef TPS_PLATFORM_WINDOWS
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!data)
+    {
+        if (mapping)
+        {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        return false;
+    }
+
+    m_FileHandle = file;
+    m_MappingHandle = mapping;
+    m_Size = static_cast<size_t>(fileSize.QuadPart);
+#elif TPS_PLATFORM_MAC
+    const int file = open(path.c_str(), O_RDONLY);
+    if (file < 0)
+    {
+        return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(file, &fileStat) != 0 || fileStat.st_size <= 0)
+    {
+        close(file);
+        return false;
+    }
+
+    void* data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    // The mapping keeps its own reference to the file
+    close(file);
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+
+    m_Size = static_cast<size_t>(fileStat.st_size);
+#endif
+
+    m_Data = static_cast<const std::byte*>(data);
+    return true;
+}
+
+void Tempus::MappedFile::Close()
+{
+    if (!m_Data)
+    {
+        return;
+    }
+
+#ifdef TPS_PLATFORM_WINDOWS
+    UnmapViewOfFile(m_Data);
+    CloseHandle(m_MappingHandle);
+    CloseHandle(m_FileHandle);
+    m_MappingHandle = nullptr;
+    m_FileHandle = nullptr;
+#elif TPS_PLATFORM_MAC
+    munmap(const_cast<std::byte*>(m_Data), m_Size);
+#endif
+
+    m_Data = nullptr;
+    m_Size = 0;
+}
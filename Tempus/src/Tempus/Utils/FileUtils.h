@@ -3,7 +3,9 @@
 #pragma once
 
 #include "Core/Core.h"
+#include <cstddef>
 #include <vector>
+#include <span>
 #include <string>
 #include <filesystem>
 
@@ -67,6 +69,11 @@ namespace Tempus
             return ProjectRoot() / relativePath;
         }
         
+        static std::filesystem::path ScenesDir()
+        {
+            return ContentDir() / "scenes";
+        }
+
         static std::filesystem::path LogsDir()
         {
             auto logsPath = ProjectRoot() / "logs";
@@ -78,4 +85,34 @@ namespace Tempus
         }
     };
 
-}
\ No newline at end of file
+
+    // Read only mapping of a whole file. Pages are read in by the OS on first access, so opening is O(1)
+    // and only the parts of the file that are touched ever get loaded.
+    class TEMPUS_API MappedFile
+    {
+    public:
+
+        MappedFile() = default;
+        ~MappedFile() { Close(); }
+
+        // Returns false if the file doesn't exist, is empty or can't be mapped
+        bool Open(const std::filesystem::path& path);
+        void Close();
+
+        bool IsOpen() const { return m_Data != nullptr; }
+        std::span<const std::byte> GetBytes() const { return { m_Data, m_Size }; }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+    private:
+
+        const std::byte* m_Data = nullptr;
+        size_t m_Size = 0;
+#ifdef TPS_PLATFORM_WINDOWS
+        void* m_FileHandle = nullptr;
+        void* m_MappingHandle = nullptr;
+#endif
+    };
+
+}
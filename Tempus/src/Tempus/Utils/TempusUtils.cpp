@@ -1 +1,28 @@
 // Copyright Levi Spevakow (C) 2025
+
+#include "TempusUtils.h"
+
+#include <glm/glm.hpp>
+
+namespace
+{
+    // Spreads the low 21 bits of value so two zero bits follow each of them
+    uint64_t SpreadBits(uint64_t value)
+    {
+        value &= 0x1FFFFF;
+        value = (value | (value << 32)) & 0x1F00000000FFFF;
+        value = (value | (value << 16)) & 0x1F0000FF0000FF;
+        value = (value | (value << 8)) & 0x100F00F00F00F00F;
+        value = (value | (value << 4)) & 0x10C30C30C30C30C3;
+        value = (value | (value << 2)) & 0x1249249249249249;
+        return value;
+    }
+}
+
+uint64_t Tempus::TempusUtils::GetMortonCode(const glm::vec3& position, float cellSize)
+{
+    // Offsetting by half the range keeps negative coordinates ordered, cells beyond the range are clamped
+    constexpr float HalfRange = static_cast<float>(1 << 20);
+    const glm::vec3 cell = glm::clamp(glm::floor(position / cellSize) + HalfRange, glm::vec3(0.0f), glm::vec3(2.0f * HalfRange - 1.0f));
+    return SpreadBits(static_cast<uint64_t>(cell.x)) | (SpreadBits(static_cast<uint64_t>(cell.y)) << 1) | (SpreadBits(static_cast<uint64_t>(cell.z)) << 2);
+}
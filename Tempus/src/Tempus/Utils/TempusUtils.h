@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Core/Core.h"
+#include <glm/fwd.hpp>
 
 namespace Tempus
 {
@@ -21,6 +22,10 @@ namespace Tempus
             return "Debug Name";
 #endif
         }
+
+        // Z-order curve index of the position quantized to cells of the given size, 21 bits per axis.
+        // Positions close in space get close codes, which makes it a cache friendly Scene::SortPool() key.
+        static uint64_t GetMortonCode(const glm::vec3& position, float cellSize);
     };
 
 }
\ No newline at end of file